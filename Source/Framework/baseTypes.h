@@ -6,8 +6,10 @@ typedef struct
 
 typedef float float_t;
 typedef unsigned int uint32_t;
+typedef unsigned long long uint64_t;
 typedef int int32_t;
 typedef char char8_t;
+typedef unsigned char uint8_t;
 typedef short int16_t;
 typedef unsigned short uint16_t;
 typedef int bool8_t;
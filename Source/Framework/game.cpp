@@ -25,7 +25,7 @@
 
 #include <map>
 #include "..\\GameCode\\Utilities.h"
-#include "..\\GameCode\\Tile.h"
+#include "..\\GameCode\\TileGrid.h"
 #include "..\\GameCode\\Character.h"
 #include "..\\GameCode\\Pacman.h"
 #include "..\\GameCode\\Ghost.h"
@@ -36,9 +36,9 @@
 #include "..\\GameCode\\BoardManager.h"
 #include "..\\GameCode\\CharacterManager.h"
 
-#include <queue>
 #include "..\\GameCode\\EventManager.h"
 
+#include "..\\GameCode\\TimerWheel.h"
 #include "..\\GameCode\\TimerManager.h"
 
 #include "..\\GameCode\\FruitManager.h"
@@ -47,6 +47,16 @@
 
 #include "..\\GameCode\\StatsManager.h"
 
+#include <vector>
+#include "..\\GameCode\\Replay.h"
+
+#include "..\\GameCode\\RewindBuffer.h"
+
+#include "..\\GameCode\\GameWorld.h"
+
+#define LAST_GAME_REPLAY_FILE "Assets\\LastGame.rpl"
+#define REWIND_SECONDS 10
+
 
 // Declarations
 const char8_t CGame::mGameTitle[]="paC++man";
@@ -62,41 +72,78 @@ BOOL Initialize (GL_Window* window, Keys* keys)					// Any OpenGL Initialization
 void CGame::init()
 {
     StateManagerC::CreateInstance();
-    StateManagerC::GetInstance()->setApplicationState(StateManagerC::IN_MENU);
 
-    StatsManager::Instance()->init();
-    UIManager::Instance()->init();
+    // the world initializes the gameplay managers, the ui needs the stats manager's high score
+    mWorld = new GameWorld();
+    mWorld->init();
+
+    // every game is recorded, and the last one can be played back from the menu
+    mReplay = new Replay();
+    mIsPlayingReplay = false;
 
-    EventManager::Instance()->init();
-    TimerManager::Instance()->init();
-    BoardManager::Instance()->init();
-    FruitManager::Instance()->init();
-    CharacterManager::Instance()->init();
+    // holding backspace steps the game back through its last few seconds
+    mRewind = new RewindBuffer(REWIND_SECONDS);
+    mWorld->setRewindBuffer(mRewind);
+    mDidRewind = false;
 
-    // start the game on the game over screen
-    EventManager::ConstInstace()->postEvent(EventManager::GameEvent::GAME_OVER);
+    UIManager::Instance()->init(mWorld);
 }
 void CGame::UpdateFrame(DWORD milliseconds)			
 {
     keyProcess();
 
-    switch(StateManagerC::GetInstance()->getApplicationState())
+    if(mWorld->isInGame() && g_keys->keyDown[VK_BACK])
     {
-        case StateManagerC::IN_MENU:
-            EventManager::Instance()->update();                             // calls events in queue
-            UIManager::Instance()->update();                                // listens for start game input
-            break;
+        // rewinds as many ticks as would have been played, stopping at the oldest kept
+        uint32_t numTicks = milliseconds / SIM_TICK_TIME > 0 ? milliseconds / SIM_TICK_TIME : 1;
+        for(uint32_t i = 0; i < numTicks && mWorld->rewindTick(); ++i)
+        {
+            mDidRewind = true;
+        }
+        return;
+    }
 
-        case StateManagerC::IN_GAME:
-            EventManager::Instance()->update();                             // calls events in queue
-            TimerManager::Instance()->updateTimers(milliseconds);           // updates timers for time-delayed events
-            BoardManager::Instance()->updateBoard(milliseconds);            // updates tiles and pellets
-            FruitManager::Instance()->updateFruit(milliseconds);            // updates fruit
-            CharacterManager::Instance()->updateCharacters(milliseconds);   // updates moving characters
-            break;
+    // arrow keys are checked in priority order, only one direction is passed on
+    GameUtil::BoardDirection direction = GameUtil::BoardDirection::INVAL;
+    if(g_keys->keyDown[VK_UP])          direction = GameUtil::BoardDirection::UP;
+    else if(g_keys->keyDown[VK_LEFT])   direction = GameUtil::BoardDirection::LEFT;
+    else if(g_keys->keyDown[VK_DOWN])   direction = GameUtil::BoardDirection::DOWN;
+    else if(g_keys->keyDown[VK_RIGHT])  direction = GameUtil::BoardDirection::RIGHT;
+    mWorld->setInput(direction);
 
-        default:
-            break;
+    bool8_t wasInMenu = !mWorld->isInGame();
+
+    mWorld->update(milliseconds);                                           // calls events, updates gameplay managers
+
+    if(wasInMenu && mWorld->isInGame() && !mIsPlayingReplay)
+    {
+        mWorld->recordReplay(mReplay, GetTickCount());                      // a new game, recorded from its first tick
+        mDidRewind = false;
+    }
+    else if(!wasInMenu && !mWorld->isInGame())
+    {
+        // the replay stopped itself on the game's last tick, unless rewinding cut it short
+        if(!mIsPlayingReplay && !mDidRewind)
+        {
+            mReplay->write(LAST_GAME_REPLAY_FILE);
+        }
+        mIsPlayingReplay = false;
+    }
+
+    if(wasInMenu && !mWorld->isInGame())
+    {
+        if(g_keys->keyDown['R'] && mReplay->read(LAST_GAME_REPLAY_FILE) && mWorld->playReplay(mReplay))
+        {
+            // plays back the last game in place of the arrow keys
+            mWorld->startGame();
+            mIsPlayingReplay = true;
+
+            UIManager::Instance()->setUIState(GameUtil::UIState::UI_PREGAME_1);
+        }
+        else
+        {
+            UIManager::Instance()->update();                                // listens for start game input
+        }
     }
 }
 
@@ -104,16 +151,16 @@ void CGame::DrawScene(void)
 {
 	startOpenGLDrawing();
 
-    switch(StateManagerC::GetInstance()->getApplicationState())
+    switch(mWorld->getApplicationState())
     {
-        case StateManagerC::IN_MENU:
+        case GameWorld::IN_MENU:
             UIManager::Instance()->draw();
             break;
 
-        case StateManagerC::IN_GAME:
-            BoardManager::Instance()->drawBoard();
-            FruitManager::Instance()->drawFruit();
-            CharacterManager::Instance()->drawCharacters();
+        case GameWorld::IN_GAME:
+            mWorld->getBoardManager()->drawBoard();
+            mWorld->getFruitManager()->drawFruit();
+            mWorld->getCharacterManager()->drawCharacters();
             UIManager::Instance()->draw();
             break;
 
@@ -132,25 +179,16 @@ void CGame::shutdown()
 {
     StateManagerC::GetInstance()->shutdown();
 
-    StatsManager::Instance()->shutdown();
     UIManager::Instance()->shutdown();
-    EventManager::Instance()->shutdown();
-
-    TimerManager::Instance()->shutdown();
-    BoardManager::Instance()->shutdown();
-    FruitManager::Instance()->shutdown();
-    CharacterManager::Instance()->shutdown();
+    mWorld->shutdown();
 }
 void CGame::DestroyGame(void)
 {
     delete StateManagerC::GetInstance();
 
-    delete StatsManager::Instance();
     delete UIManager::Instance();
-    delete EventManager::Instance();
 
-    delete TimerManager::Instance();
-    delete BoardManager::Instance();
-    delete FruitManager::Instance();
-    delete CharacterManager::Instance();
+    delete mWorld;
+    delete mReplay;
+    delete mRewind;
 }
\ No newline at end of file
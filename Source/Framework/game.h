@@ -1,3 +1,7 @@
+class GameWorld;
+class Replay;
+class RewindBuffer;
+
 class CGame
 {
 public:
@@ -16,5 +20,10 @@ public:
 private:
 	static const char8_t mGameTitle[20];
 	static CGame *sInstance;
+	GameWorld *mWorld;
+	Replay *mReplay;					// the last game, recorded or being played back
+	bool8_t mIsPlayingReplay;
+	RewindBuffer *mRewind;				// the last few seconds of the game in progress
+	bool8_t mDidRewind;
 	CGame(){};
 };
\ No newline at end of file
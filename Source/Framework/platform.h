@@ -0,0 +1,31 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+/*
+ * Platform headers for the game code.
+ *
+ * The desktop build pulls in Windows and OpenGL as usual. Headless
+ * builds (PACSIM_HEADLESS) compile the same game code with no window,
+ * renderer or audio, so they only need the few Win32/OpenGL types
+ * that appear in the game code's declarations.
+ */
+#ifdef PACSIM_HEADLESS
+
+#include <float.h>
+#include <string.h>
+
+// files that need Win32 calls in a headless Windows build include windows.h first
+#ifndef _WINDEF_
+typedef unsigned int DWORD;
+#endif
+typedef unsigned int GLuint;
+
+#else
+
+#include <windows.h>											// Header File For Windows
+#include <gl/gl.h>											    // Header File For The OpenGL32 Library
+#include <gl/glu.h>												// Header File For The GLu32 Library
+
+#endif
+
+#endif
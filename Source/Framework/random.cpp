@@ -1,5 +1,7 @@
 #include <stdlib.h>
+#include <string.h>
 
+#include "baseTypes.h"
 #include "random.h"
 float getRangedRandom(float min, float max)
 {
@@ -26,4 +28,89 @@ int getRangedRandom(int min, int max)
 
     return r1;
 
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------------------
+
+static uint32_t rotateLeft(const uint32_t bits, const int32_t count)
+{
+    return (bits << count) | (bits >> (32 - count));
+}
+
+//-----------------------------------------------------------------------------------------
+
+RandomGenerator::RandomGenerator(const uint32_t seed)
+{
+    this->seed(seed);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RandomGenerator::seed(const uint32_t seed)
+{
+    // spread the seed over the state with a 32-bit mixing function
+    //      each word mixes a different value, and the mix is a bijection, so the state is never all zero
+    uint32_t value = seed;
+    for(int32_t i = 0; i < RANDOM_STATE_WORDS; ++i)
+    {
+        value += 0x9E3779B9u;
+
+        uint32_t mixed = value;
+        mixed = (mixed ^ (mixed >> 16)) * 0x85EBCA6Bu;
+        mixed = (mixed ^ (mixed >> 13)) * 0xC2B2AE35u;
+        mState[i] = mixed ^ (mixed >> 16);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+uint32_t RandomGenerator::next()
+{
+    uint32_t result = rotateLeft(mState[1] * 5, 7) * 9;
+    uint32_t shifted = mState[1] << 9;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+
+    mState[2] ^= shifted;
+    mState[3] = rotateLeft(mState[3], 11);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+int32_t RandomGenerator::getRangedRandom(const int32_t min, const int32_t max)
+{
+    uint32_t range = (uint32_t)(max - min);
+    if(range == 0)
+    {
+        return min;
+    }
+
+    // reject the few values at the bottom that would make some results more likely than others
+    uint32_t threshold = (0u - range) % range;
+    uint32_t bits = next();
+    while(bits < threshold)
+    {
+        bits = next();
+    }
+
+    return min + (int32_t)(bits % range);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RandomGenerator::saveState(uint32_t* state) const
+{
+    memcpy(state, mState, sizeof(mState));
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RandomGenerator::loadState(const uint32_t* state)
+{
+    memcpy(mState, state, sizeof(mState));
+}
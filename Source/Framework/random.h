@@ -1,2 +1,49 @@
 float getRangedRandom(float min, float max);
 int getRangedRandom(int min, int max);
+
+/*
+ * Small, fast, seedable random number generator (xoshiro128**).
+ *
+ * Unlike rand(), every generator keeps its own state, so each game
+ * world can own one: worlds running side by side share nothing and
+ * never lock, and a world seeded the same way always draws the same
+ * numbers. The state is four plain words, so a generator is copied
+ * and saved along with whatever owns it.
+ */
+#define RANDOM_STATE_WORDS 4
+
+class RandomGenerator
+{
+public:
+
+    RandomGenerator(const uint32_t seed);
+
+    /*
+     * Restarts the generator from 'seed'. Any seed is valid.
+     */
+    void seed(const uint32_t seed);
+
+    /*
+     * Returns the next 32 random bits.
+     */
+    uint32_t next();
+
+    /*
+     * Returns a random integer from 'min' up to, but not including,
+     * 'max'. Every value in the range is equally likely.
+     */
+    int32_t getRangedRandom(const int32_t min, const int32_t max);
+
+    /*
+     * Copies the generator's RANDOM_STATE_WORDS words of state
+     * out to 'state', or back in from it. A generator loaded
+     * from a saved state draws the same numbers as it did after
+     * the save.
+     */
+    void saveState(uint32_t* state) const;
+    void loadState(const uint32_t* state);
+
+private:
+
+    uint32_t mState[RANDOM_STATE_WORDS];
+};
@@ -1,13 +1,9 @@
 #define STATE_MANAGER_CPP
-#include <windows.h>											// Header File For Windows
+#include "platform.h"
 #include <stdio.h>												// Header File For Standard Input / Output
 #include <stdarg.h>												// Header File For Variable Argument Routines
 #include <math.h>												// Header File For Math Operations
-#include <gl\gl.h>												// Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
-#include "glut.h"
 #include "baseTypes.h"
-#include "openglframework.h"	
 #include "gamedefs.h"
 #include "stateManager.h"
 
@@ -33,12 +29,3 @@ void StateManagerC::setState(int32_t state)
 void StateManagerC::shutdown()
 {
 }
-
-StateManagerC::ApplicationState StateManagerC::getApplicationState() const
-{
-    return mCurrentApplicationState;
-}
-void StateManagerC::setApplicationState(const StateManagerC::ApplicationState newState)
-{
-    mCurrentApplicationState = newState;
-}
\ No newline at end of file
@@ -16,19 +16,8 @@ public:
 	void		setState(int32_t stateToSet);
 	void		shutdown();
 
-    typedef enum
-    {
-        IN_MENU,
-        IN_GAME
-    } ApplicationState;
-
-    ApplicationState getApplicationState() const;
-    void setApplicationState(const ApplicationState newState);
-
 private:
 	static StateManagerC *sInstance;
 	StateManagerC(){};
 	int32_t		mCurrentState;
-
-    ApplicationState mCurrentApplicationState;
 };
\ No newline at end of file
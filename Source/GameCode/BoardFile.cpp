@@ -0,0 +1,192 @@
+
+#define BOARD_FILE_CPP
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include "../Framework/baseTypes.h"
+
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "BoardFile.h"
+
+#define FNV_OFFSET_BASIS    2166136261u
+#define FNV_PRIME           16777619u
+
+static_assert(sizeof(BoardFileHeader) == 24, "board file header layout changed");
+static_assert(sizeof(BoardFileData) % 4 == 0, "board file payload must keep 4-byte alignment");
+
+BoardFile::BoardFile() :
+    mView(nullptr),
+    mSize(0)
+#ifdef _WIN32
+    , mFileHandle(INVALID_HANDLE_VALUE),
+    mMappingHandle(nullptr)
+#endif
+{
+}
+
+//-----------------------------------------------------------------------------------------
+
+BoardFile::~BoardFile()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t BoardFile::open(const char8_t* path)
+{
+    close();
+
+    // map the whole file read-only
+#ifdef _WIN32
+    mFileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(mFileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    mSize = GetFileSize(mFileHandle, nullptr);
+    mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mMappingHandle != nullptr)
+    {
+        mView = (const uint8_t*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+    }
+#else
+    int fd = ::open(path, O_RDONLY);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        mSize = (uint32_t)fileStat.st_size;
+        void* view = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+        mView = view != MAP_FAILED ? (const uint8_t*)view : nullptr;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+#endif
+
+    if(mView == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    // validate the header against this build, then the payload against its checksum
+    const BoardFileHeader* header = (const BoardFileHeader*)mView;
+    bool8_t isValid = mSize == sizeof(BoardFileHeader) + sizeof(BoardFileData) &&
+        header->magic == BOARD_FILE_MAGIC &&
+        header->version == BOARD_FILE_VERSION &&
+        header->numRows == NUM_BOARD_ROWS &&
+        header->numCols == NUM_BOARD_COLS &&
+        header->payloadSize == sizeof(BoardFileData) &&
+        header->checksum == checksum(mView + sizeof(BoardFileHeader), sizeof(BoardFileData));
+
+    if(!isValid)
+    {
+        close();
+    }
+
+    return isValid;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void BoardFile::close()
+{
+#ifdef _WIN32
+    if(mView != nullptr)
+    {
+        UnmapViewOfFile(mView);
+    }
+    if(mMappingHandle != nullptr)
+    {
+        CloseHandle(mMappingHandle);
+        mMappingHandle = nullptr;
+    }
+    if(mFileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFileHandle);
+        mFileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if(mView != nullptr)
+    {
+        munmap((void*)mView, mSize);
+    }
+#endif
+
+    mView = nullptr;
+    mSize = 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const BoardFileData* BoardFile::getData() const
+{
+    assert(mView != nullptr);
+    return (const BoardFileData*)(mView + sizeof(BoardFileHeader));
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t BoardFile::getChecksum() const
+{
+    assert(mView != nullptr);
+    return ((const BoardFileHeader*)mView)->checksum;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t BoardFile::write(const char8_t* path, const BoardFileData* data)
+{
+    BoardFileHeader header;
+    header.magic = BOARD_FILE_MAGIC;
+    header.version = BOARD_FILE_VERSION;
+    header.numRows = NUM_BOARD_ROWS;
+    header.numCols = NUM_BOARD_COLS;
+    header.payloadSize = sizeof(BoardFileData);
+    header.checksum = checksum(data, sizeof(BoardFileData));
+
+    FILE* file = fopen(path, "wb");
+    if(file == nullptr)
+    {
+        return false;
+    }
+
+    bool8_t result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(data, sizeof(BoardFileData), 1, file) == 1;
+
+    return fclose(file) == 0 && result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+uint32_t BoardFile::checksum(const void* bytes, uint32_t size)
+{
+    const uint8_t* curr = (const uint8_t*)bytes;
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        hash ^= curr[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
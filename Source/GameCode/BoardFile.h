@@ -0,0 +1,109 @@
+
+#define BOARD_FILE_MAGIC        0x44524250      // "PBRD" as little-endian bytes
+#define BOARD_FILE_VERSION      1
+
+#define NUM_BOARD_CHARACTERS    5               // spawn and home tiles are stored per character ID
+
+/*
+ * Header at the start of a compiled board file.
+ *
+ * The payload (a BoardFileData) follows immediately. A file is
+ * only accepted if the magic, version, board dimensions and
+ * payload size all match this build, and the checksum of the
+ * payload matches 'checksum'.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numRows;
+    uint32_t numCols;
+    uint32_t payloadSize;
+    uint32_t checksum;          // FNV-1a hash of the payload bytes
+}BoardFileHeader;
+
+/*
+ * Payload of a compiled board file. Everything the BoardManager
+ * needs to set up a board, already in the layout the TileGrid
+ * uses, so loading a board is a copy rather than a parse.
+ *
+ * Fields are fixed-size and naturally aligned so the layout is
+ * the same for every compiler. Files are written in the byte
+ * order of the machine that compiled them (little-endian on
+ * every platform we build for).
+ */
+struct BoardFileData
+{
+    uint8_t traverseType[NUM_BOARD_TILES];              // TileGrid::TileTraverseType of each tile
+    TileIndex neighbors[NUM_BOARD_TILES][4];            // neighbors in the order UP, LEFT, DOWN, RIGHT
+
+    PelletRow pellets[NUM_BOARD_ROWS];                  // pellets the board spawns with
+    PelletRow powerPellets[NUM_BOARD_ROWS];             // which of those are power pellets
+
+    TileIndex characterSpawns[NUM_BOARD_CHARACTERS];    // spawn tile of each character ID
+    TileIndex ghostHomes[NUM_BOARD_CHARACTERS];         // home tile of each character ID, PACMAN is the ghost home
+    TileIndex fruitTile;
+    int16_t padding;
+
+    Coord2D textureOffsets[NUM_BOARD_TILES];            // percent offset from texture file origin to each tile's image
+};
+
+/*
+ * Read-only view of a compiled board file.
+ *
+ * Board files are made offline by the board compiler from
+ * PacmanBoard.txt and TileMappings.txt. At load time the file
+ * is memory-mapped and validated, with no text parsing, so
+ * starting many simulation worlds is cheap.
+ */
+class BoardFile
+{
+public:
+
+    BoardFile();
+    ~BoardFile();
+
+    /*
+     * Maps the board file at 'path' and validates its header and
+     * checksum. Returns false if the file can't be mapped or is
+     * not a valid board for this build.
+     */
+    bool8_t open(const char8_t* path);
+
+    /*
+     * Unmaps the file. Data returned by getData() is no longer valid.
+     */
+    void close();
+
+    /*
+     * Returns the board data of an open file.
+     */
+    const BoardFileData* getData() const;
+
+    /*
+     * Returns the checksum of an open file's payload, which
+     * identifies the board.
+     */
+    const uint32_t getChecksum() const;
+
+    /*
+     * Writes 'data' to 'path' as a board file, with a header for this
+     * build. Used by the board compiler. Returns false on failure.
+     */
+    static bool8_t write(const char8_t* path, const BoardFileData* data);
+
+    /*
+     * Returns the FNV-1a hash of 'size' bytes.
+     */
+    static uint32_t checksum(const void* bytes, uint32_t size);
+
+private:
+
+    const uint8_t* mView;       // start of the mapped file
+    uint32_t mSize;             // size of the mapped file in bytes
+
+#ifdef _WIN32
+    void* mFileHandle;
+    void* mMappingHandle;
+#endif
+};
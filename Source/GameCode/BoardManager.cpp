@@ -2,17 +2,19 @@
 #define BOARD_MANAGER_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
-#include "soil.h"
+#ifndef PACSIM_HEADLESS
+#include "SOIL.h"
+#endif
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
+#include "BoardFile.h"
 #include "BoardManager.h"
 
 #include "FruitManager.h"
@@ -26,284 +28,298 @@
 #include "GhostOrange.h"
 #include "CharacterManager.h"
 
-#include <queue>
 #include "EventManager.h"
 
 #include "StatsManager.h"
 
-#define PACMAN_BOARD_FILE "Assets\\PacmanBoard.txt"
-#define TILE_MAPPINGS_FILE "Assets\\TileMappings.txt"
-#define TILES_SPRITESHEET "Assets\\Images\\TilesSpritesheet.png"
-#define PELLET_IMAGE "Assets\\Images\\Pellet.png"
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
+#define PACMAN_BOARD_FILE "Assets/PacmanBoard.bin"
+#define TILES_SPRITESHEET "Assets/Images/TilesSpritesheet.png"
+#define PELLET_IMAGE "Assets/Images/Pellet.png"
 
 #define BOARD_X 0
 #define BOARD_Y 0
 
-BoardManager* BoardManager::_instance = nullptr;
-
-BoardManager::BoardManager() :
+BoardManager::BoardManager(const GameWorld* world) :
+    mWorld(world),
     mTileSpritesheetID(0),
     mPelletImageID(0),
     mGhostHomes(new GhostHomes()),
     mCharacterSpawns(new CharacterSpawns()),
-    mTextureIndexMap(new TextureIndexMap()),
-    mNumPellets(0),
-    mMaxNumPellets(0)
+    mMaxNumPellets(0),
+    mBoardChecksum(0),
+    mNextPelletTrigger(0),
+    mPelletTriggerLevel(0),
+    mIsRearmPending(false),
+    mIsTriggerCheckPending(false)
 {
 }
 
 //-----------------------------------------------------------------------------------------
 
-BoardManager* BoardManager::Instance()
+void BoardManager::init()
 {
-    if(_instance == nullptr)
-    {
-        _instance = new BoardManager();
-    }
+    mBoardPosition.y = BOARD_Y;
+    mBoardPosition.x = BOARD_X;
 
-    return _instance;
+    mGrid.init(mBoardPosition);
+
+#ifndef PACSIM_HEADLESS
+    loadTextures();
+#endif
+    loadBoard();
 }
 
 //-----------------------------------------------------------------------------------------
 
-const BoardManager* BoardManager::ConstInstace()
+void BoardManager::reset()
 {
-    // returning a const-safe instance of the BoardManager
-    //      this way, the caller can't do anything it shouldn't to the manager
-    if(_instance == nullptr)
-    {
-        _instance = new BoardManager();
-    }
+    // reset the tiles' pellets and animation
+    mGrid.reset();
+
+    // rebuild the pellet triggers, since the cruise elroy thresholds depend on the level
+    buildPelletTriggers();
+    setNextPelletTrigger(0);
+    setRearmPending(false);
+    setTriggerCheckPending(true);
+}
+
+//-----------------------------------------------------------------------------------------
 
-    return _instance;
+void BoardManager::resetFromDeath()
+{
+    // the pellets stay, but the ghosts and cruise elroy are reset
+    setRearmPending(true);
+    setTriggerCheckPending(true);
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::init()
+void BoardManager::saveState(BoardState* state) const
 {
-    mBoardPosition.y = BOARD_Y;
-    mBoardPosition.x = BOARD_X;
+    mGrid.saveState(&state->grid);
 
-    constructCharTextureMap();
-    createTiles();
-    connectTiles();
+    state->nextPelletTrigger = mNextPelletTrigger;
+    state->isRearmPending = mIsRearmPending;
+    state->isTriggerCheckPending = mIsTriggerCheckPending;
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::reset()
+void BoardManager::loadState(const BoardState* state)
 {
-    // reset each tile
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
+    mGrid.loadState(&state->grid);
+
+    if(mWorld->getConstStatsManager()->getLevel() != mPelletTriggerLevel)
     {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            mBoard[y][x]->reset();
-        }
+        buildPelletTriggers();
     }
 
-    // reset number of pellets
-    mNumPellets = mMaxNumPellets;
-    mDidPostWinEvent = false;
+    mNextPelletTrigger = state->nextPelletTrigger;
+    mIsRearmPending = state->isRearmPending;
+    mIsTriggerCheckPending = state->isTriggerCheckPending;
+}
+
+//-----------------------------------------------------------------------------------------
 
-    // save the cruise elroy thresholds from the stats manager
-    const StatsManager* smInstance = StatsManager::ConstInstace();
-    mCruiseElroyThreshold_1 = smInstance->getCruiseElroyDots_1();
-    mCruiseElroyThreshold_2 = smInstance->getCruiseElroyDots_2();
+void BoardManager::updateBoard()
+{
+    // pellet triggers only need checking when the pellet count changes, or after a reset
+    if(checkPelletCollected() || mIsTriggerCheckPending)
+    {
+        checkPelletTriggerEvents(mGrid.getNumPellets());
+        setTriggerCheckPending(false);
+    }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::updateBoard(DWORD milliseconds)
+const uint32_t BoardManager::getNumQuietTicks() const
 {
-    checkPelletCollected();
-    checkPelletTriggerEvents();
+    if(mIsTriggerCheckPending)
+    {
+        return 0;
+    }
 
-    // update tiles
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
+    // a pellet is only collected while pacman is at a tile, see checkPelletCollected
+    const CharacterManager* cmInstance = mWorld->getConstCharacterManager();
+    if(cmInstance->getCharacterMovementState(GameUtil::CharacterID::PACMAN) == Character::AT_TILE &&
+        mGrid.isPelletPresent(cmInstance->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN)))
     {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            mBoard[y][x]->updateTile(milliseconds);
-        }
+        return 0;
     }
+
+    return TICKS_UNLIMITED;
 }
 
 //-----------------------------------------------------------------------------------------
 
+#ifndef PACSIM_HEADLESS
 void BoardManager::drawBoard()
 {
     // bind the single tile spritesheet beforehand so we don't load and reload stuff for individual tiles
     glEnable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, mTileSpritesheetID);
-    glBegin(GL_QUADS);
-
-    // call draw on each tile object
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
-    {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            mBoard[y][x]->drawTile();
-        }
-    }
 
-    glEnd();
+    // draw each tile
+    mGrid.drawTiles(mWorld->getGameTime());
 
     glEnable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, mPelletImageID);
-    glBegin(GL_QUADS);
-
-    // call draw for each tile's pellet
-    //      have to separate because the first pass is in a different OpenGL draw mode
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
-    {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            mBoard[y][x]->drawPellet();
-        }
-    }
 
-    glEnd();
+    // draw each tile's pellet
+    mGrid.drawPellets();
 }
+#endif
 
 //-----------------------------------------------------------------------------------------
 
 void BoardManager::shutdown()
 {
-    // shutdown each tile before destroying it
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
-    {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            mBoard[y][x]->shutdown();
-            delete mBoard[y][x];
-        }
-    }
+    mGrid.shutdown();
 
-    // destroy maps -- any tiles stored in the maps are already destroyed
+    // destroy maps
     delete mGhostHomes;
     delete mCharacterSpawns;
-    delete mTextureIndexMap;
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::checkPelletCollected()
+bool8_t BoardManager::checkPelletCollected()
 {
-    const CharacterManager* cmInstance = CharacterManager::ConstInstance();
+    const CharacterManager* cmInstance = mWorld->getConstCharacterManager();
 
     // need to check pacman's movement state
     //      we don't want to collect the pellet too early, because the pellet needs to affect pacman's movement speed
     const Character::MovementState movementState = cmInstance->getCharacterMovementState(GameUtil::CharacterID::PACMAN);
     if(movementState == Character::AT_TILE)
     {
-        const Tile* pacmanTile = cmInstance->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
-
-        const Coord2D& tileIndex = pacmanTile->getBoardIndex();
-        if(mBoard[(int)tileIndex.y][(int)tileIndex.x]->collectPellet())
+        const TileIndex pacmanTile = cmInstance->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
+        if(mGrid.collectPellet(pacmanTile, mWorld->getConstEventManager()))
         {
-            mNumPellets--;
+            mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::PELLET, pacmanTile), 1, 0);
+            return true;
         }
     }
+
+    return false;
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::checkPelletTriggerEvents()
+void BoardManager::checkPelletTriggerEvents(const int32_t numPellets)
 {
     // some events are triggered by certain numbers of pellets being collected
-    //      we check those here
-
-    const EventManager* emInstance = EventManager::ConstInstace();
-    const CharacterManager* cmInstance = CharacterManager::ConstInstance();
-
-    float_t remainingPellets = getPercentPelletsRemaining();
+    //      the triggers are sorted by pellet count, so we only look at the next one that hasn't fired
+    const EventManager* emInstance = mWorld->getConstEventManager();
 
-    // ghost spawns
-    if(remainingPellets < 2.0f)
+    // after pacman dies, the ghosts and cruise elroy are reset, so re-post the triggers for them that already fired
+    if(mIsRearmPending)
     {
-        if(!cmInstance->isCharacterAlive(GameUtil::CharacterID::GHOST_RED))
-            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_RED);
-
-        if(!cmInstance->isCharacterAlive(GameUtil::CharacterID::GHOST_PINK))
-            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_PINK);
-    }
-    if(remainingPellets < 0.87f)
-    {
-        if(!cmInstance->isCharacterAlive(GameUtil::CharacterID::GHOST_BLUE))
-            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_BLUE);
-    }
-    if(remainingPellets < 0.66f)
-    {
-        if(!cmInstance->isCharacterAlive(GameUtil::CharacterID::GHOST_ORANGE))
-            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_ORANGE);
+        for(int32_t trigger = 0; trigger < mNextPelletTrigger; ++trigger)
+        {
+            if(mPelletTriggers[trigger].isRearmedOnDeath)
+            {
+                emInstance->postEvent((EventManager::GameEvent)mPelletTriggers[trigger].event);
+            }
+        }
+        setRearmPending(false);
     }
 
-    // activating cruise elroy mode for red ghost
-    switch (cmInstance->getCruiseElroyPhase())
+    // fire each trigger whose pellet count we've dropped to
+    while(mNextPelletTrigger < NUM_PELLET_TRIGGERS && numPellets <= mPelletTriggers[mNextPelletTrigger].numPellets)
     {
-        case GameUtil::CruiseElroyMode::NONE:
-            if(remainingPellets < mCruiseElroyThreshold_1) emInstance->postEvent(EventManager::GameEvent::CRUISE_ELROY);
-            break;
-        case GameUtil::CruiseElroyMode::CRUISE_1:
-            if(remainingPellets < mCruiseElroyThreshold_2) emInstance->postEvent(EventManager::GameEvent::CRUISE_ELROY);
-            break;
+        emInstance->postEvent((EventManager::GameEvent)mPelletTriggers[mNextPelletTrigger].event);
+        setNextPelletTrigger(mNextPelletTrigger + 1);
     }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void BoardManager::buildPelletTriggers()
+{
+    const float_t maxNumPellets = (float_t)mMaxNumPellets;
+    const StatsManager* smInstance = mWorld->getConstStatsManager();
 
-    // activating fruit
-    switch(FruitManager::ConstInstace()->getPhase())
+    // events, in the order they're posted when several fire at once, with the percent of pellets remaining
+    //      that they fire below (the level is won when no pellets remain)
+    const PelletTrigger triggers[NUM_PELLET_TRIGGERS] =
     {
-        case GameUtil::FruitPhase::PRE_FRUIT:
-            if(remainingPellets < 0.71f) emInstance->postEvent(EventManager::GameEvent::ACTIVATE_FRUIT);
-            break;
-        case GameUtil::FruitPhase::FRUIT_1:
-            if(remainingPellets < 0.3f) emInstance->postEvent(EventManager::GameEvent::ACTIVATE_FRUIT);
-            break;
-    }
+        { 0, EventManager::GameEvent::SPAWN_GHOST_RED,      true },
+        { 0, EventManager::GameEvent::SPAWN_GHOST_PINK,     true },
+        { 0, EventManager::GameEvent::SPAWN_GHOST_BLUE,     true },
+        { 0, EventManager::GameEvent::SPAWN_GHOST_ORANGE,   true },
+        { 0, EventManager::GameEvent::CRUISE_ELROY,         true },
+        { 0, EventManager::GameEvent::CRUISE_ELROY,         true },
+        { 0, EventManager::GameEvent::ACTIVATE_FRUIT,       false },
+        { 0, EventManager::GameEvent::ACTIVATE_FRUIT,       false },
+        { 0, EventManager::GameEvent::LEVEL_WIN,            false }
+    };
+    const float_t percents[NUM_PELLET_TRIGGERS] =
+    {
+        2.0f, 2.0f, 0.87f, 0.66f,
+        smInstance->getCruiseElroyDots_1(), smInstance->getCruiseElroyDots_2(),
+        0.71f, 0.3f,
+        0.0f
+    };
 
-    // check win event
-    if(remainingPellets == 0.0f)
+    for(int32_t trigger = 0; trigger < NUM_PELLET_TRIGGERS; ++trigger)
     {
-        if(!mDidPostWinEvent)
+        PelletTrigger current = triggers[trigger];
+
+        // find the highest pellet count whose remaining percent is below the trigger's percent
+        //      counting down with the same float division keeps the thresholds exactly where they were
+        current.numPellets = mMaxNumPellets;
+        while(current.numPellets >= 0 && !((float_t)current.numPellets / maxNumPellets < percents[trigger]))
+        {
+            current.numPellets--;
+        }
+        if(current.event == EventManager::GameEvent::LEVEL_WIN)
         {
-            emInstance->postEvent(EventManager::GameEvent::LEVEL_WIN);
-            mDidPostWinEvent = true;
+            current.numPellets = 0;
         }
+
+        // insert, keeping the table sorted by descending pellet count (stable for equal counts)
+        int32_t insert = trigger;
+        while(insert > 0 && mPelletTriggers[insert - 1].numPellets < current.numPellets)
+        {
+            mPelletTriggers[insert] = mPelletTriggers[insert - 1];
+            insert--;
+        }
+        mPelletTriggers[insert] = current;
     }
+
+    mPelletTriggerLevel = smInstance->getLevel();
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::flashTiles() const
+void BoardManager::flashTiles()
 {
     // set all tiles to flash
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
-    {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            mBoard[y][x]->activateFlash();
-        }
-    }
+    mGrid.activateFlash(mWorld->getGameTime());
 }
 
 //-----------------------------------------------------------------------------------------
 
-const Tile* BoardManager::getCharacterSpawnTile(GameUtil::CharacterID characterID) const
+const TileIndex BoardManager::getCharacterSpawnTile(GameUtil::CharacterID characterID) const
 {
     return mCharacterSpawns->at(characterID);
 }
 
 //-----------------------------------------------------------------------------------------
 
-const Tile* BoardManager::getGhostHomeTile(GameUtil::CharacterID characterID) const
+const TileIndex BoardManager::getGhostHomeTile(GameUtil::CharacterID characterID) const
 {
     return mGhostHomes->at(characterID);
 }
 
 //-----------------------------------------------------------------------------------------
 
-const Tile* BoardManager::getFruitTile() const
+const TileIndex BoardManager::getFruitTile() const
 {
     return mFruitTile;
 }
@@ -312,30 +328,14 @@ const Tile* BoardManager::getFruitTile() const
 
 const float_t BoardManager::getPercentPelletsRemaining() const
 {
-    return (float_t)mNumPellets / (float_t)mMaxNumPellets;
+    return (float_t)mGrid.getNumPellets() / (float_t)mMaxNumPellets;
 }
 
 //-----------------------------------------------------------------------------------------
 
-const Tile* BoardManager::lookNumTilesAhead(const Tile* tile, const uint32_t num, const GameUtil::BoardDirection direction) const
+const TileGrid* BoardManager::getGrid() const
 {
-    const Tile* returnTile = tile;
-    const Tile* tempTile = nullptr;
-
-    // step forward in the given direction until null is encountered
-    //      O(n), but 'num' is small and acts as a barrier against accidental array out-of-bounds
-    for(uint32_t iter = 0; iter < num; ++iter)
-    {
-        tempTile = returnTile->getNeighbor(direction);
-        if(tempTile == nullptr)
-        {
-            break;
-        }
-
-        returnTile = tempTile;
-    }
-
-    return returnTile;
+    return &mGrid;
 }
 
 
@@ -343,139 +343,67 @@ const Tile* BoardManager::lookNumTilesAhead(const Tile* tile, const uint32_t num
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::createTiles()
+const uint32_t BoardManager::getBoardChecksum() const
 {
-    FILE* boardFile = fopen(PACMAN_BOARD_FILE, "r");
-    char8_t buffer[NUM_BOARD_COLS + 8];
-
-    char8_t currentTileChar;
-    Coord2D currentTileIndex;
+    return mBoardChecksum;
+}
 
-    mMaxNumPellets = 0;
+//-----------------------------------------------------------------------------------------
 
-    // first pass on board, init grid array of tile pointers using file
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
+void BoardManager::loadBoard()
+{
+    // map the compiled board, no parsing needed
+    BoardFile boardFile;
+    bool8_t isLoaded = boardFile.open(PACMAN_BOARD_FILE);
+    if(!isLoaded)
     {
-        fscanf(boardFile, "%s", buffer);
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            currentTileChar = buffer[x];
-            currentTileIndex.x = x;
-            currentTileIndex.y = y;
+        fprintf(stderr, "%s is missing or invalid, rebuild it with the board compiler\n", PACMAN_BOARD_FILE);
+        assert(isLoaded);
+        return;
+    }
 
-            // set pellet type
-            Tile::TilePelletType pelletType;
-            switch(currentTileChar)
-            {
-                case 'O':
-                    pelletType = Tile::TilePelletType::POWER_PELLET;
-                    mMaxNumPellets++;
-                    break;
-                case 'S': case 'X': case 'o':
-                    pelletType = Tile::TilePelletType::PELLET;
-                    mMaxNumPellets++;
-                    break;
-                default:
-                    pelletType = Tile::TilePelletType::NO_PELLET;
-                    break;
-            }
+    const BoardFileData* data = boardFile.getData();
+    mGrid.load(data);
 
-            // set tile traversal type
-            Tile::TileTraverseType traverseType;
-            switch(currentTileChar)
-            {
-                case 'f': case '5': case '6': case '7': case '8': 
-                case '9': case '.': case 'o': case 'O':
-                    traverseType = Tile::TileTraverseType::TRAVERSABLE;
-                    break;
-                case '/':
-                    traverseType = Tile::TileTraverseType::GHOST_TRAVERSABLE;
-                    break;
-                case 'T':
-                    traverseType = Tile::TileTraverseType::TELEPORT;
-                    break;
-                case 't':
-                    traverseType = Tile::TileTraverseType::TUNNEL;
-                    break;
-                case 'x': case 'X':
-                    traverseType = Tile::TileTraverseType::INTERSECTION;
-                    break;
-                case 's': case 'S':
-                    traverseType = Tile::TileTraverseType::NO_UP_INTERSECTION;
-                    break;
-                case '^':
-                    traverseType = Tile::TileTraverseType::GHOST_HOME_EXIT;
-                    break;
-                case 'v':
-                    traverseType = Tile::TileTraverseType::GHOST_HOME_ENTER;
-                    break;
-                default:
-                    traverseType = Tile::TileTraverseType::NON_TRAVERSABLE;
-                    break;
-            }
-
-            // create new tile object at the current board position, save it in any relevant maps
-            mBoard[y][x] = new Tile(mTextureIndexMap->at(currentTileChar), currentTileIndex, mBoardPosition, traverseType, pelletType);
-            switch(currentTileChar)
-            {
-                case '0': case '1': case '2': case '3': case '4':
-                    mGhostHomes->insert(GhostHomesPair((GameUtil::CharacterID)(currentTileChar - '0'), mBoard[y][x]));
-                    break;
-                case '5': case '6': case '7': case '8': case '9':
-                    mCharacterSpawns->insert(CharacterSpawnsPair((GameUtil::CharacterID)(currentTileChar - '5'), mBoard[y][x]));
-                    break;
-                case 'f':
-                    mFruitTile = mBoard[y][x];
-                    break;
-            }
-        }
+    for(int32_t id = 0; id < NUM_BOARD_CHARACTERS; ++id)
+    {
+        mGhostHomes->insert(GhostHomesPair((GameUtil::CharacterID)id, data->ghostHomes[id]));
+        mCharacterSpawns->insert(CharacterSpawnsPair((GameUtil::CharacterID)id, data->characterSpawns[id]));
     }
+    mFruitTile = data->fruitTile;
 
-    fclose(boardFile);
+    mMaxNumPellets = mGrid.getNumStartPellets();
+    mBoardChecksum = boardFile.getChecksum();
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::connectTiles()
+void BoardManager::setNextPelletTrigger(const int32_t trigger)
 {
-    Tile* up;
-    Tile* left;
-    Tile* down;
-    Tile* right;
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::NEXT_PELLET_TRIGGER), mNextPelletTrigger, trigger);
+    mNextPelletTrigger = trigger;
+}
 
-    // second pass on board, connect tiles to their neighbors
-    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
-    {
-        for(int x = 0; x < NUM_BOARD_COLS; ++x)
-        {
-            up = y > 0 ? mBoard[y - 1][x] : nullptr;
-            left = x > 0 ? mBoard[y][x - 1] : nullptr;
-            down = y < NUM_BOARD_ROWS - 1 ? mBoard[y + 1][x] : nullptr;
-            right = x < NUM_BOARD_COLS - 1 ? mBoard[y][x + 1] : nullptr;
+//-----------------------------------------------------------------------------------------
 
-            // special case for left and right neighbors of teleport tiles
-            if(mBoard[y][x]->isTeleporter())
-            {
-                if(x == 0)
-                {
-                    // left teleporter's left neighbor is right teleporter
-                    left = mBoard[y][NUM_BOARD_COLS - 1];
-                }
-                else
-                {
-                    // right teleporter's right neighbor is left teleporter
-                    right = mBoard[y][0];
-                }
-            }
+void BoardManager::setRearmPending(const bool8_t isPending)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::REARM_PENDING), mIsRearmPending, isPending);
+    mIsRearmPending = isPending;
+}
 
-            mBoard[y][x]->setNeighbors(up, left, down, right);
-        }
-    }
+//-----------------------------------------------------------------------------------------
+
+void BoardManager::setTriggerCheckPending(const bool8_t isPending)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::TRIGGER_CHECK_PENDING), mIsTriggerCheckPending, isPending);
+    mIsTriggerCheckPending = isPending;
 }
 
 //-----------------------------------------------------------------------------------------
 
-void BoardManager::constructCharTextureMap()
+#ifndef PACSIM_HEADLESS
+void BoardManager::loadTextures()
 {
     mTileSpritesheetID = SOIL_load_OGL_texture(TILES_SPRITESHEET, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID,
         SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
@@ -484,30 +412,5 @@ void BoardManager::constructCharTextureMap()
     mPelletImageID = SOIL_load_OGL_texture(PELLET_IMAGE, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID,
         SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
     assert(mPelletImageID > 0);
-
-    // read map file, associating each alphanumerical key with an (x,y) offset index into the tile spritesheet
-    FILE* tileMapFile = fopen(TILE_MAPPINGS_FILE, "r");
-
-    char8_t key;
-    int xOffset, yOffset;
-    while(fscanf(tileMapFile, "%c %d %d\n", &key, &xOffset, &yOffset) != EOF)
-    {
-        mTextureIndexMap->insert(CharIndexPair(key, getTileTextureOffset(xOffset, yOffset)));
-    }
-
-    fclose(tileMapFile);
-}
-
-//-----------------------------------------------------------------------------------------
-
-Coord2D BoardManager::getTileTextureOffset(float x, float y)
-{
-    Coord2D textureCoord;
-
-    // store the texture coord as the % offset from the tile texture file start
-    //      y offset is backwards, need to compensate
-    textureCoord.x = x / (NUM_TILE_TEXTURE_COLS * NUM_TILE_ANIM_CHUNKS);
-    textureCoord.y = (NUM_TILE_TEXTURE_ROWS - y - 1) / NUM_TILE_TEXTURE_ROWS;
-
-    return textureCoord;
 }
+#endif
@@ -1,9 +1,11 @@
 
-#define NUM_BOARD_ROWS 36
-#define NUM_BOARD_COLS 28
+#define NUM_PELLET_TRIGGERS     9
+
+class GameWorld;
+struct BoardState;
 
 /*
- * Stores a graph of tiles for the field of play.
+ * Stores the grid of tiles for the field of play.
  * Handles the updates for tiles, pellets, and 
  * board-related events.
  */
@@ -11,8 +13,7 @@ class BoardManager
 {
 public:
 
-    static BoardManager* Instance();
-    static const BoardManager* ConstInstace();
+    BoardManager(const GameWorld* world);
 
     /*
      * Reads files to map different types of tiles 
@@ -27,9 +28,32 @@ public:
     void reset();
 
     /*
-     * Calls update on each tile in the board.
+     * Re-posts the pellet triggers for ghost spawns and Cruise Elroy
+     * on the next update, since pacman's death resets them.
+     */
+    void resetFromDeath();
+
+    /*
+     * Copies the pellets and pellet trigger progress out to
+     * 'state', or back in from it. The triggers themselves
+     * are rebuilt if the level differs from the one they were
+     * built for, so the StatsManager must be loaded first.
+     */
+    void saveState(BoardState* state) const;
+    void loadState(const BoardState* state);
+
+    /*
+     * Checks for a collected pellet, and fires any pellet
+     * triggers the pellet count has crossed.
+     */
+    void updateBoard();
+
+    /*
+     * Returns the number of updates, from now, that won't collect
+     * a pellet or check the pellet triggers. The board has no
+     * timers, so this is either none or unlimited.
      */
-    void updateBoard(DWORD milliseconds);
+    const uint32_t getNumQuietTicks() const;
 
     /*
      * Draws tiles, then draws pellets on top.
@@ -45,13 +69,13 @@ public:
      * Tells all tiles to begin their flashing animation
      * when a level is cleared.
      */
-    void flashTiles() const;
+    void flashTiles();
 
     /*
      * Character spawn tiles are mapped to a character ID.
      * Returns the spawn tile for the given character ID.
      */
-    const Tile* getCharacterSpawnTile(GameUtil::CharacterID characterID) const;
+    const TileIndex getCharacterSpawnTile(GameUtil::CharacterID characterID) const;
 
     /*
      * Ghosts' home tiles (the tile they target in SCATTER mode) are mapped
@@ -60,12 +84,12 @@ public:
      * The PACMAN ID is the the home tile inside the ghost home, which is
      * what ghosts target while DEAD, so they move to the ghost home.
      */
-    const Tile* getGhostHomeTile(GameUtil::CharacterID characterID) const;
+    const TileIndex getGhostHomeTile(GameUtil::CharacterID characterID) const;
 
     /*
      * Returns the tile marked as the fruit spawn tile.
      */
-    const Tile* getFruitTile() const;
+    const TileIndex getFruitTile() const;
     
     /*
      * Returns the percentage of pellets that remain on the board. Used
@@ -74,80 +98,95 @@ public:
     const float_t getPercentPelletsRemaining() const;
 
     /*
-     * Iteratively looks from 'tile' at neighbors in 'direction' 'num' times.
-     * Stops when the number of tiles ahead has been met, or nullptr is encountered.
-     *
-     * (For example, finding the tile 4 spaces LEFT of the given 'tile'.)
+     * Returns the grid of tiles, for characters to query
+     * neighbors, traversal types, and pellets.
+     */
+    const TileGrid* getGrid() const;
+
+    /*
+     * Returns the checksum of the board file the board was loaded
+     * from, which identifies the board.
      */
-    const Tile* lookNumTilesAhead(const Tile* tile, const uint32_t num, const GameUtil::BoardDirection direction) const;
+    const uint32_t getBoardChecksum() const;
 
 private:
 
-    BoardManager();
+    /*
+     * An event that is posted once when the number of pellets remaining
+     * drops to 'numPellets'. Triggers that are rearmed on death are posted
+     * again after pacman dies, if they had already fired.
+     */
+    typedef struct
+    {
+        int32_t numPellets;
+        int32_t event;                  // EventManager::GameEvent
+        bool8_t isRearmedOnDeath;
+    }PelletTrigger;
 
     /*
      * Calls on pacman's current tile to check if its pellet needs to be collected.
+     * Returns true if a pellet was collected.
      */
-    void checkPelletCollected();
+    bool8_t checkPelletCollected();
 
     /*
      * Triggers events such as ghost spawns, fruit spawns, and Cruise Elroy
-     * based on the number of pellets remaining on the board.
+     * once the number of pellets remaining drops to their thresholds.
      */
-    void checkPelletTriggerEvents();
+    void checkPelletTriggerEvents(const int32_t numPellets);
 
     /*
-     * Init method that creates the tile objects and assigns them
-     * sprite and pellet data. Places each tile in the mBoard array.
+     * Converts the percent-of-pellets-remaining thresholds for the current
+     * level into pellet counts, sorted so that the next trigger to fire is
+     * always at mNextPelletTrigger. Leaves mNextPelletTrigger alone, so
+     * loading a state can rebuild the table without touching the hash.
      */
-    void createTiles();
+    void buildPelletTriggers();
 
     /*
-     * Init method that does a second pass through mBoard and connects
-     * each tile to its neighbors as a graph.
+     * Init method that maps the compiled board file, loads the grid
+     * from it, and saves the spawn, home, and fruit tiles.
      */
-    void connectTiles();
+    void loadBoard();
 
     /*
-     * Loads the tile texture, and reads the TileMappings file to map
-     * tile codes with texture coordinates.
+     * Loads the tile spritesheet and pellet textures.
      */
-    void constructCharTextureMap();
+    void loadTextures();
 
     /*
-     * Calculates the true [0,1] texture coordinates of a tile
-     * based on its mapped texture coordinates.
+     * Setters for the next pellet trigger and the pending trigger
+     * checks, which keep the world's Zobrist hash up to date.
      */
-    Coord2D getTileTextureOffset(float x, float y);         // x and y here are indices in the tile spritesheet
+    void setNextPelletTrigger(const int32_t trigger);
+    void setRearmPending(const bool8_t isPending);
+    void setTriggerCheckPending(const bool8_t isPending);
 
-    static BoardManager* _instance;
+    const GameWorld* mWorld;
 
     Coord2D mBoardPosition;
 
-    Tile* mBoard[NUM_BOARD_ROWS][NUM_BOARD_COLS];
+    TileGrid mGrid;
 
-    typedef std::map<GameUtil::CharacterID, Tile*> GhostHomes;           // maps ghost ID number to a particular tile (ghost's "home" for scatter behavior)
-    typedef std::pair<GameUtil::CharacterID, Tile*> GhostHomesPair;
+    typedef std::map<GameUtil::CharacterID, TileIndex> GhostHomes;           // maps ghost ID number to a particular tile (ghost's "home" for scatter behavior)
+    typedef std::pair<GameUtil::CharacterID, TileIndex> GhostHomesPair;
     GhostHomes* mGhostHomes;
 
-    typedef std::map<GameUtil::CharacterID, Tile*> CharacterSpawns;      // maps character ID numbers to spawn points
-    typedef std::pair<GameUtil::CharacterID, Tile*> CharacterSpawnsPair;
+    typedef std::map<GameUtil::CharacterID, TileIndex> CharacterSpawns;      // maps character ID numbers to spawn points
+    typedef std::pair<GameUtil::CharacterID, TileIndex> CharacterSpawnsPair;
     CharacterSpawns* mCharacterSpawns;
 
-    typedef std::map<char8_t, Coord2D> TextureIndexMap;                 // maps alphanumerical characters to texture indicies in a loaded bitmap
-    typedef std::pair<char8_t, Coord2D> CharIndexPair;
-    TextureIndexMap* mTextureIndexMap;
+    TileIndex mFruitTile;                                               // location of spawned fruit
 
-    const Tile* mFruitTile;                                             // location of spawned fruit
+    int32_t mMaxNumPellets;                                             // pellets remaining are counted from the grid's bitboard
+    uint32_t mBoardChecksum;                                            // checksum of the board file
 
-    int32_t mNumPellets;
-    int32_t mMaxNumPellets;
-
-    float_t mCruiseElroyThreshold_1;        // saved values from the stats manager -- dot amounts needed to activate cruise elroy
-    float_t mCruiseElroyThreshold_2;
+    PelletTrigger mPelletTriggers[NUM_PELLET_TRIGGERS];     // sorted by descending pellet count
+    int32_t mNextPelletTrigger;                             // first trigger that hasn't fired this level
+    int32_t mPelletTriggerLevel;                            // level the triggers were built for
+    bool8_t mIsRearmPending;                                // pacman died, re-post fired triggers that are rearmed on death
+    bool8_t mIsTriggerCheckPending;                         // check the triggers on the next update even if no pellet was collected
 
     GLuint mTileSpritesheetID;
     GLuint mPelletImageID;
-
-    bool8_t mDidPostWinEvent;
 };
@@ -2,25 +2,41 @@
 #define CHARACTER_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "Character.h"
+#include "BoardManager.h"
+#include "ZobristHash.h"
 
-#define BASE_SPEED 0.56f
+#include "GameWorld.h"
+
+#define BASE_SPEED 0.56f        // in the OpenGL space per millisecond
+
+#define ARRIVED_PERCENT     99  // percent of the square-distance between tiles that counts as arriving
 
 #define FRAME_DELTA_TIME     100
 
-Character::Character(const Tile* spawnTile, const GameUtil::CharacterID id) :
+Character::Character(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id) :
+    mWorld(world),
+    mGrid(world->getConstBoardManager()->getGrid()),
     mCharacterID(id),
+    mFacingDirection(GameUtil::BoardDirection::LEFT),
+    mMovementState(MovementState::AT_TILE),
+    mPosition(TileGrid::getTilePosition(spawnTile)),
+    mBaseSpeed(BASE_SPEED),
     mSpawnTile(spawnTile),
-    mBaseSpeed(BASE_SPEED)
+    mPrevTile(spawnTile),
+    mCurrTile(spawnTile),
+    mNextTile(spawnTile),
+    mIsPaused(true),
+    mIsAlive(true),
+    mDidTeleport(false)
 {
 }
 
@@ -35,26 +51,27 @@ void Character::init()
 void Character::reset()
 {
     // reset bools
-    mIsPaused = true;
+    setPaused(true);
     mIsVisible = false;
-    mIsAlive = true;
-    mDidTeleport = false;
+    setAlive(true);
+    setDidTeleport(false);
 
-    // reset animation
+    // reset animation, held until the character is unpaused
     mAnimChunkID = (GameUtil::AnimChunkID)mCharacterID;
-    mAnimFrame = 0;
-    mTimeOnCurrFrame = 0;
     mFrameDeltaTime = FRAME_DELTA_TIME;
+    mIsAnimHeld = true;
+    restartAnimation();
 
     // reset tiles and position
-    mCurrTile = mNextTile = mPrevTile = mSpawnTile;
-    Coord2D spawnPos = mSpawnTile->getPosition();
-    mPosition.x = spawnPos.x;
-    mPosition.y = spawnPos.y;
+    setNextTile(mSpawnTile);
+    setPrevTile(mSpawnTile);
+    setCurrTile(mSpawnTile);
+    setPosition(TileGrid::getTilePosition(mSpawnTile));
+    mLastPosition = mPosition;
 
     // reset movement states
-    mFacingDirection = GameUtil::BoardDirection::LEFT;
-    mMovementState = MovementState::AT_TILE;
+    setFacingDirection(GameUtil::BoardDirection::LEFT);
+    setMovementState(MovementState::AT_TILE);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -62,26 +79,73 @@ void Character::reset()
 void Character::resetFromDeath()
 {
     // reset bools
-    mIsPaused = true;
+    setPaused(true);
     mIsVisible = false;
-    mIsAlive = true;
-    mDidTeleport = false;
+    setAlive(true);
+    setDidTeleport(false);
 
-    // reset animation
+    // reset animation, held until the character is unpaused
     mAnimChunkID = (GameUtil::AnimChunkID)mCharacterID;
-    mAnimFrame = 0;
-    mTimeOnCurrFrame = 0;
     mFrameDeltaTime = FRAME_DELTA_TIME;
+    mIsAnimHeld = true;
+    restartAnimation();
 
     // reset tiles and position
-    mCurrTile = mNextTile = mPrevTile = mSpawnTile;
-    Coord2D spawnPos = mSpawnTile->getPosition();
-    mPosition.x = spawnPos.x;
-    mPosition.y = spawnPos.y;
+    setNextTile(mSpawnTile);
+    setPrevTile(mSpawnTile);
+    setCurrTile(mSpawnTile);
+    setPosition(TileGrid::getTilePosition(mSpawnTile));
+    mLastPosition = mPosition;
 
     // reset movement states
-    mFacingDirection = GameUtil::BoardDirection::LEFT;
-    mMovementState = MovementState::AT_TILE;
+    setFacingDirection(GameUtil::BoardDirection::LEFT);
+    setMovementState(MovementState::AT_TILE);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::saveState(CharacterState* state) const
+{
+    state->animChunkID = mAnimChunkID;
+    state->animStartTime = mAnimStartTime;
+    state->animHoldTime = mAnimHoldTime;
+    state->frameDeltaTime = mFrameDeltaTime;
+    state->facingDirection = mFacingDirection;
+    state->movementState = mMovementState;
+    state->position = mPosition;
+    state->lastPosition = mLastPosition;
+    state->speed = mSpeed;
+    state->prevTile = mPrevTile;
+    state->currTile = mCurrTile;
+    state->nextTile = mNextTile;
+    state->isAnimHeld = mIsAnimHeld;
+    state->isPaused = mIsPaused;
+    state->isVisible = mIsVisible;
+    state->isAlive = mIsAlive;
+    state->didTeleport = mDidTeleport;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::loadState(const CharacterState* state)
+{
+    mAnimChunkID = (GameUtil::AnimChunkID)state->animChunkID;
+    mAnimStartTime = state->animStartTime;
+    mAnimHoldTime = state->animHoldTime;
+    mFrameDeltaTime = state->frameDeltaTime;
+    mFacingDirection = (GameUtil::BoardDirection)state->facingDirection;
+    mMovementState = (MovementState)state->movementState;
+    mPosition = state->position;
+    mLastPosition = state->lastPosition;
+    mSpeed = state->speed;
+    mPrevTile = state->prevTile;
+    mCurrTile = state->currTile;
+    mNextTile = state->nextTile;
+    mIsAnimHeld = state->isAnimHeld;
+    mIsPaused = state->isPaused;
+    mIsVisible = state->isVisible;
+    mIsAlive = state->isAlive;
+    mDidTeleport = state->didTeleport;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -116,42 +180,120 @@ void Character::updateMovement(DWORD milliseconds)
 
 //-----------------------------------------------------------------------------------------
 
-void Character::updateAnimation(DWORD milliseconds)
+const uint32_t Character::getNumQuietTicks(DWORD tickTime) const
 {
-    if(!mIsPaused)
+    if(mIsPaused)
     {
-        // update the time spent on the current frame
-        mTimeOnCurrFrame += milliseconds;
-        if(mTimeOnCurrFrame >= mFrameDeltaTime)
-        {
-            // if the delta time has passed, increment our current frame
-            mTimeOnCurrFrame = 0;
-            mAnimFrame++;
+        return TICKS_UNLIMITED;
+    }
 
-            // if the frame is out of bounds, wrap around
-            if(mAnimFrame >= NUM_ANIM_FRAMES)
-            {
-                mAnimFrame = 0;
-            }
-        }
+    // a character at a tile chooses its next one on the next update
+    if(mMovementState != MovementState::MOVING)
+    {
+        return 0;
     }
+
+    // find how far along the line from the previous tile we are
+    //      characters only move straight away from the previous tile, anything else is left to handleMovement
+    TilePosition prevTilePos = TileGrid::getTilePosition(mPrevTile);
+    int32_t distAlong, distAcross;
+    switch(mFacingDirection)
+    {
+        case GameUtil::BoardDirection::UP:
+            distAlong = prevTilePos.y - mPosition.y;
+            distAcross = mPosition.x - prevTilePos.x;
+            break;
+
+        case GameUtil::BoardDirection::LEFT:
+            distAlong = prevTilePos.x - mPosition.x;
+            distAcross = mPosition.y - prevTilePos.y;
+            break;
+
+        case GameUtil::BoardDirection::DOWN:
+            distAlong = mPosition.y - prevTilePos.y;
+            distAcross = mPosition.x - prevTilePos.x;
+            break;
+
+        case GameUtil::BoardDirection::RIGHT:
+            distAlong = mPosition.x - prevTilePos.x;
+            distAcross = mPosition.y - prevTilePos.y;
+            break;
+
+        default:
+            return 0;
+    }
+
+    if(distAlong < 0 || distAcross != 0)
+    {
+        return 0;
+    }
+
+    // handleMovement's next change is crossing into the next tile, or arriving if we already have
+    uint32_t distBetween = TileGrid::getSquareDistBetween(prevTilePos, TileGrid::getTilePosition(mNextTile));
+    uint32_t threshold = mCurrTile == mNextTile ?
+        distBetween - distBetween / 100 * (100 - ARRIVED_PERCENT) :
+        distBetween - distBetween / 2;
+
+    // updates are quiet while the square-distance travelled is under the threshold
+    uint32_t maxDistAlong = threshold > 0 ? GameUtil::Utilities::squareRoot(threshold - 1) : 0;
+    if(threshold == 0 || (uint32_t)distAlong > maxDistAlong)
+    {
+        return 0;
+    }
+
+    int32_t step = getStep(tickTime);
+    if(step <= 0)
+    {
+        return TICKS_UNLIMITED;
+    }
+
+    return (maxDistAlong - distAlong) / step + 1;
 }
 
 //-----------------------------------------------------------------------------------------
 
+void Character::skipQuietTicks(DWORD tickTime, uint32_t numTicks)
+{
+    // paused characters and characters that don't move still save their position every update
+    if(!mIsPaused && mMovementState == MovementState::MOVING)
+    {
+        int32_t step = getStep(tickTime);
+        moveForward(step * (numTicks - 1));
+        saveLastPosition();
+        moveForward(step);
+    }
+    else
+    {
+        saveLastPosition();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
 void Character::drawCharacter()
 {
     if(mIsVisible)
     {
         Coord2D vertTR, vertBL, textureCoord, textureSize;
 
-        vertTR.x = (mPosition.x + HALF_CHARACTER_SPRITE_SIZE);
-        vertTR.y = (mPosition.y - HALF_CHARACTER_SPRITE_SIZE);
-        vertBL.x = (mPosition.x - HALF_CHARACTER_SPRITE_SIZE);
-        vertBL.y = (mPosition.y + HALF_CHARACTER_SPRITE_SIZE);
+        // draw between the position before the last tick and the current one, unless we teleported
+        Coord2D position = mGrid->getPosition(mPosition);
+        if(TileGrid::getSquareDistBetween(mLastPosition, mPosition) <= TILE_UNITS * TILE_UNITS)
+        {
+            Coord2D lastPosition = mGrid->getPosition(mLastPosition);
+            float_t interpolation = mWorld->getInterpolation();
+            position.x = lastPosition.x + (position.x - lastPosition.x) * interpolation;
+            position.y = lastPosition.y + (position.y - lastPosition.y) * interpolation;
+        }
+
+        vertTR.x = (position.x + HALF_CHARACTER_SPRITE_SIZE);
+        vertTR.y = (position.y - HALF_CHARACTER_SPRITE_SIZE);
+        vertBL.x = (position.x - HALF_CHARACTER_SPRITE_SIZE);
+        vertBL.y = (position.y + HALF_CHARACTER_SPRITE_SIZE);
 
-        textureCoord.x = (mAnimChunkID * CHARACTER_CHUNK_SIZE) + (mFacingDirection * CHARACTER_COL_SIZE);
-        textureCoord.y = mAnimFrame * CHARACTER_ROW_SIZE;
+        textureCoord.x = (getAnimChunkID() * CHARACTER_CHUNK_SIZE) + (mFacingDirection * CHARACTER_COL_SIZE);
+        textureCoord.y = getAnimFrame() * CHARACTER_ROW_SIZE;
         textureSize.x = CHARACTER_COL_SIZE;
         textureSize.y = CHARACTER_ROW_SIZE;
         
@@ -160,6 +302,7 @@ void Character::drawCharacter()
         GameUtil::Utilities::drawSprite(vertTR, vertBL, textureCoord, textureSize);
     }
 }
+#endif
 
 //-----------------------------------------------------------------------------------------
 
@@ -171,91 +314,234 @@ void Character::shutdown()
 
 void Character::handleMovement(DWORD milliseconds)
 {
-    Coord2D prevTilePos = mPrevTile->getPosition();
-    float distFromPrev = GameUtil::Utilities::squareDistance(mPosition.x, prevTilePos.x, mPosition.y, prevTilePos.y);
-    float distBetween = mPrevTile->getSquareDistToTile(mNextTile);
+    TilePosition prevTilePos = TileGrid::getTilePosition(mPrevTile);
+    uint32_t distFromPrev = TileGrid::getSquareDistBetween(prevTilePos, mPosition);
+    uint32_t distBetween = TileGrid::getSquareDistBetween(prevTilePos, TileGrid::getTilePosition(mNextTile));
 
-    // get the percent distance we've travelled from previous to next
-    float percentTravelled = distFromPrev / distBetween;
-    if(percentTravelled >= 0.99f)
+    // compare how far we've travelled from previous to next, as a percent of the square-distance
+    if(distFromPrev >= distBetween - distBetween / 100 * (100 - ARRIVED_PERCENT))
     {
         // we are at (or somehow passed) the next tile, snap position
-        Coord2D nextTilePos = mNextTile->getPosition();
-        mPosition.x = nextTilePos.x;
-        mPosition.y = nextTilePos.y;
+        setPosition(TileGrid::getTilePosition(mNextTile));
 
         // special case for when we're at a teleporter
         //      snap to the teleporter's sibling, then set a boolean flag
         //          the boolean flag makes it so we don't bounce back and forth after
         //          the first teleport and instead move to the next non-teleporter
         //          so we can transition to AT_TILE
-        if(mCurrTile->isTeleporter())
+        if(mGrid->isTeleporter(mCurrTile))
         {
             if(!mDidTeleport)
             {
                 // snap position to the other teleporter
-                mCurrTile = mCurrTile->getNeighbor(mFacingDirection);
-                mPosition.x = mCurrTile->getPosition().x;
-                mPosition.y = mCurrTile->getPosition().y;
+                setCurrTile(mGrid->getNeighbor(mCurrTile, mFacingDirection));
+                setPosition(TileGrid::getTilePosition(mCurrTile));
 
                 // target the next non-teleporter tile for movement
-                mPrevTile = mCurrTile;
-                mNextTile = mCurrTile->getNeighbor(mFacingDirection);
+                setPrevTile(mCurrTile);
+                setNextTile(mGrid->getNeighbor(mCurrTile, mFacingDirection));
 
-                mDidTeleport = true;
+                setDidTeleport(true);
             }
         }
         else
         {
-            mDidTeleport = false;
-            mMovementState = MovementState::AT_TILE;
+            setDidTeleport(false);
+            setMovementState(MovementState::AT_TILE);
         }
     }
     else
     {
         // we are halfway there, migrate the current tile
-        if(percentTravelled >= 0.5f)
+        if(distFromPrev >= distBetween - distBetween / 2)
         {
-            mCurrTile = mNextTile;
+            setCurrTile(mNextTile);
         }
 
         // handle movement in our current direction
-        switch(mFacingDirection)
-        {
-            case GameUtil::BoardDirection::UP:
-                mPosition.y += mSpeed * milliseconds;
-                break;
+        moveForward(getStep(milliseconds));
+    }
+}
 
-            case GameUtil::BoardDirection::LEFT:
-                mPosition.x -= mSpeed * milliseconds;
-                break;
+//-----------------------------------------------------------------------------------------
 
-            case GameUtil::BoardDirection::DOWN:
-                mPosition.y -= mSpeed * milliseconds;
-                break;
+const int32_t Character::getStep(DWORD milliseconds) const
+{
+    // the only float math left in movement, speeds are set from float stats
+    //      rounded to a whole number of steps, so the rest is exact
+    return (int32_t)(mSpeed * milliseconds * TILE_UNITS / TILE_SPRITE_OFFSET_FACTOR + 0.5f);
+}
 
-            case GameUtil::BoardDirection::RIGHT:
-                mPosition.x += mSpeed * milliseconds;
-                break;
+//-----------------------------------------------------------------------------------------
 
-            default:
-                break;
-        }
+void Character::moveForward(const int32_t distance)
+{
+    TilePosition position = mPosition;
+    switch(mFacingDirection)
+    {
+        case GameUtil::BoardDirection::UP:
+            position.y -= distance;
+            break;
+
+        case GameUtil::BoardDirection::LEFT:
+            position.x -= distance;
+            break;
+
+        case GameUtil::BoardDirection::DOWN:
+            position.y += distance;
+            break;
+
+        case GameUtil::BoardDirection::RIGHT:
+            position.x += distance;
+            break;
+
+        default:
+            break;
     }
+
+    setPosition(position);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::saveLastPosition()
+{
+    mLastPosition = mPosition;
 }
 
 //-----------------------------------------------------------------------------------------
 
 void Character::unpause()
 {
-    mIsPaused = false;
+    setPaused(false);
+    releaseAnimation();
 }
 
 //-----------------------------------------------------------------------------------------
 
 void Character::pause()
 {
-    mIsPaused = true;
+    setPaused(true);
+    holdAnimation();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::restartAnimation()
+{
+    mAnimStartTime = mWorld->getGameTime();
+    mAnimHoldTime = mAnimStartTime;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::holdAnimation()
+{
+    if(!mIsAnimHeld)
+    {
+        mAnimHoldTime = mWorld->getGameTime();
+        mIsAnimHeld = true;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::releaseAnimation()
+{
+    if(mIsAnimHeld)
+    {
+        // skip the start time past the time spent held
+        mAnimStartTime += mWorld->getGameTime() - mAnimHoldTime;
+        mIsAnimHeld = false;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Character::getAnimFrame() const
+{
+    uint32_t animTime = (mIsAnimHeld ? mAnimHoldTime : mWorld->getGameTime()) - mAnimStartTime;
+    return (animTime / mFrameDeltaTime) % NUM_ANIM_FRAMES;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const GameUtil::AnimChunkID Character::getAnimChunkID() const
+{
+    return mAnimChunkID;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setCurrTile(const TileIndex tile)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_TILE, mCharacterID), mCurrTile, tile);
+    mCurrTile = tile;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setPrevTile(const TileIndex tile)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_PREV_TILE, mCharacterID), mPrevTile, tile);
+    mPrevTile = tile;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setNextTile(const TileIndex tile)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_NEXT_TILE, mCharacterID), mNextTile, tile);
+    mNextTile = tile;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setFacingDirection(const GameUtil::BoardDirection direction)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_FACING, mCharacterID), mFacingDirection, direction);
+    mFacingDirection = direction;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setPosition(const TilePosition& position)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_POSITION_X, mCharacterID), mPosition.x, position.x);
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_POSITION_Y, mCharacterID), mPosition.y, position.y);
+    mPosition = position;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setMovementState(const MovementState state)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_MOVEMENT_STATE, mCharacterID), mMovementState, state);
+    mMovementState = state;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setPaused(const bool8_t isPaused)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_PAUSED, mCharacterID), mIsPaused, isPaused);
+    mIsPaused = isPaused;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setAlive(const bool8_t isAlive)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_ALIVE, mCharacterID), mIsAlive, isAlive);
+    mIsAlive = isAlive;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Character::setDidTeleport(const bool8_t didTeleport)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTER_TELEPORTED, mCharacterID), mDidTeleport, didTeleport);
+    mDidTeleport = didTeleport;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -283,7 +569,7 @@ const bool8_t Character::isAlive() const
 
 void Character::setLiving(bool alive)
 {
-    mIsAlive = alive;
+    setAlive(alive);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -295,7 +581,7 @@ const GameUtil::CharacterID Character::getCharacterID() const
 
 //-----------------------------------------------------------------------------------------
 
-const Tile* Character::getCurrentTile() const
+const TileIndex Character::getCurrentTile() const
 {
     return mCurrTile;
 }
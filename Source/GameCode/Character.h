@@ -12,6 +12,9 @@
 #define CHARACTER_SPRITE_OFFSET_FACTOR      CHARACTER_SPRITE_SIZE*3.25f
 #define HALF_CHARACTER_SPRITE_SIZE          CHARACTER_SPRITE_OFFSET_FACTOR/2.0f
 
+class GameWorld;
+struct CharacterState;
+
 /*
  * Base class for all characters that can
  * move around the board.
@@ -33,9 +36,10 @@ public:
     }MovementState;
 
     /*
-     * Constructor.
+     * Constructor. The character keeps 'world' to call on
+     * the world's managers.
      */
-    Character(const Tile* spawnTile, const GameUtil::CharacterID id);
+    Character(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
 
     /*
      * Initializes values for the character.
@@ -53,6 +57,20 @@ public:
      */
     virtual void resetFromDeath();
 
+    /*
+     * Copies the character's position, movement, and animation
+     * out to 'state', or back in from it. Character types with
+     * more state add theirs to the same CharacterState.
+     */
+    virtual void saveState(CharacterState* state) const;
+    virtual void loadState(const CharacterState* state);
+
+    /*
+     * Sets the animation back to its first frame, as of the
+     * world's current game time. See holdAnimation() below.
+     */
+    void restartAnimation();
+
     /*
      * Updates any timers that the character may be running.
      */
@@ -65,21 +83,38 @@ public:
      */
     virtual void updateMovement(DWORD milliseconds);
 
-    /*
-     * Updates the delta time between the character's 
-     * animation frames.
-     */
-    virtual void updateAnimation(DWORD milliseconds);
-
     /*
      * Virtual function. Characters update their speed
      * here, based on a number of factors.
      */
     virtual void updateSpeed() = 0;
 
+    /*
+     * Returns the number of updates of 'tickTime' ms, from now,
+     * over which the character only moves straight on: it doesn't
+     * reach its next tile, cross into it, or choose where to go.
+     * Paused characters don't change at all, so this is unlimited.
+     */
+    virtual const uint32_t getNumQuietTicks(DWORD tickTime) const;
+
+    /*
+     * Makes 'numTicks' updates of 'tickTime' ms at once, moving
+     * the character as far as they would. Only for updates
+     * covered by getNumQuietTicks.
+     */
+    virtual void skipQuietTicks(DWORD tickTime, uint32_t numTicks);
+
+    /*
+     * Stores the character's position before it moves this
+     * tick. Called by the CharacterManager on every tick.
+     */
+    void saveLastPosition();
+
     /*
      * Draws the character to the screen. The draw call
      * is ignored if the character is marked as invisible.
+     * The character is drawn between its last and current
+     * positions, by the world's interpolation factor.
      */
     void drawCharacter();
 
@@ -129,7 +164,7 @@ public:
      * Getters for movement variables, such as movement tile,
      * facing direction, and movement state.
      */
-    const Tile* getCurrentTile() const;
+    const TileIndex getCurrentTile() const;
     const GameUtil::BoardDirection getFacingDirection() const;
     const MovementState getMovementState() const;
 
@@ -137,10 +172,21 @@ private:
 
     /*
      * Physically moves the character in the direction
-     * given by mFacingDirection.
+     * given by mFacingDirection, in whole fixed-point steps.
      */
     void handleMovement(DWORD milliseconds);
 
+    /*
+     * Returns the distance the character moves in 'milliseconds',
+     * in fixed-point steps.
+     */
+    const int32_t getStep(DWORD milliseconds) const;
+
+    /*
+     * Moves the character 'distance' steps in mFacingDirection.
+     */
+    void moveForward(const int32_t distance);
+
     /*
      * Virtual function. When in AT_TILE, characters update their
      * mNextTile movement target and then reenter the MOVING state.
@@ -149,25 +195,73 @@ private:
 
 protected:
 
+    /*
+     * The animation frame isn't stepped every update. It's derived
+     * from the world's game clock and the time the animation started
+     * when the character is drawn.
+     *
+     * Restarting sets the animation back to its first frame. Holding
+     * freezes it on its current frame, and releasing continues it
+     * from there, as if no time had passed while it was held.
+     */
+    void holdAnimation();
+    void releaseAnimation();
+
+    /*
+     * Returns the current animation frame.
+     */
+    const uint32_t getAnimFrame() const;
+
+    /*
+     * Returns the animation chunk to draw the character from.
+     */
+    virtual const GameUtil::AnimChunkID getAnimChunkID() const;
+
+    /*
+     * Setters for the tiles, facing direction, position, movement
+     * state, and flags, which keep the world's Zobrist hash up to
+     * date.
+     */
+    void setCurrTile(const TileIndex tile);
+    void setPrevTile(const TileIndex tile);
+    void setNextTile(const TileIndex tile);
+    void setFacingDirection(const GameUtil::BoardDirection direction);
+    void setPosition(const TilePosition& position);
+    void setMovementState(const MovementState state);
+    void setAlive(const bool8_t isAlive);
+    void setDidTeleport(const bool8_t didTeleport);
+
+    /*
+     * Setter for whether the character is paused, which keeps the
+     * world's Zobrist hash up to date. Character types with timers
+     * that only run while unpaused stop and start them here.
+     */
+    virtual void setPaused(const bool8_t isPaused);
+
+    const GameWorld* mWorld;                // world that owns this character
+    const TileGrid* mGrid;                  // tiles of the world's board
+
     const GameUtil::CharacterID mCharacterID;
 
     GameUtil::AnimChunkID mAnimChunkID;
-    uint32_t mAnimFrame;
-    uint32_t mTimeOnCurrFrame;
+    uint32_t mAnimStartTime;    // game time of the animation's first frame
+    uint32_t mAnimHoldTime;     // game time the animation was held at
+    bool8_t mIsAnimHeld;
     uint32_t mFrameDeltaTime;
 
     GameUtil::BoardDirection mFacingDirection;
     MovementState mMovementState;
 
-    Coord2D mPosition;
+    TilePosition mPosition;
+    TilePosition mLastPosition;     // position before the last tick, for drawing between ticks
 
     float mBaseSpeed;
     float mSpeed;
 
-    const Tile* mSpawnTile;
-    const Tile* mPrevTile;      // tile that the character is moving from
-    const Tile* mCurrTile;      // tile that the character is currently at
-    const Tile* mNextTile;      // tile that the character is moving towards
+    TileIndex mSpawnTile;
+    TileIndex mPrevTile;        // tile that the character is moving from
+    TileIndex mCurrTile;        // tile that the character is currently at
+    TileIndex mNextTile;        // tile that the character is moving towards
 
     bool8_t mIsPaused;
     bool8_t mIsVisible;
@@ -2,17 +2,18 @@
 #define CHARACTER_MANAGER_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
+#ifndef PACSIM_HEADLESS
 #include "SOIL.h"
+#endif
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "Character.h"
 #include "Pacman.h"
 #include "Ghost.h"
@@ -23,73 +24,66 @@
 #include "BoardManager.h"
 #include "CharacterManager.h"
 
-#include <queue>
 #include "EventManager.h"
 
 #include "StatsManager.h"
 
-#define CHARACTERS_SPRITESHEET "Assets\\Images\\CharactersSpritesheet.png"
+#include "ZobristHash.h"
 
-CharacterManager* CharacterManager::_instance = nullptr;
+#include "GameWorld.h"
 
-CharacterManager::CharacterManager() :
-    mCharactersSpritesheetID(0),
-    mGhosts(new Ghosts())
-{
-}
+#define CHARACTERS_SPRITESHEET "Assets\\Images\\CharactersSpritesheet.png"
 
-//-----------------------------------------------------------------------------------------
+#define PHASE_TIMER_ID GameUtil::CharacterID::PACMAN            // pacman has no timer of his own, so the phase timer takes his ID
 
-CharacterManager* CharacterManager::Instance()
-{
-    if(_instance == nullptr)
-    {
-        _instance = new CharacterManager();
-    }
-    
-    return _instance;
-}
+static_assert(NUM_STATE_CHARACTERS <= NUM_OWNER_TIMERS, "the world must have room for every character's timer");
 
-//-----------------------------------------------------------------------------------------
-
-const CharacterManager* CharacterManager::ConstInstance()
+CharacterManager::CharacterManager(const GameWorld* world) :
+    mWorld(world),
+    mCharactersSpritesheetID(0),
+    mGhosts(new Ghosts()),
+    mGhostTimerPhase(GhostTimerPhase::SCATTER_1),
+    mPhaseTimer(0),
+    mPhaseTimerStart(0),
+    mIsPaused(true),
+    mIsPhaseTimerRunning(false)
 {
-    // returning a const-safe instance of the CharacterManagr
-    //      this way, the caller can't do anything it shouldn't to the manager
-    if(_instance == nullptr)
-    {
-        _instance = new CharacterManager();
-    }
-
-    return _instance;
 }
 
 //-----------------------------------------------------------------------------------------
 
 void CharacterManager::init()
 {
+#ifndef PACSIM_HEADLESS
     mCharactersSpritesheetID = SOIL_load_OGL_texture(CHARACTERS_SPRITESHEET, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID,
         SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
     assert(mCharactersSpritesheetID > 0);
+#endif
+
+    const BoardManager* bmInstance = mWorld->getConstBoardManager();
 
     // create pacman object
-    mPacman = new Pacman(BoardManager::ConstInstace()->getCharacterSpawnTile(GameUtil::CharacterID::PACMAN), GameUtil::CharacterID::PACMAN);
+    mPacman = new Pacman(mWorld, bmInstance->getCharacterSpawnTile(GameUtil::CharacterID::PACMAN), GameUtil::CharacterID::PACMAN);
 
     // create ghost objects
-    mGhosts->insert(IDGhostPair(GameUtil::CharacterID::GHOST_RED,                                               // key for character manager map
-        new GhostRed(BoardManager::ConstInstace()->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_RED),     // getting spawn point for this ghost
-            GameUtil::CharacterID::GHOST_RED)));                                                                // giving ghost its character ID
+    mGhosts->insert(IDGhostPair(GameUtil::CharacterID::GHOST_RED,                         // key for character manager map
+        new GhostRed(mWorld,                                                                // world the ghost lives in
+            bmInstance->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_RED),            // getting spawn point for this ghost
+            GameUtil::CharacterID::GHOST_RED)));                                            // giving ghost its character ID
 
     mGhosts->insert(IDGhostPair(GameUtil::CharacterID::GHOST_PINK,
-        new GhostPink(BoardManager::ConstInstace()->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_PINK),
+        new GhostPink(mWorld,
+            bmInstance->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_PINK),
             GameUtil::CharacterID::GHOST_PINK)));
 
     mGhosts->insert(IDGhostPair(GameUtil::CharacterID::GHOST_BLUE,
-        new GhostBlue(BoardManager::ConstInstace()->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_BLUE),
+        new GhostBlue(mWorld,
+            bmInstance->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_BLUE),
             GameUtil::CharacterID::GHOST_BLUE)));
 
     mGhosts->insert(IDGhostPair(GameUtil::CharacterID::GHOST_ORANGE,
-        new GhostOrange(BoardManager::ConstInstace()->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_ORANGE),
+        new GhostOrange(mWorld,
+            bmInstance->getCharacterSpawnTile(GameUtil::CharacterID::GHOST_ORANGE),
             GameUtil::CharacterID::GHOST_ORANGE)));
 }
 
@@ -97,13 +91,13 @@ void CharacterManager::init()
 
 void CharacterManager::reset()
 {
-    mIsPaused = true;
+    setPaused(true);
 
     // reset ghost timer variables
-    mGhostTimerPhase = GhostTimerPhase::SCATTER_1;
+    setGhostTimerPhase(GhostTimerPhase::SCATTER_1);
 
-    const StatsManager* smInstance = StatsManager::ConstInstace();
-    mPhaseTimer = smInstance->getGhostPhaseTime(GhostTimerPhase::SCATTER_1);
+    const StatsManager* smInstance = mWorld->getConstStatsManager();
+    setPhaseTimer(smInstance->getGhostPhaseTime(GhostTimerPhase::SCATTER_1), mWorld->getTick());
     mScatterTheshold_2 = smInstance->getGhostPhaseTime(GhostTimerPhase::SCATTER_2);
     mScatterTheshold_3 = smInstance->getGhostPhaseTime(GhostTimerPhase::SCATTER_3);
     mScatterTheshold_4 = smInstance->getGhostPhaseTime(GhostTimerPhase::SCATTER_4);
@@ -117,13 +111,16 @@ void CharacterManager::reset()
     {
         iter->second->reset();
     }
+
+    // the speeds are for this level from the start, rather than left from the last until the first update
+    updateCharacterSpeed();
 }
 
 //-----------------------------------------------------------------------------------------
 
 void CharacterManager::resetFromDeath()
 {
-    mIsPaused = true;
+    setPaused(true);
 
     // reset each character to restart the same level
     mPacman->resetFromDeath();
@@ -135,17 +132,115 @@ void CharacterManager::resetFromDeath()
 
 //-----------------------------------------------------------------------------------------
 
+void CharacterManager::saveState(CharacterManagerState* state) const
+{
+    state->ghostTimerPhase = mGhostTimerPhase;
+    state->phaseTimer = mPhaseTimer;
+    state->phaseTimerStart = mPhaseTimerStart;
+    state->scatterThreshold_2 = mScatterTheshold_2;
+    state->scatterThreshold_3 = mScatterTheshold_3;
+    state->scatterThreshold_4 = mScatterTheshold_4;
+    state->chaseThreshold_1 = mChaseThreshold_1;
+    state->chaseThreshold_2 = mChaseThreshold_2;
+    state->chaseThreshold_3 = mChaseThreshold_3;
+    state->isPaused = mIsPaused;
+
+    // characters are stored by ID
+    mPacman->saveState(&state->characters[GameUtil::CharacterID::PACMAN]);
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        iter->second->saveState(&state->characters[iter->first]);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::loadState(const CharacterManagerState* state)
+{
+    mGhostTimerPhase = (GhostTimerPhase)state->ghostTimerPhase;
+    mPhaseTimer = state->phaseTimer;
+    mPhaseTimerStart = state->phaseTimerStart;
+    mScatterTheshold_2 = state->scatterThreshold_2;
+    mScatterTheshold_3 = state->scatterThreshold_3;
+    mScatterTheshold_4 = state->scatterThreshold_4;
+    mChaseThreshold_1 = state->chaseThreshold_1;
+    mChaseThreshold_2 = state->chaseThreshold_2;
+    mChaseThreshold_3 = state->chaseThreshold_3;
+    mIsPaused = state->isPaused;
+
+    mPacman->loadState(&state->characters[GameUtil::CharacterID::PACMAN]);
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        iter->second->loadState(&state->characters[iter->first]);
+    }
+
+    // the world's timers are cleared as a state is loaded
+    mIsPhaseTimerRunning = isPhaseTimerRunning();
+    setPhaseTimerDue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::loadLevelState(const CharacterManagerState* state)
+{
+    GameUtil::BoardDirection inputDirection = dynamic_cast<Pacman*>(mPacman)->getInputDirection();
+
+    loadState(state);
+    setPacmanInput(inputDirection);
+
+    // the animations start from the current game time, not the one the state was kept at
+    mPacman->restartAnimation();
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        iter->second->restartAnimation();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
 void CharacterManager::updateCharacters(DWORD milliseconds)
 {
-    updateCharacterTimers(milliseconds);        // updates timers (mostly for ghosts)
+    updateCharacterTimers(milliseconds);        // updates timers (the ghosts' run on the world's TimerWheel)
     updateCharacterMovement(milliseconds);      // updates movement related things -- position and tile pointers
-    updateCharacterAnimation(milliseconds);     // updates character animations
     updateCharacterSpeed();                     // updates character speed values
     updateCharacterCollision();                 // detects collisions between pacman and ghosts
 }
 
 //-----------------------------------------------------------------------------------------
 
+const uint32_t CharacterManager::getNumQuietTicks(DWORD tickTime) const
+{
+    uint32_t numTicks = mPacman->getNumQuietTicks(tickTime);
+
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        // tiles don't change while quiet, so a collision would happen on every update
+        if(mPacman->getCurrentTile() == iter->second->getCurrentTile())
+        {
+            return 0;
+        }
+
+        uint32_t numCharacterTicks = iter->second->getNumQuietTicks(tickTime);
+        if(numCharacterTicks < numTicks) numTicks = numCharacterTicks;
+    }
+
+    return numTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::skipQuietTicks(DWORD tickTime, uint32_t numTicks)
+{
+    mPacman->skipQuietTicks(tickTime, numTicks);
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        iter->second->skipQuietTicks(tickTime, numTicks);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
 void CharacterManager::drawCharacters()
 {
     glEnable(GL_TEXTURE_2D);
@@ -161,6 +256,7 @@ void CharacterManager::drawCharacters()
 
     glEnd();
 }
+#endif
 
 //-----------------------------------------------------------------------------------------
 
@@ -180,76 +276,42 @@ void CharacterManager::shutdown()
 
 //-----------------------------------------------------------------------------------------
 
-void CharacterManager::updateCharacterTimers(DWORD milliseconds)
+void CharacterManager::handleTimer(const int32_t id)
 {
-    mPacman->updateTimers(milliseconds);
-    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    if(id == PHASE_TIMER_ID)
     {
-        iter->second->updateTimers(milliseconds);
+        handlePhaseTimer();
     }
-
-    // if not paused and ghosts not scared, update the ghost phase timer
-    if(!mIsPaused && !areGhostsScared())
+    else
     {
-        if(mPhaseTimer > 0)
-        {
-            mPhaseTimer -= milliseconds;
-            switch(mGhostTimerPhase)
-            {
-                // each time we cross a timer threshold, we move to the next targeting phase
-                case GhostTimerPhase::SCATTER_1:
-                    if(mPhaseTimer < mChaseThreshold_1) toggleGhostsTargetingPhase();
-                    break;
-                case GhostTimerPhase::CHASE_1:
-                    if(mPhaseTimer < mScatterTheshold_2) toggleGhostsTargetingPhase();
-                    break;
-                case GhostTimerPhase::SCATTER_2:
-                    if(mPhaseTimer < mChaseThreshold_2) toggleGhostsTargetingPhase();
-                    break;
-                case GhostTimerPhase::CHASE_2:
-                    if(mPhaseTimer < mScatterTheshold_3) toggleGhostsTargetingPhase();
-                    break;
-                case GhostTimerPhase::SCATTER_3:
-                    if(mPhaseTimer < mChaseThreshold_3) toggleGhostsTargetingPhase();
-                    break;
-                case GhostTimerPhase::CHASE_3:
-                    if(mPhaseTimer < mScatterTheshold_4) toggleGhostsTargetingPhase();
-                    break;
-                default:
-                    break;
-            }
-        }
-        else
-        {
-            // enters final state (CHASE_4) indefinitely
-            if(mGhostTimerPhase == GhostTimerPhase::SCATTER_4)
-            {
-                toggleGhostsTargetingPhase();
-                mPhaseTimer = 0;
-            }
-        }
+        mGhosts->at((GameUtil::CharacterID)id)->handleScaredTimer();
+
+        // the phase timer runs again once the last ghost is unscared, from this very update
+        updatePhaseTimer(true);
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void CharacterManager::updateCharacterMovement(DWORD milliseconds)
+void CharacterManager::updateCharacterTimers(DWORD milliseconds)
 {
-    mPacman->updateMovement(milliseconds);
+    mPacman->updateTimers(milliseconds);
     for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
     {
-        iter->second->updateMovement(milliseconds);
+        iter->second->updateTimers(milliseconds);
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void CharacterManager::updateCharacterAnimation(DWORD milliseconds)
+void CharacterManager::updateCharacterMovement(DWORD milliseconds)
 {
-    mPacman->updateAnimation(milliseconds);
+    mPacman->saveLastPosition();
+    mPacman->updateMovement(milliseconds);
     for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
     {
-        iter->second->updateAnimation(milliseconds);
+        iter->second->saveLastPosition();
+        iter->second->updateMovement(milliseconds);
     }
 }
 
@@ -283,7 +345,7 @@ void CharacterManager::updateCharacterCollision()
                 default:
                     if(isCharacterAlive(GameUtil::CharacterID::PACMAN))
                     {
-                        EventManager::ConstInstace()->postEvent(EventManager::GameEvent::LEVEL_LOSE);
+                        mWorld->getConstEventManager()->postEvent(EventManager::GameEvent::LEVEL_LOSE);
                         mPacman->setLiving(false);
                     }
                     break;
@@ -296,7 +358,7 @@ void CharacterManager::updateCharacterCollision()
 
 void CharacterManager::pauseCharacters()
 {
-    mIsPaused = true;
+    setPaused(true);
 
     mPacman->pause();
     for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
@@ -309,7 +371,7 @@ void CharacterManager::pauseCharacters()
 
 void CharacterManager::unpauseCharacters()
 {
-    mIsPaused = false;
+    setPaused(false);
 
     mPacman->unpause();
     for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
@@ -344,7 +406,7 @@ void CharacterManager::makeGhostsInvisible() const
 void CharacterManager::toggleGhostsTargetingPhase()
 {
     // enter the next targeting phase
-    mGhostTimerPhase = (GhostTimerPhase)(mGhostTimerPhase + 1);
+    setGhostTimerPhase((GhostTimerPhase)(mGhostTimerPhase + 1));
     for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
     {
         // flag for reverse, then set scatter or chase based on the current phase
@@ -374,6 +436,13 @@ void CharacterManager::playPacmanDeathAnimation() const
 
 //-----------------------------------------------------------------------------------------
 
+void CharacterManager::setPacmanInput(GameUtil::BoardDirection direction)
+{
+    dynamic_cast<Pacman*>(mPacman)->setInputDirection(direction);
+}
+
+//-----------------------------------------------------------------------------------------
+
 void CharacterManager::spawnGhost(GameUtil::CharacterID ghostID) const
 {
     if(ghostID != GameUtil::CharacterID::PACMAN)
@@ -387,8 +456,8 @@ void CharacterManager::spawnGhost(GameUtil::CharacterID ghostID) const
 void CharacterManager::killGhost(Ghost* ghost)
 {
     // post event that a ghost has been killed
-    const EventManager* emManager = EventManager::ConstInstace();
-    emManager->postEvent(EventManager::GameEvent::GHOST_KILLED);
+    const EventManager* emManager = mWorld->getConstEventManager();
+    emManager->postEvent(EventManager::GameEvent::GHOST_KILLED, ghost->getCharacterID());
     emManager->postSoundEvent(EventManager::SoundEvent::SOUND_GHOST_DEATH);
 
     // pause characters, then kill and unpause given ghost
@@ -400,13 +469,16 @@ void CharacterManager::killGhost(Ghost* ghost)
 
 //-----------------------------------------------------------------------------------------
 
-void CharacterManager::scareGhosts() const
+void CharacterManager::scareGhosts()
 {
     // scare ghosts (only sets value if ghost is outside ghost home)
     for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
     {
         iter->second->scare();
     }
+
+    // scared ghosts hold the phase timer
+    updatePhaseTimer(false);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -482,9 +554,9 @@ const bool8_t CharacterManager::isCharacterAlive(GameUtil::CharacterID character
 
 //-----------------------------------------------------------------------------------------
 
-const Tile* CharacterManager::getCharacterCurrentTile(GameUtil::CharacterID character) const
+const TileIndex CharacterManager::getCharacterCurrentTile(GameUtil::CharacterID character) const
 {
-    const Tile* tile = nullptr;
+    TileIndex tile = TILE_INVAL;
     if(character == GameUtil::CharacterID::PACMAN)
     {
         tile = mPacman->getCurrentTile();
@@ -530,3 +602,176 @@ const Character::MovementState CharacterManager::getCharacterMovementState(GameU
 
     return movementState;
 }
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t CharacterManager::getNumTargetEvaluations() const
+{
+    uint32_t result = 0;
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        result += iter->second->getNumTargetEvaluations();
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t CharacterManager::getNumSkippedTargetEvaluations() const
+{
+    uint32_t result = 0;
+    for(auto iter = mGhosts->begin(); iter != mGhosts->end(); ++iter)
+    {
+        result += iter->second->getNumSkippedTargetEvaluations();
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::handlePhaseTimer()
+{
+    // the timer counts down on every update that starts above 0, this one included
+    uint32_t phaseTimer = getPhaseTimer(mWorld->getTick() - 1);
+    if(phaseTimer > 0)
+    {
+        setPhaseTimer(phaseTimer - SIM_TICK_TIME, mWorld->getTick());
+
+        // each time we cross a timer threshold, we move to the next targeting phase
+        uint32_t threshold = getPhaseThreshold();
+        if(threshold > 0 && mPhaseTimer < threshold)
+        {
+            toggleGhostsTargetingPhase();
+        }
+    }
+    else
+    {
+        // enters final state (CHASE_4) indefinitely
+        if(mGhostTimerPhase == GhostTimerPhase::SCATTER_4)
+        {
+            toggleGhostsTargetingPhase();
+            setPhaseTimer(0, mWorld->getTick());
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::updatePhaseTimer(const bool8_t isBeforeUpdate)
+{
+    bool8_t isRunning = isPhaseTimerRunning();
+    if(isRunning == mIsPhaseTimerRunning)
+    {
+        return;
+    }
+
+    // the timer stops or starts where it is as of the last update it counted down on
+    uint32_t tick = mWorld->getTick() - (isBeforeUpdate ? 1 : 0);
+    uint32_t phaseTimer = getPhaseTimer(tick);
+    mIsPhaseTimerRunning = isRunning;
+    setPhaseTimer(phaseTimer, tick);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t CharacterManager::isPhaseTimerRunning() const
+{
+    return !mIsPaused && !areGhostsScared();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t CharacterManager::getPhaseThreshold() const
+{
+    // the last phases have no threshold, the timer just runs out
+    switch(mGhostTimerPhase)
+    {
+        case GhostTimerPhase::SCATTER_1:    return mChaseThreshold_1;
+        case GhostTimerPhase::CHASE_1:      return mScatterTheshold_2;
+        case GhostTimerPhase::SCATTER_2:    return mChaseThreshold_2;
+        case GhostTimerPhase::CHASE_2:      return mScatterTheshold_3;
+        case GhostTimerPhase::SCATTER_3:    return mChaseThreshold_3;
+        case GhostTimerPhase::CHASE_3:      return mScatterTheshold_4;
+        default:                            return 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t CharacterManager::getPhaseTimer(const uint32_t tick) const
+{
+    if(!mIsPhaseTimerRunning)
+    {
+        return mPhaseTimer;
+    }
+
+    return GameUtil::Utilities::countDown(mPhaseTimer, SIM_TICK_TIME, tick - mPhaseTimerStart);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::setPhaseTimerDue()
+{
+    // due on the update that crosses the current phase's threshold, or on the one after the last phase runs out
+    uint32_t numTicks = TICKS_UNLIMITED;
+    if(mIsPhaseTimerRunning)
+    {
+        uint32_t threshold = getPhaseThreshold();
+        if(mPhaseTimer > 0 && threshold > 0)
+        {
+            numTicks = GameUtil::Utilities::getNumStepsToCross(mPhaseTimer, threshold, SIM_TICK_TIME);
+        }
+        else if(mGhostTimerPhase == GhostTimerPhase::SCATTER_4)
+        {
+            numTicks = mPhaseTimer > 0 ? GameUtil::Utilities::getNumStepsToRunOut(mPhaseTimer, SIM_TICK_TIME) : 1;
+        }
+    }
+
+    // a timer started by a ghost's timer can be due on the update that's being made, see handleTimer
+    uint32_t tick = numTicks != TICKS_UNLIMITED ? mPhaseTimerStart + numTicks : 0;
+    if(tick != 0 && tick <= mWorld->getTick())
+    {
+        mWorld->setTimer(GameWorld::TimerOwner::CHARACTER_MANAGER, PHASE_TIMER_ID, 0);
+        handlePhaseTimer();
+        return;
+    }
+
+    mWorld->setTimer(GameWorld::TimerOwner::CHARACTER_MANAGER, PHASE_TIMER_ID, tick);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::setGhostTimerPhase(const GhostTimerPhase phase)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_TIMER_PHASE), mGhostTimerPhase, phase);
+    mGhostTimerPhase = phase;
+
+    setPhaseTimerDue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::setPhaseTimer(const uint32_t time, const uint32_t tick)
+{
+    // a running timer counts down from 'tick', a stopped one is kept as of tick 0
+    uint32_t start = mIsPhaseTimerRunning ? tick : 0;
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_PHASE_TIMER), mPhaseTimer, time);
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_PHASE_TIMER_START), mPhaseTimerStart, start);
+    mPhaseTimer = time;
+    mPhaseTimerStart = start;
+
+    setPhaseTimerDue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void CharacterManager::setPaused(const bool8_t isPaused)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CHARACTERS_PAUSED), mIsPaused, isPaused);
+    mIsPaused = isPaused;
+
+    // paused characters hold the phase timer
+    updatePhaseTimer(false);
+}
@@ -1,4 +1,7 @@
 
+class GameWorld;
+struct CharacterManagerState;
+
 /*
  * Manages all objects that inherit from Character.
  *
@@ -6,14 +9,15 @@
  * managers may call upon Character objects.
  *
  * Though the CharacterManager also manages the timer
- * that drives the ghosts' current targeting phase.
+ * that drives the ghosts' current targeting phase. Like
+ * the ghosts' scared timers, it's set on the GameWorld's
+ * TimerWheel to go off only on the update it changes phase.
  */
 class CharacterManager
 {
 public:
 
-    static CharacterManager* Instance();
-    static const CharacterManager* ConstInstance();
+    CharacterManager(const GameWorld* world);
 
     /*
      * Creates the character objects, and maps 
@@ -32,11 +36,49 @@ public:
      */
     void resetFromDeath();
 
+    /*
+     * Copies the ghost targeting phase timer, and the state of
+     * each character, out to 'state', or back in from it.
+     */
+    void saveState(CharacterManagerState* state) const;
+    void loadState(const CharacterManagerState* state);
+
+    /*
+     * Loads a level's start state from 'state', keeping pacman's
+     * input, which a reset leaves alone, and restarting each
+     * character's animation as a reset would. See
+     * GameWorld::startLevel().
+     */
+    void loadLevelState(const CharacterManagerState* state);
+
     /*
      * Calls several helper functions to update each character.
      */
     void updateCharacters(DWORD milliseconds);
 
+    /*
+     * Handles the timer 'id' going off, called by the world: the
+     * phase timer changing phase, or a ghost's scared timer
+     * flashing or unscaring it. The phase timer is under pacman's
+     * ID, as he has no timer of his own.
+     */
+    void handleTimer(const int32_t id);
+
+    /*
+     * Returns the number of updates of 'tickTime' ms, from now,
+     * over which characters only move straight on and timers only
+     * count down: no character reaches a tile or chooses where to
+     * go, and no ghost shares pacman's tile. The phase and scared
+     * timers are left to the world's TimerWheel.
+     */
+    const uint32_t getNumQuietTicks(DWORD tickTime) const;
+
+    /*
+     * Makes 'numTicks' updates of 'tickTime' ms at once. Only for
+     * updates covered by getNumQuietTicks.
+     */
+    void skipQuietTicks(DWORD tickTime, uint32_t numTicks);
+
     /*
      * Calls 'draw' for each character.
      */
@@ -72,6 +114,11 @@ public:
      */
     void playPacmanDeathAnimation() const;
 
+    /*
+     * Passes the player's held direction on to pacman.
+     */
+    void setPacmanInput(GameUtil::BoardDirection direction);
+
     /*
      * Spawns the ghost given by 'ghostID'. This
      * is ignored if the ghost is already alive.
@@ -82,7 +129,7 @@ public:
      * Calls 'scare' on all ghosts. This is ignored by ghosts 
      * who are currently dead and outside the ghost home.
      */
-    void scareGhosts() const;
+    void scareGhosts();
 
     /*
      * Returns true if any ghost is in the scared state.
@@ -112,7 +159,7 @@ public:
     /*
      * Returns a const pointer to the current tile of the given 'character'.
      */
-    const Tile* getCharacterCurrentTile(GameUtil::CharacterID character) const;
+    const TileIndex getCharacterCurrentTile(GameUtil::CharacterID character) const;
 
     /*
      * Returns the facing direction of the given 'character'.
@@ -124,6 +171,13 @@ public:
      */
     const Character::MovementState getCharacterMovementState(GameUtil::CharacterID character) const;
 
+    /*
+     * Returns the number of target tile evaluations made, and
+     * skipped, by all ghosts.
+     */
+    const uint32_t getNumTargetEvaluations() const;
+    const uint32_t getNumSkippedTargetEvaluations() const;
+
 private:
 
     /*
@@ -141,13 +195,8 @@ private:
         CHASE_4
     }GhostTimerPhase;
 
-    CharacterManager();
-
     /*
      * Calls on the update for each character's timers.
-     *
-     * Also updates the timer that controls the ghosts'
-     * targeting phase.
      */
     void updateCharacterTimers(DWORD milliseconds);
 
@@ -156,11 +205,6 @@ private:
      */
     void updateCharacterMovement(DWORD milliseconds);
 
-    /*
-     * Calls on the update for each character's animation.
-     */
-    void updateCharacterAnimation(DWORD milliseconds);
-
     /*
      * Calls on the update for each character's speed.
      */
@@ -188,7 +232,57 @@ private:
      */
     void toggleGhostsTargetingPhase();
 
-    static CharacterManager* _instance;
+    /*
+     * Makes the phase timer's update that's due: counts it down
+     * from where it was before this update, then changes phase
+     * if it crossed the current phase's threshold, or if the
+     * last scatter phase ran out.
+     */
+    void handlePhaseTimer();
+
+    /*
+     * Stops or starts the phase timer where it is, if whether it
+     * runs has changed. 'isBeforeUpdate' is true if this update's
+     * count down is still to come, as when a ghost's timer
+     * unscares the last scared ghost.
+     */
+    void updatePhaseTimer(const bool8_t isBeforeUpdate);
+
+    /*
+     * Returns true if the phase timer counts down: the characters
+     * aren't paused and no ghost is scared.
+     */
+    const bool8_t isPhaseTimerRunning() const;
+
+    /*
+     * Returns the threshold that ends the current phase, or 0 for
+     * the last phases, which have none.
+     */
+    const uint32_t getPhaseThreshold() const;
+
+    /*
+     * Returns the phase timer as of 'tick' of the world's clock.
+     */
+    const uint32_t getPhaseTimer(const uint32_t tick) const;
+
+    /*
+     * Sets the phase timer on the world's TimerWheel for the
+     * update that next changes phase, if any. One that's due on
+     * the update being made is handled now.
+     */
+    void setPhaseTimerDue();
+
+    /*
+     * Setters for the ghost timer phase, its timer as of 'tick'
+     * of the world's clock, and for whether the characters are
+     * paused, which keep the world's Zobrist hash up to date and
+     * the phase timer set.
+     */
+    void setGhostTimerPhase(const GhostTimerPhase phase);
+    void setPhaseTimer(const uint32_t time, const uint32_t tick);
+    void setPaused(const bool8_t isPaused);
+
+    const GameWorld* mWorld;
 
     Character* mPacman;                                             // pacman character pointer
 
@@ -201,6 +295,7 @@ private:
     GhostTimerPhase mGhostTimerPhase;       // current timer phase, keeps us from spamming phase changes and spazzing out the ghosts
 
     uint32_t mPhaseTimer;
+    uint32_t mPhaseTimerStart;              // tick of the world's clock the phase timer is kept as of
     uint32_t mScatterTheshold_2;            // targeting phase timings
     uint32_t mScatterTheshold_3;
     uint32_t mScatterTheshold_4;
@@ -209,4 +304,5 @@ private:
     uint32_t mChaseThreshold_3;
 
     bool8_t mIsPaused;
+    bool8_t mIsPhaseTimerRunning;           // whether the phase timer ran as of its last update, not kept in states
 };
@@ -2,24 +2,19 @@
 #define EVENT_MANAGER_CPP
 
 #include <assert.h>
-#include <windows.h>											// Header File For Windows
+#include "../Framework/platform.h"
 #include <stdio.h>												// Header File For Standard Input / Output
 #include <stdarg.h>												// Header File For Variable Argument Routines
 #include <math.h>												// Header File For Math Operations
-#include <gl\gl.h>												// Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
-#include "glut.h"
-#include "..\\Framework\\baseTypes.h"
-#include "..\\Framework\\openglframework.h"	
-#include "..\\Framework\\gamedefs.h"
-#include "..\\Framework\\stateManager.h"
-
-#include <queue>
+#include "../Framework/baseTypes.h"
+#include "../Framework/gamedefs.h"
+
 #include "EventManager.h"
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "Character.h"
 #include "Pacman.h"
 #include "Ghost.h"
@@ -30,13 +25,20 @@
 #include "BoardManager.h"
 #include "CharacterManager.h"
 
+#include "TimerWheel.h"
 #include "TimerManager.h"
 
 #include "FruitManager.h"
 
+#ifndef PACSIM_HEADLESS
+#include <string>
 #include "UIManager.h"
+#endif
 
 #include "StatsManager.h"
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
 
 
 // audio filepaths
@@ -47,39 +49,103 @@
 #define PACMAN_DEATH        "Assets\\Audio\\pacman_death.wav"
 #define GHOST_DEATH         "Assets\\Audio\\pacman_eatghost.wav"
 
+static_assert((EVENT_QUEUE_CAPACITY & (EVENT_QUEUE_CAPACITY - 1)) == 0, "event queue capacity must be a power of two");
+static_assert(EVENT_QUEUE_CAPACITY <= MAX_STATE_EVENTS, "a full event queue must fit in a snapshot");
+
+template<typename T>
+EventManager::EventRing<T>::EventRing() :
+    head(0),
+    size(0),
+    numPosted(0),
+    peakSize(0),
+    numDropped(0),
+    numCollapsed(0)
+{
+}
 
-EventManager* EventManager::_instance = nullptr;
+//-----------------------------------------------------------------------------------------
 
-EventManager::EventManager() :
-    mEventQueue(new EventQueue()),
-    mSoundQueue(new SoundQueue())
+template<typename T>
+void EventManager::EventRing<T>::clear()
 {
-    // managers should only call on other managers for const getter functions
-    // they should post events for things that would alter other managers
+    head = 0;
+    size = 0;
 }
 
 //-----------------------------------------------------------------------------------------
 
-EventManager* EventManager::Instance()
+template<typename T>
+void EventManager::EventRing<T>::push(const T& event)
 {
-    if(_instance == nullptr)
+    numPosted++;
+    if(size == EVENT_QUEUE_CAPACITY)
     {
-        _instance = new EventManager();
+        numDropped++;
+        return;
     }
 
-    return _instance;
+    events[(head + size) & (EVENT_QUEUE_CAPACITY - 1)] = event;
+    size++;
+    if(size > peakSize)
+    {
+        peakSize = size;
+    }
 }
 
 //-----------------------------------------------------------------------------------------
 
-const EventManager* EventManager::ConstInstace()
+template<typename T>
+bool8_t EventManager::EventRing<T>::pop(T& event)
 {
-    if(_instance == nullptr)
+    if(size == 0)
+    {
+        return false;
+    }
+
+    event = events[head];
+    head = (head + 1) & (EVENT_QUEUE_CAPACITY - 1);
+    size--;
+
+    // a queue that empties starts again from the first slot, so the slots
+    // events are queued in don't depend on how many came before
+    if(size == 0)
     {
-        _instance = new EventManager();
+        head = 0;
     }
 
-    return _instance;
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+template<typename T>
+T* EventManager::EventRing<T>::back()
+{
+    return size > 0 ? &events[(head + size - 1) & (EVENT_QUEUE_CAPACITY - 1)] : nullptr;
+}
+
+//-----------------------------------------------------------------------------------------
+
+template<typename T>
+const T& EventManager::EventRing<T>::at(const uint32_t i) const
+{
+    assert(i < size);
+    return events[(head + i) & (EVENT_QUEUE_CAPACITY - 1)];
+}
+
+//-----------------------------------------------------------------------------------------
+
+
+EventManager::EventManager(GameWorld* world) :
+    mWorld(world),
+    mEventQueue(new EventQueue()),
+    mSoundQueue(new SoundQueue()),
+    mFrameSound(SoundEvent::SOUND_INVAL),
+    mIsScoreChanged(false),
+    mNumCollapsedSounds(0)
+{
+    // managers should only call on other managers for const getter functions
+    // they should post events for things that would alter other managers
 }
 
 //-----------------------------------------------------------------------------------------
@@ -92,15 +158,63 @@ void EventManager::init()
 
 void EventManager::reset()
 {
-    // clear event queues of contents
-    while(!mEventQueue->empty())
+    // take the queued game events out of the hash, then clear event queues of contents
+    for(uint32_t i = 0; i < mEventQueue->size; ++i)
+    {
+        const Event& event = mEventQueue->at(i);
+        updateGameEventHash((mEventQueue->head + i) & (EVENT_QUEUE_CAPACITY - 1),
+            ZobristHash::getEventValue(event.type, event.data), 0);
+    }
+
+    mEventQueue->clear();
+    mSoundQueue->clear();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void EventManager::saveState(EventState* state) const
+{
+    state->gameEventHead = (int32_t)mEventQueue->head;
+    state->numGameEvents = (int32_t)mEventQueue->size;
+    for(int32_t i = 0; i < state->numGameEvents; ++i)
+    {
+        const Event& event = mEventQueue->at(i);
+        state->gameEvents[i] = event.type;
+        state->gameEventData[i] = event.data;
+    }
+
+    state->numSoundEvents = (int32_t)mSoundQueue->size;
+    for(int32_t i = 0; i < state->numSoundEvents; ++i)
+    {
+        state->soundEvents[i] = mSoundQueue->at(i);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void EventManager::loadState(const EventState* state)
+{
+    // the queues are cleared rather than reset, since the hash comes with the state
+    mEventQueue->clear();
+    mSoundQueue->clear();
+
+    // written in place rather than pushed, so loading doesn't count as posting
+    //      game events go back in the same slots, which the Zobrist hash is keyed on
+    assert(state->numGameEvents <= EVENT_QUEUE_CAPACITY && state->numSoundEvents <= EVENT_QUEUE_CAPACITY);
+    mEventQueue->head = (uint32_t)state->gameEventHead & (EVENT_QUEUE_CAPACITY - 1);
+    for(int32_t i = 0; i < state->numGameEvents; ++i)
     {
-        mEventQueue->pop();
+        Event& event = mEventQueue->events[(mEventQueue->head + i) & (EVENT_QUEUE_CAPACITY - 1)];
+        event.type = (GameEvent)state->gameEvents[i];
+        event.data = state->gameEventData[i];
     }
-    while(!mSoundQueue->empty())
+    mEventQueue->size = state->numGameEvents;
+
+    for(int32_t i = 0; i < state->numSoundEvents; ++i)
     {
-        mSoundQueue->pop();
+        mSoundQueue->events[i] = (SoundEvent)state->soundEvents[i];
     }
+    mSoundQueue->size = state->numSoundEvents;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -113,149 +227,183 @@ void EventManager::update()
 
 //-----------------------------------------------------------------------------------------
 
+void EventManager::endFrame()
+{
+    // headless builds have no score strings or audio
+#ifndef PACSIM_HEADLESS
+    if(mIsScoreChanged)
+    {
+        UIManager::Instance()->updateScoreStrings();
+    }
+
+    // each sound cuts off the one before, so only the last of the frame would be heard anyway
+    switch(mFrameSound)
+    {
+        case EventManager::SoundEvent::SOUND_START:
+            PlaySound(START_MUSIC, NULL, SND_FILENAME | SND_ASYNC);
+            break;
+        case EventManager::SoundEvent::SOUND_EXTRA_LIFE:
+            PlaySound(EXTRA_LIFE_SOUND, NULL, SND_FILENAME | SND_ASYNC);
+            break;
+        case EventManager::SoundEvent::SOUND_PELLET:
+            PlaySound(PELLET_SOUND, NULL, SND_FILENAME | SND_ASYNC);
+            break;
+        case EventManager::SoundEvent::SOUND_FRUIT:
+            PlaySound(FRUIT_SOUND, NULL, SND_FILENAME | SND_ASYNC);
+            break;
+        case EventManager::SoundEvent::SOUND_PACMAN_DEATH:
+            PlaySound(PACMAN_DEATH, NULL, SND_FILENAME | SND_ASYNC);
+            break;
+        case EventManager::SoundEvent::SOUND_GHOST_DEATH:
+            PlaySound(GHOST_DEATH, NULL, SND_FILENAME | SND_ASYNC);
+            break;
+        default:
+            break;
+    }
+#endif
+
+    mIsScoreChanged = false;
+    mFrameSound = SoundEvent::SOUND_INVAL;
+}
+
+//-----------------------------------------------------------------------------------------
+
 void EventManager::handleGameEventQueue()
 {
     // as long as there are events in the queue, pop them out and handle them
-    EventManager::GameEvent eventType;
-    while(!mEventQueue->empty())
+    Event event;
+    while(popGameEvent(event))
     {
-        eventType = mEventQueue->front();
-        mEventQueue->pop();
-
         // call handler funcitons on other managers based on the event type
-        switch(eventType)
+        switch(event.type)
         {
             // game flow -- resetting
             case EventManager::GameEvent::START_FROM_MENU:
-                StateManagerC::GetInstance()->setApplicationState(StateManagerC::ApplicationState::IN_GAME);
-                StatsManager::Instance()->reset();
+#ifndef PACSIM_HEADLESS
                 UIManager::Instance()->reset();
-                TimerManager::Instance()->reset();
-                BoardManager::Instance()->reset();
-                FruitManager::Instance()->reset();
-                CharacterManager::Instance()->reset();
-                reset();
-                TimerManager::Instance()->activateStartTimerFromMenu();
+#endif
+                mWorld->startLevel(true);       // resets every manager, and clears the queues
                 break;
             case EventManager::GameEvent::START_FROM_GAME_WIN:
-                StatsManager::Instance()->nextLevel();
-                TimerManager::Instance()->reset();
-                BoardManager::Instance()->reset();
-                FruitManager::Instance()->nextLevel();
-                CharacterManager::Instance()->reset();
-                reset();
-                TimerManager::Instance()->activateStartTimerFromWin();
+                mWorld->startLevel(false);
                 break;
             case EventManager::GameEvent::START_FROM_GAME_LOSE:
-                CharacterManager::Instance()->resetFromDeath();
-                FruitManager::Instance()->resetFromDeath();
-                TimerManager::Instance()->reset();
+                mWorld->getCharacterManager()->resetFromDeath();
+                mWorld->getBoardManager()->resetFromDeath();
+                mWorld->getFruitManager()->resetFromDeath();
+                mWorld->getTimerManager()->reset();
                 reset();
-                TimerManager::Instance()->activateStartTimerFromLoss();
+                mWorld->getTimerManager()->activateStartTimerFromLoss();
                 break;
 
             // game flow -- ending game
             case EventManager::GameEvent::LEVEL_WIN:
-                FruitManager::Instance()->pauseFruit();
-                CharacterManager::Instance()->pauseCharacters();
-                TimerManager::Instance()->activateEndGameTimerWin();
+                mWorld->getFruitManager()->pauseFruit();
+                mWorld->getCharacterManager()->pauseCharacters();
+                mWorld->getTimerManager()->activateEndGameTimerWin();
                 break;
             case EventManager::GameEvent::LEVEL_LOSE:
-                FruitManager::Instance()->pauseFruit();
-                CharacterManager::Instance()->pauseCharacters();
-                TimerManager::Instance()->activateEndGameTimerLoss();
+                mWorld->getFruitManager()->pauseFruit();
+                mWorld->getCharacterManager()->pauseCharacters();
+                mWorld->getTimerManager()->activateEndGameTimerLoss();
                 break;
 
             // ui events
             case EventManager::GameEvent::GAME_OVER:
-                StateManagerC::GetInstance()->setApplicationState(StateManagerC::ApplicationState::IN_MENU);
+                mWorld->setApplicationState(GameWorld::ApplicationState::IN_MENU);
+#ifndef PACSIM_HEADLESS
                 UIManager::Instance()->setUIState(GameUtil::UIState::UI_MENU);
+#endif
                 reset();
                 break;
             case EventManager::GameEvent::UI_ENTER_PREGAME_2:
+#ifndef PACSIM_HEADLESS
                 UIManager::Instance()->setUIState(GameUtil::UIState::UI_PREGAME_2);
+#endif
                 break;
             case EventManager::GameEvent::UI_ENTER_GAME:
+#ifndef PACSIM_HEADLESS
                 UIManager::Instance()->setUIState(GameUtil::UIState::UI_GAME);
+#endif
                 break;
 
             // pause or unpause events
             case EventManager::GameEvent::PAUSE:
-                FruitManager::Instance()->pauseFruit();
-                CharacterManager::Instance()->pauseCharacters();
+                mWorld->getFruitManager()->pauseFruit();
+                mWorld->getCharacterManager()->pauseCharacters();
                 break;
             case EventManager::GameEvent::UNPAUSE:
-                FruitManager::Instance()->unpauseFruit();
-                CharacterManager::Instance()->unpauseCharacters();
+                mWorld->getFruitManager()->unpauseFruit();
+                mWorld->getCharacterManager()->unpauseCharacters();
                 break;
 
             // visibility events
             case EventManager::GameEvent::CHARACTERS_VISIBLE:
-                CharacterManager::ConstInstance()->makeCharactersVisible();
+                mWorld->getConstCharacterManager()->makeCharactersVisible();
                 break;
             case EventManager::GameEvent::GHOSTS_INVISIBLE:
-                CharacterManager::ConstInstance()->makeGhostsInvisible();
+                mWorld->getConstCharacterManager()->makeGhostsInvisible();
                 break;
 
             // spawn ghost events
             case EventManager::GameEvent::SPAWN_GHOST_RED:
-                CharacterManager::ConstInstance()->spawnGhost(GameUtil::CharacterID::GHOST_RED);
+                mWorld->getConstCharacterManager()->spawnGhost(GameUtil::CharacterID::GHOST_RED);
                 break;
             case EventManager::GameEvent::SPAWN_GHOST_PINK:
-                CharacterManager::ConstInstance()->spawnGhost(GameUtil::CharacterID::GHOST_PINK);
+                mWorld->getConstCharacterManager()->spawnGhost(GameUtil::CharacterID::GHOST_PINK);
                 break;
             case EventManager::GameEvent::SPAWN_GHOST_BLUE:
-                CharacterManager::ConstInstance()->spawnGhost(GameUtil::CharacterID::GHOST_BLUE);
+                mWorld->getConstCharacterManager()->spawnGhost(GameUtil::CharacterID::GHOST_BLUE);
                 break;
             case EventManager::GameEvent::SPAWN_GHOST_ORANGE:
-                CharacterManager::ConstInstance()->spawnGhost(GameUtil::CharacterID::GHOST_ORANGE);
+                mWorld->getConstCharacterManager()->spawnGhost(GameUtil::CharacterID::GHOST_ORANGE);
                 break;
 
             // ghost events
             case EventManager::GameEvent::SCARE_GHOSTS:
-                CharacterManager::ConstInstance()->scareGhosts();
+                mWorld->getCharacterManager()->scareGhosts();
                 break;
             case EventManager::GameEvent::CRUISE_ELROY:
-                CharacterManager::ConstInstance()->activateCruiseElroy();
+                mWorld->getConstCharacterManager()->activateCruiseElroy();
                 break;
             case EventManager::GameEvent::GHOST_KILLED:
-                TimerManager::Instance()->activateDeadGhostTimer();
-                StatsManager::Instance()->ghostKilled();
-                UIManager::Instance()->updateScoreStrings();
+                mWorld->getTimerManager()->activateDeadGhostTimer();
+                mWorld->getStatsManager()->ghostKilled();
+                mIsScoreChanged = true;
                 break;
 
             // fruit events
             case EventManager::GameEvent::ACTIVATE_FRUIT:
-                FruitManager::Instance()->activateFruit();
+                mWorld->getFruitManager()->activateFruit();
                 break;
 
             // animation events
             case EventManager::GameEvent::PLAY_PACMAN_DEATH_ANIM:
-                CharacterManager::ConstInstance()->playPacmanDeathAnimation();
+                mWorld->getConstCharacterManager()->playPacmanDeathAnimation();
                 break;
             case EventManager::GameEvent::PLAY_TILE_FLASH:
-                BoardManager::ConstInstace()->flashTiles();
+                mWorld->getBoardManager()->flashTiles();
                 break;
 
             // stats events
             case EventManager::GameEvent::CONSUME_LIFE:
-                StatsManager::Instance()->consumeLife();
+                mWorld->getStatsManager()->consumeLife();
                 break;
             case EventManager::GameEvent::POINTS_PELLET:
-                StatsManager::Instance()->pelletCollected();
-                UIManager::Instance()->updateScoreStrings();
+                mWorld->getStatsManager()->pelletCollected(event.data);
+                mIsScoreChanged = true;
                 break;
             case EventManager::GameEvent::POINTS_POWER_PELLET:
-                StatsManager::Instance()->powerPelletCollected();
-                UIManager::Instance()->updateScoreStrings();
+                mWorld->getStatsManager()->powerPelletCollected();
+                mIsScoreChanged = true;
                 break;
             case EventManager::GameEvent::POINTS_KILL_BONUS:
-                StatsManager::Instance()->ghostKillBonusPoints();
-                UIManager::Instance()->updateScoreStrings();
+                mWorld->getStatsManager()->ghostKillBonusPoints();
+                mIsScoreChanged = true;
                 break;
             case EventManager::GameEvent::POINTS_FRUIT:
-                StatsManager::Instance()->fruitCollected();
-                UIManager::Instance()->updateScoreStrings();
+                mWorld->getStatsManager()->fruitCollected();
+                mIsScoreChanged = true;
                 break;
 
             default:
@@ -268,36 +416,15 @@ void EventManager::handleGameEventQueue()
 
 void EventManager::handleSoundsEventQueue()
 {
-    // while sounds are enqueued, pop and handle sound events
+    // while sounds are enqueued, pop them, keeping the last for endFrame() to play
     EventManager::SoundEvent eventType;
-    while(!mSoundQueue->empty())
+    while(mSoundQueue->pop(eventType))
     {
-        eventType = mSoundQueue->front();
-        mSoundQueue->pop();
-
-        switch(eventType)
+        if(mFrameSound != SoundEvent::SOUND_INVAL)
         {
-            case EventManager::SoundEvent::SOUND_START:
-                PlaySound(START_MUSIC, NULL, SND_FILENAME | SND_ASYNC);
-                break;
-            case EventManager::SoundEvent::SOUND_EXTRA_LIFE:
-                PlaySound(EXTRA_LIFE_SOUND, NULL, SND_FILENAME | SND_ASYNC);
-                break;
-            case EventManager::SoundEvent::SOUND_PELLET:
-                PlaySound(PELLET_SOUND, NULL, SND_FILENAME | SND_ASYNC);
-                break;
-            case EventManager::SoundEvent::SOUND_FRUIT:
-                PlaySound(FRUIT_SOUND, NULL, SND_FILENAME | SND_ASYNC);
-                break;
-            case EventManager::SoundEvent::SOUND_PACMAN_DEATH:
-                PlaySound(PACMAN_DEATH, NULL, SND_FILENAME | SND_ASYNC);
-                break;
-            case EventManager::SoundEvent::SOUND_GHOST_DEATH:
-                PlaySound(GHOST_DEATH, NULL, SND_FILENAME | SND_ASYNC);
-                break;
-            default:
-                break;
+            mNumCollapsedSounds++;
         }
+        mFrameSound = eventType;
     }
 }
 
@@ -311,14 +438,144 @@ void EventManager::shutdown()
 
 //-----------------------------------------------------------------------------------------
 
-void EventManager::postEvent(EventManager::GameEvent eventType) const
+void EventManager::postEvent(EventManager::GameEvent eventType, const int32_t data) const
 {
-    mEventQueue->push(eventType);
+    // merge into the last event queued where that changes nothing
+    Event* back = mEventQueue->back();
+    if(back != nullptr && back->type == eventType)
+    {
+        if(isIdempotent(eventType) && back->data == data)
+        {
+            mEventQueue->numCollapsed++;
+            return;
+        }
+        if(isAdditive(eventType))
+        {
+            uint32_t slot = (mEventQueue->head + mEventQueue->size - 1) & (EVENT_QUEUE_CAPACITY - 1);
+            updateGameEventHash(slot, ZobristHash::getEventValue(eventType, back->data), ZobristHash::getEventValue(eventType, back->data + data));
+            back->data += data;
+            mEventQueue->numCollapsed++;
+            return;
+        }
+    }
+
+    Event event;
+    event.type = eventType;
+    event.data = data;
+
+    uint32_t slot = (mEventQueue->head + mEventQueue->size) & (EVENT_QUEUE_CAPACITY - 1);
+    uint32_t prevSize = mEventQueue->size;
+    mEventQueue->push(event);
+    if(mEventQueue->size != prevSize)
+    {
+        updateGameEventHash(slot, 0, ZobristHash::getEventValue(eventType, data));
+    }
 }
 
 //-----------------------------------------------------------------------------------------
 
 void EventManager::postSoundEvent(EventManager::SoundEvent eventType) const
 {
+    SoundEvent* back = mSoundQueue->back();
+    if(back != nullptr && *back == eventType)
+    {
+        mSoundQueue->numCollapsed++;
+        return;
+    }
+
     mSoundQueue->push(eventType);
 }
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t EventManager::popGameEvent(Event& event)
+{
+    uint32_t slot = mEventQueue->head;
+    if(!mEventQueue->pop(event))
+    {
+        return false;
+    }
+
+    updateGameEventHash(slot, ZobristHash::getEventValue(event.type, event.data), 0);
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void EventManager::updateGameEventHash(const uint32_t slot, const uint32_t oldValue, const uint32_t newValue) const
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GAME_EVENT, slot), oldValue, newValue);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t EventManager::isEmpty() const
+{
+    return mEventQueue->size == 0 && mSoundQueue->size == 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t EventManager::getNumPostedEvents() const
+{
+    return mEventQueue->numPosted + mSoundQueue->numPosted;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t EventManager::getPeakQueueSize() const
+{
+    return mEventQueue->peakSize > mSoundQueue->peakSize ? mEventQueue->peakSize : mSoundQueue->peakSize;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t EventManager::getNumDroppedEvents() const
+{
+    return mEventQueue->numDropped + mSoundQueue->numDropped;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t EventManager::getNumCollapsedEvents() const
+{
+    return mEventQueue->numCollapsed + mSoundQueue->numCollapsed;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t EventManager::getNumCollapsedSounds() const
+{
+    return mNumCollapsedSounds;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t EventManager::isIdempotent(const GameEvent type)
+{
+    // each of these sets things to the same state however many times it is handled
+    switch(type)
+    {
+        case EventManager::GameEvent::UI_ENTER_PREGAME_2:
+        case EventManager::GameEvent::UI_ENTER_GAME:
+        case EventManager::GameEvent::PAUSE:
+        case EventManager::GameEvent::UNPAUSE:
+        case EventManager::GameEvent::CHARACTERS_VISIBLE:
+        case EventManager::GameEvent::GHOSTS_INVISIBLE:
+        case EventManager::GameEvent::SPAWN_GHOST_RED:
+        case EventManager::GameEvent::SPAWN_GHOST_PINK:
+        case EventManager::GameEvent::SPAWN_GHOST_BLUE:
+        case EventManager::GameEvent::SPAWN_GHOST_ORANGE:
+        case EventManager::GameEvent::PLAY_TILE_FLASH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t EventManager::isAdditive(const GameEvent type)
+{
+    return type == EventManager::GameEvent::POINTS_PELLET;
+}
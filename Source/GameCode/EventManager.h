@@ -1,11 +1,18 @@
 
+#define EVENT_QUEUE_CAPACITY    32      // events each queue holds, a power of two no larger than MAX_STATE_EVENTS
+
+class GameWorld;
+struct EventState;
+
 /*
- * In order to preserve const-correctness, each manager class
- * has an Instance() method and a ConstInstance() method.
+ * In order to preserve const-correctness, each manager and character
+ * is given a const pointer to the GameWorld that owns it, and reaches
+ * other managers through the world's getConst...() methods.
  *
- * ConstInstance() returns a const pointer to the singleton object.
+ * The const getters return const pointers to the world's managers.
  * This way, objects can't call things on managers that they shouldn't
- * (such as update or draw).
+ * (such as update or draw). Only the EventManager is given a non-const
+ * world.
  *
  * It is fine for objects to call on managers for const getter functions,
  * but if an object needs to affect another object, they should post an
@@ -13,7 +20,21 @@
  * not upwards or sideways).
  *
  * The EventManager enqueues events, and calls on the appropriate handler
- * functions on these objects' behalf.
+ * functions on these objects' behalf. An event can carry one word of data
+ * with it, see GameEvent.
+ *
+ * Each queue is a ring of EVENT_QUEUE_CAPACITY events allocated along
+ * with the manager, so posting and handling events never allocates, and
+ * clearing a queue is O(1). A tick posts a handful of events, far fewer
+ * than a queue holds; an event posted to a full queue is dropped, and
+ * counted, see getNumDroppedEvents().
+ *
+ * An event posted right behind one of the same type is merged into it
+ * where that changes nothing: a second PAUSE or SPAWN_GHOST_RED does
+ * nothing the first hasn't, and pellet points add up into one event,
+ * see postEvent(). Score strings and sounds are for the player, not the
+ * game, so the events handled over a frame's ticks refresh the score
+ * strings and play a sound at most once, in endFrame().
  *
  * Keep in mind that the order of events posted is important. Some events
  * (such as the beginning and ending of levels) clears the EventManager's
@@ -53,7 +74,7 @@ public:
 
         SCARE_GHOSTS,           // ghost events                     // scares ghosts
         CRUISE_ELROY,                                               // activates the next level of Cruise Elroy
-        GHOST_KILLED,                                               // awards points, starts the short pause whenever a ghost is killed
+        GHOST_KILLED,                                               // awards points, starts the short pause whenever a ghost is killed, data is the GameUtil::CharacterID of the ghost
 
         ACTIVATE_FRUIT,         // fruit event                      // makes fruit visible and starts its timer
 
@@ -61,7 +82,7 @@ public:
         PLAY_TILE_FLASH,                                            // tells tiles to flash enthusiastically
 
         CONSUME_LIFE,           // stats events                     // reduces life counter by 1
-        POINTS_PELLET,                                              // points for pellet
+        POINTS_PELLET,                                              // points for pellet, data is the number of pellets
         POINTS_POWER_PELLET,                                        // points for power pellet
         POINTS_KILL_BONUS,                                          // points for perfect round bonus
         POINTS_FRUIT                                                // points for fruit
@@ -82,8 +103,16 @@ public:
         SOUND_GHOST_DEATH
     }SoundEvent;
 
-    static EventManager* Instance();
-    static const EventManager* ConstInstace();
+    /*
+     * A queued game event, and the data posted with it.
+     */
+    typedef struct
+    {
+        GameEvent type;
+        int32_t data;
+    }Event;
+
+    EventManager(GameWorld* world);
     void init();
 
     /*
@@ -91,29 +120,119 @@ public:
      */
     void reset();
 
+    /*
+     * Copies the queued events out to 'state', or replaces
+     * the queues with the events in it.
+     */
+    void saveState(EventState* state) const;
+    void loadState(const EventState* state);
+
     /*
      * Calls on handler functions for each of the EventManager's queues.
      */
     void update();
 
+    /*
+     * Refreshes the score strings if any points were scored, and plays
+     * the last sound handled, over the ticks of the frame just updated.
+     */
+    void endFrame();
+
     /*
      * Clears, then destroys the queues.
      */
     void shutdown();
 
     /*
-     * Enqueues a game event.
+     * Enqueues a game event, with 'data' for the events that take it.
+     * An event the same as the last one queued is merged into it if
+     * it can be, see GameEvent.
      */
-    void postEvent(GameEvent eventType) const;
+    void postEvent(GameEvent eventType, const int32_t data = 0) const;
 
     /*
-     * Enqueues a sound event.
+     * Enqueues a sound event, unless it is the same as the last one
+     * queued.
      */
     void postSoundEvent(SoundEvent eventType) const;
 
+    /*
+     * Returns true if no game or sound events are queued.
+     */
+    const bool8_t isEmpty() const;
+
+    /*
+     * Returns the number of events posted to either queue, the most
+     * either queue has held at once, and the number of events dropped
+     * because their queue was full. For benchmarking.
+     */
+    const uint32_t getNumPostedEvents() const;
+    const uint32_t getPeakQueueSize() const;
+    const uint32_t getNumDroppedEvents() const;
+
+    /*
+     * Returns the number of events merged into the one queued before
+     * them, and the number of sounds cut short by a later one in the
+     * same frame. For benchmarking.
+     */
+    const uint32_t getNumCollapsedEvents() const;
+    const uint32_t getNumCollapsedSounds() const;
+
 private:
 
-    EventManager();
+    /*
+     * Fixed-capacity queue of events of type T, in a ring.
+     */
+    template<typename T>
+    struct EventRing
+    {
+        T events[EVENT_QUEUE_CAPACITY];
+        uint32_t head;                      // index of the oldest event
+        uint32_t size;
+
+        uint32_t numPosted;
+        uint32_t peakSize;
+        uint32_t numDropped;
+        uint32_t numCollapsed;
+
+        EventRing();
+
+        /*
+         * Drops every queued event, in O(1).
+         */
+        void clear();
+
+        /*
+         * Adds 'event' to the back of the queue, or counts it as
+         * dropped if the queue is full.
+         */
+        void push(const T& event);
+
+        /*
+         * Removes the oldest event into 'event'. Returns false if
+         * the queue is empty.
+         */
+        bool8_t pop(T& event);
+
+        /*
+         * Returns the newest queued event, or nullptr if the queue
+         * is empty.
+         */
+        T* back();
+
+        /*
+         * Returns the 'i'th oldest queued event.
+         */
+        const T& at(const uint32_t i) const;
+    };
+
+    /*
+     * Returns true if a 'type' event posted right behind another
+     * does nothing the first doesn't, so can be dropped, or adds its
+     * data to the first's.
+     */
+    static const bool8_t isIdempotent(const GameEvent type);
+    static const bool8_t isAdditive(const GameEvent type);
 
     /*
      * Handles all enqueued game events posted
@@ -121,17 +240,34 @@ private:
      */
     void handleGameEventQueue();
 
+    /*
+     * Removes the oldest game event into 'event', taking it out of
+     * the world's Zobrist hash. Returns false if the queue is empty.
+     */
+    bool8_t popGameEvent(Event& event);
+
+    /*
+     * Changes the game event in ring slot 'slot' from 'oldValue' to
+     * 'newValue' in the world's Zobrist hash, see
+     * ZobristHash::getEventValue(). An empty slot has value 0.
+     */
+    void updateGameEventHash(const uint32_t slot, const uint32_t oldValue, const uint32_t newValue) const;
+
     /*
      * Handles all enqueued sound events posted
      * since the last update frame.
      */
     void handleSoundsEventQueue();
 
-    static EventManager* _instance;
+    GameWorld* mWorld;
 
-    typedef std::queue<GameEvent> EventQueue;
+    typedef EventRing<Event> EventQueue;
     EventQueue* mEventQueue;
 
-    typedef std::queue<SoundEvent> SoundQueue;
+    typedef EventRing<SoundEvent> SoundQueue;
     SoundQueue* mSoundQueue;
+
+    SoundEvent mFrameSound;             // last sound handled this frame, played by endFrame()
+    bool8_t mIsScoreChanged;            // points were scored this frame, see endFrame()
+    uint32_t mNumCollapsedSounds;
 };
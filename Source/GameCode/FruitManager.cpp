@@ -2,17 +2,18 @@
 #define FRUIT_MANAGER_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
-#include "soil.h"
+#ifndef PACSIM_HEADLESS
+#include "SOIL.h"
+#endif
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 
 #include "FruitManager.h"
 
@@ -26,15 +27,19 @@
 #include "BoardManager.h"
 #include "CharacterManager.h"
 
-#include <queue>
 #include "EventManager.h"
 
 #include "StatsManager.h"
 
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
 #define FRUIT_SPRITESHEET "Assets\\Images\\FruitSpritesheet.png"
 
 
 #define FRUIT_DURATION  10000
+#define FRUIT_TIMER_ID  0
 
 #define NUM_FRUIT                       8
 #define FRUIT_SPRITE_SIZE               32
@@ -47,50 +52,30 @@
 #define COLLECTED_FRUIT_POS_X   260
 #define COLLECTED_FRUIT_POS_Y   -1768
 
-FruitManager* FruitManager::_instance = nullptr;
-
-FruitManager::FruitManager() :
-    mCollectedFruit(new CollectedFruit())
-{
-}
-
-//-----------------------------------------------------------------------------------------
-
-FruitManager* FruitManager::Instance()
+FruitManager::FruitManager(const GameWorld* world) :
+    mWorld(world),
+    mPhase(GameUtil::FruitPhase::PRE_FRUIT),
+    mCollectedFruit(new CollectedFruit()),
+    mTimer(0),
+    mTimerStart(0),
+    mIsVisible(false),
+    mIsPaused(true)
 {
-    if(_instance == nullptr)
-    {
-        _instance = new FruitManager();
-    }
-
-    return _instance;
-}
-
-//-----------------------------------------------------------------------------------------
-
-const FruitManager* FruitManager::ConstInstace()
-{
-    // returning a const-safe instance of the FruitManager
-    //      this way, the caller can't do anything it shouldn't to the manager
-    if(_instance == nullptr)
-    {
-        _instance = new FruitManager();
-    }
-
-    return _instance;
 }
 
 //-----------------------------------------------------------------------------------------
 
 void FruitManager::init()
 {
+#ifndef PACSIM_HEADLESS
     mFruitSpritesheetID = SOIL_load_OGL_texture(FRUIT_SPRITESHEET, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID,
         SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
     assert(mFruitSpritesheetID > 0);
+#endif
 
     // init tile position
-    mFruitTile = BoardManager::ConstInstace()->getFruitTile();
-    Coord2D tilePos = mFruitTile->getPosition();
+    mFruitTile = mWorld->getConstBoardManager()->getFruitTile();
+    Coord2D tilePos = mWorld->getConstBoardManager()->getGrid()->getPosition(mFruitTile);
 
     mPosition.x = tilePos.x;
     mPosition.y = tilePos.y;
@@ -109,17 +94,17 @@ void FruitManager::init()
 void FruitManager::reset()
 {
     // full reset from game over
-    mTimer = 0;
-    mIsVisible = false;
-    mIsPaused = true;
-    mPhase = GameUtil::FruitPhase::PRE_FRUIT;
+    setTimer(0);
+    setVisible(false);
+    setPaused(true);
+    setPhase(GameUtil::FruitPhase::PRE_FRUIT);
 
     // reset collected fruit to false, then set cherry to true (game starts with cherry displaying)
     for(auto iter = mCollectedFruit->begin(); iter != mCollectedFruit->end(); ++iter)
     {
-        iter->second = false;
+        setCollected(iter->first, false);
     }
-    mCollectedFruit->at(GameUtil::FruitType::FRUIT_CHERRY) = true;
+    setCollected(GameUtil::FruitType::FRUIT_CHERRY, true);
 
     // reset the fruit type to cherry for the new game
     mFruitType = GameUtil::FruitType::FRUIT_CHERRY;
@@ -130,9 +115,76 @@ void FruitManager::reset()
 void FruitManager::resetFromDeath()
 {
     // resets fruit timer from pacman death
-    mTimer = 0;
-    mIsVisible = false;
-    mIsPaused = true;
+    setTimer(0);
+    setVisible(false);
+    setPaused(true);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::saveState(FruitState* state) const
+{
+    state->fruitType = mFruitType;
+    state->phase = mPhase;
+    state->timer = mTimer;
+    state->timerStart = mTimerStart;
+    state->isVisible = mIsVisible;
+    state->isPaused = mIsPaused;
+
+    // one bit per fruit type
+    state->collectedFruit = 0;
+    for(auto iter = mCollectedFruit->begin(); iter != mCollectedFruit->end(); ++iter)
+    {
+        if(iter->second)
+        {
+            state->collectedFruit |= 1u << iter->first;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::loadState(const FruitState* state)
+{
+    mFruitType = (GameUtil::FruitType)state->fruitType;
+    mPhase = (GameUtil::FruitPhase)state->phase;
+    mTimer = state->timer;
+    mTimerStart = state->timerStart;
+    mIsVisible = state->isVisible;
+    mIsPaused = state->isPaused;
+
+    for(auto iter = mCollectedFruit->begin(); iter != mCollectedFruit->end(); ++iter)
+    {
+        iter->second = (state->collectedFruit & (1u << iter->first)) != 0;
+    }
+
+    // the world's timers are cleared as a state is loaded
+    setTimerDue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::loadLevelState(const FruitState* state, const bool8_t isNewGame)
+{
+    uint32_t collectedFruit = 0;
+    for(auto iter = mCollectedFruit->begin(); iter != mCollectedFruit->end(); ++iter)
+    {
+        if(iter->second)
+        {
+            collectedFruit |= 1u << iter->first;
+        }
+    }
+
+    loadState(state);
+
+    // the collected fruit carries over into the next level
+    if(!isNewGame)
+    {
+        for(auto iter = mCollectedFruit->begin(); iter != mCollectedFruit->end(); ++iter)
+        {
+            setCollected(iter->first, (collectedFruit & (1u << iter->first)) != 0);
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------------------
@@ -141,53 +193,67 @@ void FruitManager::nextLevel()
 {
     // reset fruit collection variables
     //      we don't reset the collected fruit map unless we're completely resetting
-    mTimer = 0;
-    mIsVisible = false;
-    mIsPaused = true;
-    mPhase = GameUtil::FruitPhase::PRE_FRUIT;
+    setTimer(0);
+    setVisible(false);
+    setPaused(true);
+    setPhase(GameUtil::FruitPhase::PRE_FRUIT);
 
     // save the fruit type for the current level
-    mFruitType = StatsManager::ConstInstace()->getFruitType();
+    mFruitType = mWorld->getConstStatsManager()->getFruitType();
 }
 
 //-----------------------------------------------------------------------------------------
 
-void FruitManager::updateFruit(DWORD milliseconds)
+void FruitManager::updateFruit()
 {
     if(mIsVisible && !mIsPaused)
     {
-        const CharacterManager* cmInstance = CharacterManager::ConstInstance();
+        checkCollected();
+    }
+}
 
-        const Character::MovementState movementState = cmInstance->getCharacterMovementState(GameUtil::CharacterID::PACMAN);
-        if(movementState == Character::AT_TILE)
-        {
-            // post fruit collected event and mark fruit as collected if pacman's tile is the fruit tile
-            const Tile* pacmanTile = cmInstance->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
-            if(pacmanTile == mFruitTile)
-            {
-                const EventManager* emManager = EventManager::ConstInstace();
-                emManager->postEvent(EventManager::GameEvent::POINTS_FRUIT);
-                emManager->postSoundEvent(EventManager::SoundEvent::SOUND_FRUIT);
-
-                mCollectedFruit->at(mFruitType) = true;
-                deactivateFruit();
-            }
-        }
+//-----------------------------------------------------------------------------------------
 
-        // update timer
-        if(mTimer > 0)
-        {
-            mTimer -= milliseconds;
-        }
-        else
-        {
-            deactivateFruit();
-        }
+void FruitManager::handleTimer(const int32_t id)
+{
+    // the fruit timer is the only one the fruit sets
+    assert(id == FRUIT_TIMER_ID);
+    if(id != FRUIT_TIMER_ID)
+    {
+        return;
+    }
+
+    // the timer ran out before this update, though pacman may still collect the fruit on it
+    checkCollected();
+    if(mIsVisible)
+    {
+        deactivateFruit();
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
+const uint32_t FruitManager::getNumQuietTicks() const
+{
+    if(!mIsVisible || mIsPaused)
+    {
+        return TICKS_UNLIMITED;
+    }
+
+    // pacman collects the fruit when he's at its tile
+    const CharacterManager* cmInstance = mWorld->getConstCharacterManager();
+    if(cmInstance->getCharacterMovementState(GameUtil::CharacterID::PACMAN) == Character::AT_TILE &&
+        cmInstance->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN) == mFruitTile)
+    {
+        return 0;
+    }
+
+    return TICKS_UNLIMITED;
+}
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
 void FruitManager::drawFruit()
 {
     glEnable(GL_TEXTURE_2D);
@@ -199,9 +265,11 @@ void FruitManager::drawFruit()
 
     glEnd();
 }
+#endif
 
 //-----------------------------------------------------------------------------------------
 
+#ifndef PACSIM_HEADLESS
 void FruitManager::drawActiveFruit()
 {
     if(mIsVisible)
@@ -223,9 +291,11 @@ void FruitManager::drawActiveFruit()
         GameUtil::Utilities::drawSprite(vertTR, vertBL, textureCoord, textureSize);
     }
 }
+#endif
 
 //-----------------------------------------------------------------------------------------
 
+#ifndef PACSIM_HEADLESS
 void FruitManager::drawCollectedFruit()
 {
     Coord2D vertTR, vertBL, textureCoord, textureSize;
@@ -249,6 +319,7 @@ void FruitManager::drawCollectedFruit()
         }
     }
 }
+#endif
 
 //-----------------------------------------------------------------------------------------
 
@@ -265,9 +336,9 @@ void FruitManager::activateFruit()
     GameUtil::FruitPhase nextPhase = (GameUtil::FruitPhase)(mPhase + 1);
     if(nextPhase != GameUtil::FruitPhase::FRUIT_INVAL)
     {
-        mTimer = FRUIT_DURATION;
-        mPhase = nextPhase;
-        mIsVisible = true;
+        setTimer(FRUIT_DURATION);
+        setPhase(nextPhase);
+        setVisible(true);
     }
 }
 
@@ -275,22 +346,22 @@ void FruitManager::activateFruit()
 
 void FruitManager::deactivateFruit()
 {
-    mIsVisible = false;
-    mTimer = 0;
+    setVisible(false);
+    setTimer(0);
 }
 
 //-----------------------------------------------------------------------------------------
 
 void FruitManager::pauseFruit()
 {
-    mIsPaused = true;
+    setPaused(true);
 }
 
 //-----------------------------------------------------------------------------------------
 
 void FruitManager::unpauseFruit()
 {
-    mIsPaused = false;
+    setPaused(false);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -299,3 +370,121 @@ const GameUtil::FruitPhase FruitManager::getPhase() const
 {
     return mPhase;
 }
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::checkCollected()
+{
+    const CharacterManager* cmInstance = mWorld->getConstCharacterManager();
+
+    const Character::MovementState movementState = cmInstance->getCharacterMovementState(GameUtil::CharacterID::PACMAN);
+    if(movementState == Character::AT_TILE)
+    {
+        // post fruit collected event and mark fruit as collected if pacman's tile is the fruit tile
+        const TileIndex pacmanTile = cmInstance->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
+        if(pacmanTile == mFruitTile)
+        {
+            const EventManager* emManager = mWorld->getConstEventManager();
+            emManager->postEvent(EventManager::GameEvent::POINTS_FRUIT);
+            emManager->postSoundEvent(EventManager::SoundEvent::SOUND_FRUIT);
+
+            setCollected(mFruitType, true);
+            deactivateFruit();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t FruitManager::isTimerRunning() const
+{
+    return mIsVisible && !mIsPaused;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t FruitManager::getNumTimerSteps() const
+{
+    // the timer counts down on every update that starts above 0
+    return mTimer > 0 ? (mTimer + SIM_TICK_TIME - 1) / SIM_TICK_TIME : 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t FruitManager::getTimer() const
+{
+    if(!isTimerRunning())
+    {
+        return mTimer;
+    }
+
+    uint32_t numSteps = mWorld->getTick() - mTimerStart;
+    if(numSteps > getNumTimerSteps())
+    {
+        numSteps = getNumTimerSteps();
+    }
+
+    return mTimer - (int32_t)(SIM_TICK_TIME * numSteps);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::setTimerDue() const
+{
+    // the update after the timer's last count down deactivates the fruit
+    mWorld->setTimer(GameWorld::TimerOwner::FRUIT_MANAGER, FRUIT_TIMER_ID,
+        isTimerRunning() ? mTimerStart + getNumTimerSteps() + 1 : 0);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::setTimer(const int32_t time)
+{
+    // a running timer counts down from the current tick, a stopped one is kept as of tick 0
+    uint32_t start = isTimerRunning() ? mWorld->getTick() : 0;
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::FRUIT_TIMER), mTimer, time);
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::FRUIT_TIMER_START), mTimerStart, start);
+    mTimer = time;
+    mTimerStart = start;
+
+    setTimerDue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::setPhase(const GameUtil::FruitPhase phase)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::FRUIT_PHASE), mPhase, phase);
+    mPhase = phase;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::setVisible(const bool8_t isVisible)
+{
+    // the timer stops or starts where it is now
+    int32_t timer = getTimer();
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::FRUIT_VISIBLE), mIsVisible, isVisible);
+    mIsVisible = isVisible;
+    setTimer(timer);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::setPaused(const bool8_t isPaused)
+{
+    // the timer stops or starts where it is now
+    int32_t timer = getTimer();
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::FRUIT_PAUSED), mIsPaused, isPaused);
+    mIsPaused = isPaused;
+    setTimer(timer);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void FruitManager::setCollected(const GameUtil::FruitType type, const bool8_t isCollected)
+{
+    bool& wasCollected = mCollectedFruit->at(type);
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::COLLECTED_FRUIT, type), wasCollected, isCollected);
+    wasCollected = isCollected;
+}
@@ -1,7 +1,12 @@
 
+class GameWorld;
+struct FruitState;
+
 /*
  * Managers the timer controlling fruit
- * and the list of collected fruit.
+ * and the list of collected fruit. The
+ * timer is set on the GameWorld's TimerWheel
+ * to go off only on the update it runs out.
  *
  * There is an enumeration for the fruit type,
  * which acts as an offset into the fruit spritesheet
@@ -15,8 +20,7 @@ class FruitManager
 {
 public:
 
-    static FruitManager* Instance();
-    static const FruitManager* ConstInstace();
+    FruitManager(const GameWorld* world);
 
     /*
      * Loads the fruit spritesheet. Creates a
@@ -37,6 +41,19 @@ public:
      */
     void resetFromDeath();
 
+    /*
+     * Copies the active fruit, its timer, and the collected
+     * fruit out to 'state', or back in from it.
+     */
+    void saveState(FruitState* state) const;
+    void loadState(const FruitState* state);
+
+    /*
+     * Loads a level's start state from 'state', keeping the
+     * collected fruit unless 'isNewGame'. See GameWorld::startLevel().
+     */
+    void loadLevelState(const FruitState* state, const bool8_t isNewGame);
+
     /*
      * Resets the fruit timer, and updates the 
      * fruit type for the next level.
@@ -44,10 +61,24 @@ public:
     void nextLevel();
 
     /*
-     * If the fruit is active, checks if pacman has collected the fruit
-     * and updates the fruit timer.
+     * If the fruit is active, checks if pacman has collected the fruit.
+     */
+    void updateFruit();
+
+    /*
+     * Handles the fruit timer running out, called by the world on
+     * the update after its last count down: checks if pacman has
+     * collected the fruit first, as updateFruit would, then
+     * deactivates it.
+     */
+    void handleTimer(const int32_t id);
+
+    /*
+     * Returns the number of updates, from now, over which pacman
+     * doesn't collect the fruit. The timer running out is left to
+     * the world's TimerWheel.
      */
-    void updateFruit(DWORD milliseconds);
+    const uint32_t getNumQuietTicks() const;
 
     /*
      * Calls helper functions for drawing the active fruit and all 
@@ -88,8 +119,6 @@ public:
 
 private:
 
-    FruitManager();
-
     /*
      * If a fruit is active, draws the fruit at the
      * fruit tile.
@@ -102,7 +131,48 @@ private:
      */
     void drawCollectedFruit();
 
-    static FruitManager* _instance;
+    /*
+     * Posts the fruit collected events, and deactivates the fruit,
+     * if pacman is at the fruit tile.
+     */
+    void checkCollected();
+
+    /*
+     * Returns true if the fruit timer counts down: the fruit is
+     * visible and not paused.
+     */
+    const bool8_t isTimerRunning() const;
+
+    /*
+     * Returns the number of updates the fruit timer counts down
+     * on from its kept value before it's out.
+     */
+    const uint32_t getNumTimerSteps() const;
+
+    /*
+     * Returns the fruit timer as of the world's current tick.
+     */
+    const int32_t getTimer() const;
+
+    /*
+     * Sets the fruit timer on the world's TimerWheel for the
+     * update that deactivates the fruit, if it's running.
+     */
+    void setTimerDue() const;
+
+    /*
+     * Setters for the fruit timer, phase, and flags, and for
+     * whether fruit of type 'type' has been collected, which keep
+     * the world's Zobrist hash up to date. Visibility and pausing
+     * also stop or start the timer.
+     */
+    void setTimer(const int32_t time);
+    void setPhase(const GameUtil::FruitPhase phase);
+    void setVisible(const bool8_t isVisible);
+    void setPaused(const bool8_t isPaused);
+    void setCollected(const GameUtil::FruitType type, const bool8_t isCollected);
+
+    const GameWorld* mWorld;
     
     GameUtil::FruitType mFruitType;
     GameUtil::FruitPhase mPhase;
@@ -111,10 +181,11 @@ private:
     typedef std::pair<const GameUtil::FruitType, bool> CollectedFruitPair;
     CollectedFruit* mCollectedFruit;
 
-    const Tile* mFruitTile;
+    TileIndex mFruitTile;
     Coord2D mPosition;
 
     int32_t mTimer;
+    uint32_t mTimerStart;                   // tick of the world's clock the timer is kept as of
     bool8_t mIsVisible;
     bool8_t mIsPaused;
 
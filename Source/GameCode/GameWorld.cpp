@@ -0,0 +1,949 @@
+
+#define GAME_WORLD_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include <string.h>
+#include "../Framework/baseTypes.h"
+#include "../Framework/random.h"
+
+#include <map>
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "WorldState.h"
+#include "Character.h"
+#include "Pacman.h"
+#include "Ghost.h"
+#include "GhostRed.h"
+#include "GhostPink.h"
+#include "GhostBlue.h"
+#include "GhostOrange.h"
+#include "BoardManager.h"
+#include "CharacterManager.h"
+
+#include "EventManager.h"
+
+#include "TimerWheel.h"
+#include "TimerManager.h"
+
+#include "FruitManager.h"
+
+#include "StatsManager.h"
+
+#include <vector>
+#include "Replay.h"
+
+#include "RewindBuffer.h"
+
+#include "ZobristHash.h"
+#include "HashStream.h"
+
+#include "GameWorld.h"
+
+static_assert(NUM_STATE_RANDOM_WORDS == RANDOM_STATE_WORDS, "world state must hold the random generator's state");
+static_assert(TimerManager::NUM_TIMERS + 1 + NUM_STATE_CHARACTERS <= TIMER_WHEEL_CAPACITY, "the wheel must hold every timer at once");
+
+GameWorld::GameWorld() :
+    mStatsManager(new StatsManager(this)),
+    mEventManager(new EventManager(this)),
+    mTimerManager(new TimerManager(this)),
+    mBoardManager(new BoardManager(this)),
+    mFruitManager(new FruitManager(this)),
+    mCharacterManager(new CharacterManager(this)),
+    mRandom(new RandomGenerator(DEFAULT_RANDOM_SEED)),
+    mReplay(nullptr),
+    mRewind(nullptr),
+    mZobrist(new ZobristHash()),
+    mHashStream(nullptr),
+    mWheel(new TimerWheel()),
+    mTimerHandles(new uint32_t[TimerOwner::NUM_TIMER_OWNERS * NUM_OWNER_TIMERS]),
+    mLevelStates(new GameWorldState*[NUM_LEVEL_STATES]()),
+    mInput(GameUtil::BoardDirection::INVAL),
+    mApplicationState(ApplicationState::IN_MENU),
+    mGameTime(0),
+    mTickTime(0),
+    mNumSteps(0)
+{
+    loadClock(0);
+}
+
+//-----------------------------------------------------------------------------------------
+
+GameWorld::~GameWorld()
+{
+    delete mStatsManager;
+    delete mEventManager;
+    delete mTimerManager;
+    delete mBoardManager;
+    delete mFruitManager;
+    delete mCharacterManager;
+    delete mRandom;
+    delete mZobrist;
+    delete mWheel;
+    delete[] mTimerHandles;
+
+    clearLevelStates();
+    delete[] mLevelStates;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::init()
+{
+    mApplicationState = ApplicationState::IN_MENU;
+    mGameTime = 0;
+    mTickTime = 0;
+    mNumSteps = 0;
+
+    mStatsManager->init();
+
+    mEventManager->init();
+    mTimerManager->init();
+    mBoardManager->init();
+    mFruitManager->init();
+    mCharacterManager->init();
+
+    // level start states are of the board just loaded
+    clearLevelStates();
+
+    // level 1's start state is kept now, so the first game starts like every other
+    //      the resets give every manager its values, so the menu sits in that state too
+    resetManagers(true);
+    keepLevelState(1);
+    setApplicationState(ApplicationState::IN_MENU);
+
+    // start the game on the game over screen
+    mEventManager->postEvent(EventManager::GameEvent::GAME_OVER);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::startGame() const
+{
+    mEventManager->postEvent(EventManager::GameEvent::START_FROM_MENU);
+    mEventManager->postSoundEvent(EventManager::SoundEvent::SOUND_START);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::startLevel(const bool8_t isNewGame)
+{
+    int32_t level = isNewGame ? 1 : getLevel() + 1;
+    if(level > NUM_LEVEL_STATES)
+    {
+        resetManagers(isNewGame);
+        return;
+    }
+
+    // the first start of a level keeps the state the resets leave the world in
+    const GameWorldState* levelState = mLevelStates[level - 1];
+    if(levelState == nullptr)
+    {
+        resetManagers(isNewGame);
+        keepLevelState(level);
+        return;
+    }
+
+    // the kept state comes with its hash, which the carried over fields update as they're put back
+    mZobrist->setValue(levelState->zobristHash);
+    mApplicationState = (ApplicationState)levelState->applicationState;
+    loadClock(levelState->tick);
+
+    // the game time and random numbers run on through every level and game
+    updateRandomHash(levelState->random);
+
+    // each manager keeps its own share of what carries over
+    //      the board rebuilds its pellet triggers from the level, so the stats go first
+    mStatsManager->loadLevelState(&levelState->stats, isNewGame);
+    mEventManager->loadState(&levelState->events);
+    mTimerManager->loadState(&levelState->timers);
+    mBoardManager->loadState(&levelState->board);
+    mFruitManager->loadLevelState(&levelState->fruit, isNewGame);
+    mCharacterManager->loadLevelState(&levelState->characters);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::keepLevelState(const int32_t level)
+{
+    GameWorldState*& levelState = mLevelStates[level - 1];
+    delete levelState;
+
+    levelState = new GameWorldState();
+    memset(levelState, 0, sizeof(GameWorldState));
+    saveState(levelState);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::clearLevelStates()
+{
+    for(int32_t level = 0; level < NUM_LEVEL_STATES; ++level)
+    {
+        delete mLevelStates[level];
+        mLevelStates[level] = nullptr;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::resetManagers(const bool8_t isNewGame)
+{
+    if(isNewGame)
+    {
+        setApplicationState(ApplicationState::IN_GAME);
+        mStatsManager->reset();
+        mTimerManager->reset();
+        mBoardManager->reset();
+        mFruitManager->reset();
+        mCharacterManager->reset();
+        mEventManager->reset();
+        mWheel->setTick(0);                                     // the resets cancel every timer, so the level starts from tick 0
+        mTimerManager->activateStartTimerFromMenu();
+    }
+    else
+    {
+        mStatsManager->nextLevel();
+        mTimerManager->reset();
+        mBoardManager->reset();
+        mFruitManager->nextLevel();
+        mCharacterManager->reset();
+        mEventManager->reset();
+        mWheel->setTick(0);                                     // the resets cancel every timer, so the level starts from tick 0
+        mTimerManager->activateStartTimerFromWin();
+    }
+
+    // resets change the whole board at once, so the hash is worked out again
+    mZobrist->setValue(computeZobristHash());
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::update(DWORD milliseconds)
+{
+    // the state is read before handling events, so a game that starts or ends
+    // this frame is updated the same way the game loop always has
+    switch(mApplicationState)
+    {
+        case ApplicationState::IN_MENU:
+            mGameTime = 0;                                      // every game's clock starts from 0
+            mEventManager->update();                            // calls events in queue
+            mTickTime = 0;                                      // a new game starts on a tick boundary
+
+            // a new game's history starts from its first state
+            if(mApplicationState == ApplicationState::IN_GAME && mRewind != nullptr)
+            {
+                mRewind->clear();
+                pushRewindState();
+            }
+            if(mApplicationState == ApplicationState::IN_GAME && mHashStream != nullptr)
+            {
+                mHashStream->clear();
+                pushTickHash();
+            }
+            break;
+
+        case ApplicationState::IN_GAME:
+            // run every whole tick we have time for, stopping if the game ends
+            mTickTime += milliseconds;
+            while(mTickTime >= SIM_TICK_TIME && mApplicationState == ApplicationState::IN_GAME)
+            {
+                mTickTime -= SIM_TICK_TIME;
+                tick();
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    mEventManager->endFrame();                                  // refreshes the score and plays a sound, once for the frame
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::fastForward(DWORD milliseconds)
+{
+    // the menu has nothing to skip
+    if(mApplicationState != ApplicationState::IN_GAME)
+    {
+        update(milliseconds);
+        return;
+    }
+
+    // run the same ticks as update(), but step over runs of quiet ticks all at once
+    mTickTime += milliseconds;
+    while(mTickTime >= SIM_TICK_TIME && mApplicationState == ApplicationState::IN_GAME)
+    {
+        // played back input can change on any tick, so a run of quiet ticks also ends where its input does
+        bool8_t isPlayingReplay = mReplay != nullptr && !mReplay->isRecording();
+        if(isPlayingReplay)
+        {
+            mCharacterManager->setPacmanInput(mReplay->getInput());
+        }
+
+        // the rewind buffer and hash stream keep every tick, so none can be stepped over
+        uint32_t numTicks = mRewind == nullptr && mHashStream == nullptr ? getNumQuietTicks() : 0;
+        if(numTicks > mTickTime / SIM_TICK_TIME)
+        {
+            numTicks = mTickTime / SIM_TICK_TIME;
+        }
+        if(isPlayingReplay && numTicks > mReplay->getNumTicksOnInput())
+        {
+            numTicks = mReplay->getNumTicksOnInput();
+        }
+        if(mReplay != nullptr && numTicks > mReplay->getNumTicksToCheckpoint())
+        {
+            numTicks = mReplay->getNumTicksToCheckpoint();
+        }
+
+        if(numTicks > 0)
+        {
+            skipQuietTicks(numTicks);
+        }
+        else
+        {
+            numTicks = 1;
+            tick();
+        }
+
+        mTickTime -= numTicks * SIM_TICK_TIME;
+    }
+
+    mEventManager->endFrame();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::tick()
+{
+    mNumSteps++;
+    updateReplay(1);                                            // records or plays back this tick's input
+    mGameTime += SIM_TICK_TIME;                                 // advances the clock animations are read from
+    mEventManager->update();                                    // calls events in queue
+    advanceClock(1);                                            // advances the clock timers are set on
+    updateTimers(TimerOwner::TIMER_MANAGER);                    // handles timers for time-delayed events
+    mBoardManager->updateBoard();                               // updates tiles and pellets
+    updateTimers(TimerOwner::FRUIT_MANAGER);                    // runs the fruit out
+    mFruitManager->updateFruit();                               // updates fruit
+    updateTimers(TimerOwner::CHARACTER_MANAGER);                // changes ghost phases, flashes and unscares ghosts
+    mCharacterManager->updateCharacters(SIM_TICK_TIME);         // updates moving characters
+    updateReplayCheckpoint();
+    pushRewindState();
+    pushTickHash();
+
+    // a replay is of one game
+    if(mReplay != nullptr && mApplicationState != ApplicationState::IN_GAME)
+    {
+        stopReplay();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::advanceClock(const uint32_t numTicks)
+{
+    uint32_t tick = mWheel->getTick();
+    if(numTicks == 1)
+    {
+        mWheel->advance();
+    }
+    else
+    {
+        mWheel->skip(numTicks);
+    }
+
+    mZobrist->update(ZobristHash::getKey(ZobristHash::Field::TIMER_CLOCK), tick, tick + numTicks);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::updateTimers(const TimerOwner owner)
+{
+    // each owner's timers are kept on the wheel by their index in the handles
+    int32_t timer;
+    while(mWheel->popDue(timer, owner * NUM_OWNER_TIMERS, (owner + 1) * NUM_OWNER_TIMERS))
+    {
+        // the timer is off the wheel, so its handler can set it again
+        mTimerHandles[timer] = TIMER_WHEEL_NO_TIMER;
+
+        int32_t id = timer - owner * NUM_OWNER_TIMERS;
+
+        switch(owner)
+        {
+            case TimerOwner::TIMER_MANAGER:
+                mTimerManager->handleTimer((TimerManager::TimerID)id);
+                break;
+            case TimerOwner::FRUIT_MANAGER:
+                mFruitManager->handleTimer(id);
+                break;
+            case TimerOwner::CHARACTER_MANAGER:
+                mCharacterManager->handleTimer(id);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::setTimer(const TimerOwner owner, const int32_t id, const uint32_t tick) const
+{
+    int32_t timer = owner * NUM_OWNER_TIMERS + id;
+    mWheel->cancel(mTimerHandles[timer]);
+    mTimerHandles[timer] = tick != 0 ? mWheel->schedule(tick, timer) : TIMER_WHEEL_NO_TIMER;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getTick() const
+{
+    return mWheel->getTick();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::loadClock(const uint32_t tick)
+{
+    // handles don't carry over, so each manager puts its timers back on an empty wheel
+    mWheel->clear();
+    mWheel->setTick(tick);
+    for(int32_t timer = 0; timer < TimerOwner::NUM_TIMER_OWNERS * NUM_OWNER_TIMERS; ++timer)
+    {
+        mTimerHandles[timer] = TIMER_WHEEL_NO_TIMER;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getNumQuietTicks() const
+{
+    // any queued event changes something on the next tick
+    if(!mEventManager->isEmpty())
+    {
+        return 0;
+    }
+
+    uint32_t numTicks = mWheel->getNumQuietTicks();
+    uint32_t numManagerTicks = mBoardManager->getNumQuietTicks();
+    if(numManagerTicks < numTicks) numTicks = numManagerTicks;
+
+    numManagerTicks = mFruitManager->getNumQuietTicks();
+    if(numManagerTicks < numTicks) numTicks = numManagerTicks;
+
+    numManagerTicks = mCharacterManager->getNumQuietTicks(SIM_TICK_TIME);
+    if(numManagerTicks < numTicks) numTicks = numManagerTicks;
+
+    return numTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::skipQuietTicks(uint32_t numTicks)
+{
+    mNumSteps++;
+    updateReplay(numTicks);
+    mGameTime += SIM_TICK_TIME * numTicks;
+    advanceClock(numTicks);
+    mCharacterManager->skipQuietTicks(SIM_TICK_TIME, numTicks);
+    updateReplayCheckpoint();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::updateReplay(uint32_t numTicks)
+{
+    if(mReplay == nullptr)
+    {
+        return;
+    }
+
+    if(mReplay->isRecording())
+    {
+        mReplay->recordInput(mInput, numTicks);
+    }
+    else
+    {
+        mCharacterManager->setPacmanInput(mReplay->getInput());
+        mReplay->skipTicks(numTicks);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::updateReplayCheckpoint()
+{
+    if(mReplay == nullptr || !mReplay->isCheckpointDue())
+    {
+        return;
+    }
+
+    if(mReplay->isRecording())
+    {
+        mReplay->recordCheckpoint(getStateHash());
+    }
+    else
+    {
+        mReplay->checkCheckpoint(getStateHash());
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::pushRewindState()
+{
+    if(mRewind == nullptr)
+    {
+        return;
+    }
+
+    // zero the padding bytes, so only the state's values make up the delta
+    GameWorldState state;
+    memset(&state, 0, sizeof(state));
+    saveState(&state);
+
+    mRewind->push(&state);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::pushTickHash()
+{
+    if(mHashStream != nullptr)
+    {
+        mHashStream->push(getZobristHash());
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const float_t GameWorld::getInterpolation() const
+{
+    return (float_t)mTickTime / SIM_TICK_TIME;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::shutdown()
+{
+    mStatsManager->shutdown();
+    mEventManager->shutdown();
+
+    mTimerManager->shutdown();
+    mBoardManager->shutdown();
+    mFruitManager->shutdown();
+    mCharacterManager->shutdown();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::setInput(GameUtil::BoardDirection direction)
+{
+    mInput = direction;
+    if(mReplay == nullptr || mReplay->isRecording())
+    {
+        mCharacterManager->setPacmanInput(direction);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::setRandomSeed(const uint32_t seed)
+{
+    uint32_t prevRandom[NUM_STATE_RANDOM_WORDS];
+    mRandom->saveState(prevRandom);
+
+    mRandom->seed(seed);
+    updateRandomHash(prevRandom);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t GameWorld::getRangedRandom(const int32_t min, const int32_t max) const
+{
+    uint32_t prevRandom[NUM_STATE_RANDOM_WORDS];
+    mRandom->saveState(prevRandom);
+
+    int32_t value = mRandom->getRangedRandom(min, max);
+    updateRandomHash(prevRandom);
+    return value;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::updateRandomHash(const uint32_t* prevRandom) const
+{
+    uint32_t random[NUM_STATE_RANDOM_WORDS];
+    mRandom->saveState(random);
+
+    for(int32_t word = 0; word < NUM_STATE_RANDOM_WORDS; ++word)
+    {
+        mZobrist->update(ZobristHash::getKey(ZobristHash::Field::RANDOM, word), prevRandom[word], random[word]);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::saveState(GameWorldState* state) const
+{
+    state->applicationState = mApplicationState;
+    state->gameTime = mGameTime;
+    state->tickTime = mTickTime;
+    state->tick = mWheel->getTick();
+    mRandom->saveState(state->random);
+    state->zobristHash = mZobrist->getValue();
+
+    mStatsManager->saveState(&state->stats);
+    mEventManager->saveState(&state->events);
+    mTimerManager->saveState(&state->timers);
+    mBoardManager->saveState(&state->board);
+    mFruitManager->saveState(&state->fruit);
+    mCharacterManager->saveState(&state->characters);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::loadState(const GameWorldState* state)
+{
+    mApplicationState = (ApplicationState)state->applicationState;
+    mGameTime = state->gameTime;
+    mTickTime = state->tickTime;
+    mRandom->loadState(state->random);
+    loadClock(state->tick);
+
+    // the board rebuilds its pellet triggers from the level, so the stats go first
+    mStatsManager->loadState(&state->stats);
+    mEventManager->loadState(&state->events);
+    mTimerManager->loadState(&state->timers);
+    mBoardManager->loadState(&state->board);
+    mFruitManager->loadState(&state->fruit);
+    mCharacterManager->loadState(&state->characters);
+
+    // the hash was saved with the state, so it needn't be worked out again
+    mZobrist->setValue(state->zobristHash);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::cloneFrom(const GameWorld* world)
+{
+    GameWorldState state;
+    world->saveState(&state);
+    loadState(&state);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getStateHash() const
+{
+    return ZobristHash::fold(mZobrist->getValue());
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint64_t GameWorld::getZobristHash() const
+{
+    return mZobrist->getValue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint64_t GameWorld::computeZobristHash() const
+{
+    GameWorldState state;
+    saveState(&state);
+
+    return ZobristHash::compute(&state);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::updateZobristHash(const uint32_t key, const uint32_t oldValue, const uint32_t newValue) const
+{
+    mZobrist->update(key, oldValue, newValue);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::recordReplay(Replay* replay, const uint32_t seed)
+{
+    stopReplay();
+
+    setRandomSeed(seed);
+    replay->startRecording(mBoardManager->getBoardChecksum(), seed);
+    mReplay = replay;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t GameWorld::playReplay(Replay* replay)
+{
+    stopReplay();
+
+    if(replay->getBuildHash() != Replay::getCurrentBuildHash() || replay->getBoardHash() != mBoardManager->getBoardChecksum())
+    {
+        return false;
+    }
+
+    setRandomSeed(replay->getSeed());
+    replay->startPlayback();
+    mReplay = replay;
+
+    mCharacterManager->setPacmanInput(mReplay->getInput());
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t GameWorld::verifyReplay(Replay* replay, ReplayResult* result)
+{
+    // settle any pending events so the world is sitting in the menu, then start
+    update(0);
+    startGame();
+    if(!playReplay(replay))
+    {
+        return false;
+    }
+
+    // the first update only moves us from the menu into the game
+    update(0);
+    fastForward(replay->getNumTicks() * SIM_TICK_TIME);
+    stopReplay();
+
+    result->score = getScore();
+    result->level = getLevel();
+    result->stateHash = getStateHash();
+    result->numTicks = replay->getTick();
+    result->firstDivergentTick = replay->getFirstDivergentTick();
+
+    // a game can end differently without a checkpoint noticing, then it's the end that differs
+    bool8_t isEndMatch = result->numTicks == replay->getNumTicks() && result->score == replay->getFinalScore() &&
+        result->level == replay->getFinalLevel() && result->stateHash == replay->getFinalStateHash();
+    if(!isEndMatch && result->firstDivergentTick == TICKS_UNLIMITED)
+    {
+        result->firstDivergentTick = result->numTicks;
+    }
+    result->isMatch = result->firstDivergentTick == TICKS_UNLIMITED;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::stopReplay()
+{
+    if(mReplay == nullptr)
+    {
+        return;
+    }
+
+    // a played back game is left with the replay's last input, so it ends in the recorded state
+    if(mReplay->isRecording())
+    {
+        mReplay->stopRecording(getScore(), getLevel(), getStateHash());
+    }
+
+    mReplay = nullptr;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::setRewindBuffer(RewindBuffer* rewind)
+{
+    mRewind = rewind;
+    if(mRewind != nullptr)
+    {
+        mRewind->clear();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t GameWorld::rewindTick()
+{
+    GameWorldState state;
+    if(mRewind == nullptr || !mRewind->stepBack(&state))
+    {
+        return false;
+    }
+
+    // the game no longer follows the replay's input
+    stopReplay();
+
+    loadState(&state);
+
+    if(mHashStream != nullptr)
+    {
+        mHashStream->pop();
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::setHashStream(HashStream* stream)
+{
+    mHashStream = stream;
+    if(mHashStream != nullptr)
+    {
+        mHashStream->clear();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const GameWorld::ApplicationState GameWorld::getApplicationState() const
+{
+    return mApplicationState;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GameWorld::setApplicationState(const GameWorld::ApplicationState state)
+{
+    mZobrist->update(ZobristHash::getKey(ZobristHash::Field::APPLICATION_STATE), mApplicationState, state);
+    mApplicationState = state;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t GameWorld::isInGame() const
+{
+    return mApplicationState == ApplicationState::IN_GAME;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t GameWorld::getScore() const
+{
+    return mStatsManager->getScore();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t GameWorld::getLevel() const
+{
+    return mStatsManager->getLevel();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t GameWorld::getLives() const
+{
+    return mStatsManager->getLives();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getGameTime() const
+{
+    return mGameTime;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getNumSteps() const
+{
+    return mNumSteps;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getNumTargetEvaluations() const
+{
+    return mCharacterManager->getNumTargetEvaluations();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t GameWorld::getNumSkippedTargetEvaluations() const
+{
+    return mCharacterManager->getNumSkippedTargetEvaluations();
+}
+
+//-----------------------------------------------------------------------------------------
+
+StatsManager* GameWorld::getStatsManager()
+{
+    return mStatsManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+EventManager* GameWorld::getEventManager()
+{
+    return mEventManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+TimerManager* GameWorld::getTimerManager()
+{
+    return mTimerManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+BoardManager* GameWorld::getBoardManager()
+{
+    return mBoardManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+FruitManager* GameWorld::getFruitManager()
+{
+    return mFruitManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+CharacterManager* GameWorld::getCharacterManager()
+{
+    return mCharacterManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const StatsManager* GameWorld::getConstStatsManager() const
+{
+    return mStatsManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const EventManager* GameWorld::getConstEventManager() const
+{
+    return mEventManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TimerManager* GameWorld::getConstTimerManager() const
+{
+    return mTimerManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const BoardManager* GameWorld::getConstBoardManager() const
+{
+    return mBoardManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const FruitManager* GameWorld::getConstFruitManager() const
+{
+    return mFruitManager;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const CharacterManager* GameWorld::getConstCharacterManager() const
+{
+    return mCharacterManager;
+}
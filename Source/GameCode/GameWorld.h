@@ -0,0 +1,485 @@
+
+#define SIM_TICK_TIME   16      // milliseconds simulated by each tick of a game in progress
+#define DEFAULT_RANDOM_SEED 1
+#define NUM_LEVEL_STATES    255     // levels whose start states are kept, the kill screen and past it always reset
+#define NUM_OWNER_TIMERS    8       // timers each GameWorld::TimerOwner can have set at once, by ID
+
+class StatsManager;
+class EventManager;
+class TimerManager;
+class BoardManager;
+class FruitManager;
+class CharacterManager;
+class RandomGenerator;
+class Replay;
+class RewindBuffer;
+class ZobristHash;
+class HashStream;
+class TimerWheel;
+struct GameWorldState;
+struct ReplayResult;
+
+/*
+ * Entry point for the game simulation.
+ *
+ * Owns every gameplay manager and the application state
+ * for one game, so any number of worlds can run side by
+ * side in the same process without sharing state.
+ *
+ * Managers and characters are handed a pointer to their
+ * world when they are created, and reach each other only
+ * through it. They are given a const world, so they can
+ * call const getters and post events, but can't update
+ * other managers directly. Only the EventManager holds a
+ * non-const world, since it calls handlers on the others.
+ *
+ * The world steps the managers in the same order as the
+ * game loop, without any rendering, audio, or window
+ * handling. CGame drives it from the desktop loop, and
+ * headless tools drive it directly with scripted input.
+ *
+ * A game in progress is always stepped in fixed ticks of
+ * SIM_TICK_TIME, however much time each update() is given,
+ * and character movement is integer, so the same input
+ * plays out the same way on every machine. Time left over
+ * between ticks is carried to the next update(), and is
+ * what rendering interpolates across.
+ *
+ * Each world also owns its random number generator, so
+ * worlds given the same seed and input play the same game
+ * no matter what other worlds in the process are doing.
+ *
+ * Every timer in the game, from the pauses between levels
+ * to the ghost phases, scared ghosts, and fruit, is set on
+ * the world's one TimerWheel, for the tick it falls due on.
+ * The world hands each timer back to the manager that set
+ * it, at that manager's point in the tick, so nothing is
+ * counted down on ticks where no timer falls due.
+ *
+ * Since a game is decided by its seed and the input of each
+ * tick, a world can record a game into a Replay, and play
+ * a recorded game back exactly. It can also keep the last
+ * few seconds of a game in a RewindBuffer, and step back
+ * through them, and keep a hash of every tick in a HashStream,
+ * to find where two runs of a game part ways.
+ */
+class GameWorld
+{
+public:
+
+    /*
+     * Enumeration of the application states.
+     */
+    typedef enum
+    {
+        IN_MENU,
+        IN_GAME
+    }ApplicationState;
+
+    /*
+     * Enumeration of the managers that set timers on the world's
+     * TimerWheel, in the order their timers are handled each tick.
+     * Each owner has its own NUM_OWNER_TIMERS timer IDs.
+     */
+    typedef enum
+    {
+        TIMER_MANAGER,
+        FRUIT_MANAGER,
+        CHARACTER_MANAGER,
+
+        NUM_TIMER_OWNERS
+    }TimerOwner;
+
+    /*
+     * Creates this world's managers.
+     */
+    GameWorld();
+
+    /*
+     * Destroys this world's managers. Call shutdown() first.
+     */
+    ~GameWorld();
+
+    /*
+     * Initializes the gameplay managers and loads the board, and
+     * keeps level 1's start state, see startLevel(). The world
+     * starts on the game over screen.
+     */
+    void init();
+
+    /*
+     * Posts the events to start a new game from the menu. The
+     * game begins on the next call to update().
+     */
+    void startGame() const;
+
+    /*
+     * Starts level 1 of a new game if 'isNewGame', otherwise the
+     * level after the current one. Called by the EventManager.
+     *
+     * Apart from what carries over (the game time, random generator,
+     * high score, pacman's input, and between levels the score,
+     * lives, and fruit collected), a level starts in the same state
+     * every time. The first time a level starts, every manager is
+     * reset, and the state they're left in is kept, along with its
+     * Zobrist hash; level 1's is kept by init(). After that, the
+     * level starts by loading the kept state, with each manager
+     * keeping its share of what carries over and updating the hash
+     * for it, rather than resetting every manager and character.
+     */
+    void startLevel(const bool8_t isNewGame);
+
+    /*
+     * Drops the kept level start states, so each level next starts
+     * by resetting every manager.
+     */
+    void clearLevelStates();
+
+    /*
+     * Handles queued events while in the menu. While a game is in
+     * progress, runs as many ticks as fit in the time given plus
+     * the time carried over from the last update. Either way, ends
+     * the frame, see EventManager::endFrame().
+     */
+    void update(DWORD milliseconds);
+
+    /*
+     * Same as update(), with the same result, but finds runs of
+     * ticks where nothing happens except characters moving straight
+     * on and timers counting down, and steps over each run at once.
+     * The run ends at the next tick where something does happen:
+     * a character reaches or crosses into a tile, a timer crosses a
+     * threshold, an event is queued, and so on. That tick is run
+     * normally.
+     *
+     * Input is only read at the start of each call, so this is for
+     * batch and fast-forward play, where input is held for many
+     * frames. Characters are only interpolated over the last tick.
+     */
+    void fastForward(DWORD milliseconds);
+
+    /*
+     * Returns how far the world is between its last tick and its
+     * next one, from 0 to 1. Characters are drawn this far from
+     * their position before the last tick to their current one.
+     */
+    const float_t getInterpolation() const;
+
+    /*
+     * Shuts down the gameplay managers.
+     */
+    void shutdown();
+
+    /*
+     * Sets the direction the player is holding. INVAL means
+     * no direction is held. Ignored while playing a replay.
+     */
+    void setInput(GameUtil::BoardDirection direction);
+
+    /*
+     * Seeds this world's random number generator. Worlds start
+     * seeded with DEFAULT_RANDOM_SEED.
+     */
+    void setRandomSeed(const uint32_t seed);
+
+    /*
+     * Returns a random integer from 'min' up to, but not including,
+     * 'max', drawn from this world's generator. Const like posting
+     * an event, so characters and managers can draw numbers.
+     */
+    const int32_t getRangedRandom(const int32_t min, const int32_t max) const;
+
+    /*
+     * Copies everything that changes as the world plays out to
+     * 'state', or back in from it, see WorldState.h. Loading
+     * puts the world exactly where it was when the state was
+     * saved, so it plays on the same way for the same input.
+     *
+     * The state is a flat buffer with no pointers into the world,
+     * so it can be loaded into any world of this build that was
+     * initialized with the same board.
+     */
+    void saveState(GameWorldState* state) const;
+    void loadState(const GameWorldState* state);
+
+    /*
+     * Puts this world in the same state as 'world'. Both worlds
+     * must have been initialized with the same board.
+     */
+    void cloneFrom(const GameWorld* world);
+
+    /*
+     * Returns a hash of the world's gameplay state, to check that
+     * two worlds play on the same way without comparing them. It
+     * is the Zobrist hash folded to 32 bits, so it only changes
+     * with the fields that decide how the game plays, see
+     * ZobristHash.h, not with how the state is laid out. Replay
+     * checkpoints are kept with it.
+     */
+    const uint32_t getStateHash() const;
+
+    /*
+     * Returns the 64-bit Zobrist hash of the world's state, see
+     * ZobristHash.h. It is kept up to date as the world plays, so
+     * this costs nothing, and is meant for search and for spotting
+     * states seen before.
+     */
+    const uint64_t getZobristHash() const;
+
+    /*
+     * Works out the Zobrist hash from scratch, to check the one
+     * kept up to date against.
+     */
+    const uint64_t computeZobristHash() const;
+
+    /*
+     * Changes the field of the Zobrist hash with key 'key' from
+     * 'oldValue' to 'newValue', see ZobristHash::getKey(). Called
+     * by managers and characters as they change the fields the
+     * hash covers. Const like posting an event.
+     */
+    void updateZobristHash(const uint32_t key, const uint32_t oldValue, const uint32_t newValue) const;
+
+    /*
+     * Sets timer 'id' of 'owner' to fall due on 'tick', in place of
+     * any it had set, or cancels it if 'tick' is 0. On that tick,
+     * the world calls the owner's handleTimer() with 'id'. Const
+     * like posting an event.
+     *
+     * The timers aren't part of the world's state: each owner
+     * keeps what it needs to set them again when a state is loaded.
+     */
+    void setTimer(const TimerOwner owner, const int32_t id, const uint32_t tick) const;
+
+    /*
+     * Returns the world's clock, the number of ticks since the
+     * current level started, which timers are set on.
+     */
+    const uint32_t getTick() const;
+
+    /*
+     * Seeds the world with 'seed', and records the input of every
+     * tick of the next game into 'replay'. Call after startGame(),
+     * before the game's first tick.
+     *
+     * Recording stops when the game ends, or on stopReplay(), and
+     * saves the final score and state hash into the replay.
+     */
+    void recordReplay(Replay* replay, const uint32_t seed);
+
+    /*
+     * Seeds the world from 'replay', and plays the next game with
+     * the replay's input in place of setInput(). Call before or
+     * after startGame(), before the game's first tick. Returns false,
+     * without playing, if the replay was recorded by a different
+     * build or on a different board.
+     *
+     * Playback stops when the game ends, or on stopReplay().
+     */
+    bool8_t playReplay(Replay* replay);
+
+    /*
+     * Plays 'replay' back from start to end, fast forwarding, and
+     * fills in 'result' with how the game ended and where, if
+     * anywhere, it played back differently from the recording.
+     * The world must be in the menu. Returns
+     * false, as playReplay(), if the replay can't be played.
+     *
+     * With no rendering and most ticks stepped over, a game plays
+     * back in a few milliseconds, see the pacsim -replay flag.
+     */
+    bool8_t verifyReplay(Replay* replay, ReplayResult* result);
+
+    /*
+     * Stops recording or playing back a replay. After playback,
+     * the player's input takes over from the next setInput().
+     */
+    void stopReplay();
+
+    /*
+     * Keeps the state of every tick of each game in 'rewind', or
+     * stops keeping them if 'rewind' is null. The buffer is cleared
+     * as each game starts. While a buffer is kept, fastForward()
+     * runs every tick rather than stepping over quiet ones.
+     */
+    void setRewindBuffer(RewindBuffer* rewind);
+
+    /*
+     * Puts the world back in the state of the tick before the last
+     * one kept in the rewind buffer, and drops the last one. Stops
+     * any replay being recorded or played back. Returns false if
+     * there is no earlier tick to go back to.
+     */
+    bool8_t rewindTick();
+
+    /*
+     * Keeps the hash of every tick of each game in 'stream', or
+     * stops keeping them if 'stream' is null. The stream is cleared
+     * as each game starts, and loses its last tick on each
+     * rewindTick(). While a stream is kept, fastForward() runs every
+     * tick rather than stepping over quiet ones.
+     */
+    void setHashStream(HashStream* stream);
+
+    /*
+     * Getter and setter for the application state. The state
+     * is changed by the EventManager as games start and end, and
+     * the setter keeps the world's Zobrist hash up to date.
+     */
+    const ApplicationState getApplicationState() const;
+    void setApplicationState(const ApplicationState state);
+
+    /*
+     * Returns true while a game is in progress (not in the menu).
+     */
+    const bool8_t isInGame() const;
+
+    /*
+     * Getters for the current game's stats.
+     */
+    const int32_t getScore() const;
+    const int32_t getLevel() const;
+    const int32_t getLives() const;
+
+    /*
+     * Returns the game clock, the milliseconds of play this world
+     * has simulated (a whole number of ticks). Animations are
+     * derived from it when drawn, rather than stepped every frame.
+     */
+    const uint32_t getGameTime() const;
+
+    /*
+     * Returns the number of steps this world has taken: one for
+     * every tick run, and one for every run of quiet ticks that
+     * fastForward() stepped over. For benchmarking.
+     */
+    const uint32_t getNumSteps() const;
+
+    /*
+     * Returns the number of ghost target tile evaluations made,
+     * and skipped, in this world. For benchmarking.
+     */
+    const uint32_t getNumTargetEvaluations() const;
+    const uint32_t getNumSkippedTargetEvaluations() const;
+
+    /*
+     * Getters for this world's managers. The const versions
+     * are for const getters and posting events; the others
+     * are for the EventManager and the game loop.
+     */
+    StatsManager* getStatsManager();
+    EventManager* getEventManager();
+    TimerManager* getTimerManager();
+    BoardManager* getBoardManager();
+    FruitManager* getFruitManager();
+    CharacterManager* getCharacterManager();
+
+    const StatsManager* getConstStatsManager() const;
+    const EventManager* getConstEventManager() const;
+    const TimerManager* getConstTimerManager() const;
+    const BoardManager* getConstBoardManager() const;
+    const FruitManager* getConstFruitManager() const;
+    const CharacterManager* getConstCharacterManager() const;
+
+private:
+
+    /*
+     * Handles queued events, then advances the clock and updates
+     * the board, fruit, and characters by one tick, each after its
+     * timers that fall due.
+     */
+    void tick();
+
+    /*
+     * Moves the clock on by 'numTicks': to the next tick, or over
+     * a run of quiet ticks where no timer falls due.
+     */
+    void advanceClock(const uint32_t numTicks);
+
+    /*
+     * Hands each timer of 'owner' that falls due on this tick back
+     * to it.
+     */
+    void updateTimers(const TimerOwner owner);
+
+    /*
+     * Drops every timer, and sets the clock to 'tick', for the
+     * managers to set their timers again as a state is loaded.
+     */
+    void loadClock(const uint32_t tick);
+
+    /*
+     * Returns the number of ticks, from now, that fastForward()
+     * can step over at once: ticks with no timer falling due, and
+     * which each manager counts as quiet.
+     */
+    const uint32_t getNumQuietTicks() const;
+
+    /*
+     * Steps over 'numTicks' quiet ticks at once.
+     */
+    void skipQuietTicks(uint32_t numTicks);
+
+    /*
+     * Resets every manager for the start of a level, see startLevel().
+     */
+    void resetManagers(const bool8_t isNewGame);
+
+    /*
+     * Keeps the world's state as the start state of 'level'.
+     */
+    void keepLevelState(const int32_t level);
+
+    /*
+     * Records the input of the next 'numTicks' ticks into the
+     * replay, or plays it back from the replay.
+     */
+    void updateReplay(uint32_t numTicks);
+
+    /*
+     * At each checkpoint tick, records the state hash into the
+     * replay, or checks it against the replay's.
+     */
+    void updateReplayCheckpoint();
+
+    /*
+     * Adds the state of the tick just run to the rewind buffer.
+     */
+    void pushRewindState();
+
+    /*
+     * Adds the hash of the tick just run to the hash stream.
+     */
+    void pushTickHash();
+
+    /*
+     * Updates the Zobrist hash for the random generator moving
+     * on from the words in 'prevRandom'.
+     */
+    void updateRandomHash(const uint32_t* prevRandom) const;
+
+    StatsManager* mStatsManager;
+    EventManager* mEventManager;
+    TimerManager* mTimerManager;
+    BoardManager* mBoardManager;
+    FruitManager* mFruitManager;
+    CharacterManager* mCharacterManager;
+
+    RandomGenerator* mRandom;
+    Replay* mReplay;                    // replay being recorded or played back, if any
+    RewindBuffer* mRewind;              // history of the game in progress, if kept
+    ZobristHash* mZobrist;              // hash of the state, kept up to date as fields change
+    HashStream* mHashStream;            // hash of every tick of the game in progress, if kept
+
+    TimerWheel* mWheel;                 // every manager's timers, on the world's clock
+    uint32_t* mTimerHandles;            // TimerHandle of each owner's timers, NUM_OWNER_TIMERS per owner
+
+    GameWorldState** mLevelStates;      // start state of each level, once it has been started
+
+    GameUtil::BoardDirection mInput;    // direction given to setInput()
+
+    ApplicationState mApplicationState;
+    uint32_t mGameTime;         // advances only while a game is in progress
+    uint32_t mTickTime;         // time given to update() that hasn't been ticked yet
+    uint32_t mNumSteps;
+};
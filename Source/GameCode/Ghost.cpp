@@ -2,16 +2,14 @@
 #define GHOST_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
-#include "..\\Framework\\random.h"
+#include "../Framework/baseTypes.h"
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "Character.h"
 #include "Ghost.h"
 
@@ -23,11 +21,27 @@
 #include "BoardManager.h"
 #include "CharacterManager.h"
 
+#include "EventManager.h"
+
 #include "StatsManager.h"
 
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
 
-Ghost::Ghost(const Tile* spawnTile, const GameUtil::CharacterID id) :
-    Character(spawnTile, id)
+Ghost::Ghost(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id) :
+    Character(world, spawnTile, id),
+    mTargetTile(TILE_INVAL),
+    mTargetState(GhostTargetingState::SCATTER),
+    mCurrentPhase(GhostTargetingState::SCATTER),
+    mScaredTimer(0),
+    mScaredTimerStart(0),
+    mIsInGhostHome(false),
+    mIsScared(false),
+    mIsFlaggedForReverse(false),
+    mNumTargetChecks(0),
+    mNumTargetEvaluations(0)
 {
 }
 
@@ -38,22 +52,23 @@ void Ghost::reset()
     Character::reset();
 
     // reset booleans
-    mIsInGhostHome = false;
-    mIsScared = false;
-    mIsFlaggedForReverse = false;
+    setInGhostHome(false);
+    setScared(false);
+    setFlaggedForReverse(false);
 
     // reset targeting pahse
-    mCurrentPhase = GhostTargetingState::SCATTER;
-    mTargetState = mCurrentPhase;
+    setCurrentPhase(GhostTargetingState::SCATTER);
+    setTargetState(mCurrentPhase);
+    setTargetTile(TILE_INVAL);      // chosen when a decision needs it
 
     // save stats from stats manager for the new level so we don't spam request them later
-    const StatsManager* smInstance = StatsManager::ConstInstace();
+    const StatsManager* smInstance = mWorld->getConstStatsManager();
     mGhostSpeed = smInstance->getGhostSpeed();
     mGhostSpeedScared = smInstance->getGhostSpeedScared();
     mGhostSpeedTunnel = smInstance->getGhostSpeedTunnel();
 
     // reset timers
-    mScaredTimer = 0;
+    setScaredTimer(0);
     mScaredDuration = smInstance->getGhostScaredTime();
     mFlashThreshold = smInstance->getGhostFlashTime();
 
@@ -69,72 +84,120 @@ void Ghost::resetFromDeath()
     // resetting from pacman death
     Character::resetFromDeath();
 
-    mIsInGhostHome = false;
-    mIsScared = false;
-    mIsFlaggedForReverse = false;
+    setInGhostHome(false);
+    setScared(false);
+    setFlaggedForReverse(false);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::saveState(CharacterState* state) const
+{
+    Character::saveState(state);
+
+    state->targetTile = mTargetTile;
+    state->targetState = mTargetState;
+    state->currentPhase = mCurrentPhase;
+    state->scaredTimer = mScaredTimer;
+    state->scaredTimerStart = mScaredTimerStart;
+    state->ghostSpeed = mGhostSpeed;
+    state->ghostSpeedScared = mGhostSpeedScared;
+    state->ghostSpeedTunnel = mGhostSpeedTunnel;
+    state->scaredDuration = mScaredDuration;
+    state->flashThreshold = mFlashThreshold;
+    state->isInGhostHome = mIsInGhostHome;
+    state->isScared = mIsScared;
+    state->isFlaggedForReverse = mIsFlaggedForReverse;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::loadState(const CharacterState* state)
+{
+    Character::loadState(state);
+
+    mTargetTile = state->targetTile;
+    mTargetState = (GhostTargetingState)state->targetState;
+    mCurrentPhase = (GhostTargetingState)state->currentPhase;
+    mScaredTimer = state->scaredTimer;
+    mScaredTimerStart = state->scaredTimerStart;
+    mGhostSpeed = state->ghostSpeed;
+    mGhostSpeedScared = state->ghostSpeedScared;
+    mGhostSpeedTunnel = state->ghostSpeedTunnel;
+    mScaredDuration = state->scaredDuration;
+    mFlashThreshold = state->flashThreshold;
+    mIsInGhostHome = state->isInGhostHome;
+    mIsScared = state->isScared;
+    mIsFlaggedForReverse = state->isFlaggedForReverse;
+
+    // the world's timers are cleared as a state is loaded
+    setScaredTimerDue();
 }
 
 //-----------------------------------------------------------------------------------------
 
-void Ghost::updateTimers(DWORD milliseconds)
+void Ghost::updateMovement(DWORD milliseconds)
 {
     if(!mIsPaused)
     {
-        // update scared timer
-        if(mIsScared)
-        {
-            if(mScaredTimer > 0)
-            {
-                mScaredTimer -= milliseconds;
-                if(mAnimChunkID != GameUtil::AnimChunkID::ANIM_GHOST_FLASHING && mScaredTimer < mFlashThreshold)
-                {
-                    flash();
-                }
-            }
-            else
-            {
-                unscare();
-            }
-        }
+        // the target tile is only chosen when a decision needs it, see chooseNeighborClosestToTarget
+        mNumTargetChecks++;
+        Character::updateMovement(milliseconds);
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void Ghost::updateMovement(DWORD milliseconds)
+void Ghost::skipQuietTicks(DWORD tickTime, uint32_t numTicks)
 {
     if(!mIsPaused)
     {
-        chooseTargetTile();
-        Character::updateMovement(milliseconds);
+        mNumTargetChecks += numTicks;
     }
+
+    Character::skipQuietTicks(tickTime, numTicks);
 }
 
 //-----------------------------------------------------------------------------------------
 
-void Ghost::updateAnimation(DWORD milliseconds)
+void Ghost::handleScaredTimer()
 {
-    // update animation frame
-    Character::updateAnimation(milliseconds);
+    // the timer counts down on every update that starts above 0, this one included
+    uint32_t scaredTimer = GameUtil::Utilities::countDown(mScaredTimer, SIM_TICK_TIME, mWorld->getTick() - 1 - mScaredTimerStart);
+    if(scaredTimer > 0)
+    {
+        setScaredTimer(scaredTimer - SIM_TICK_TIME);
+        if(mAnimChunkID != GameUtil::AnimChunkID::ANIM_GHOST_FLASHING && mScaredTimer < mFlashThreshold)
+        {
+            flash();
+        }
+    }
+    else
+    {
+        unscare();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
 
-    // ghost can use its targeting state to set its animation chunk ID
+const GameUtil::AnimChunkID Ghost::getAnimChunkID() const
+{
+    // ghost can use its targeting state to pick its animation chunk
     //      the animation chunk is the region of the spritesheet from which openGL will draw the ghost's quad
     switch(mTargetState)
     {
         // if chase or scatter, we display the base ghost
         case GhostTargetingState::CHASE: case GhostTargetingState::SCATTER:
-            mAnimChunkID = static_cast<GameUtil::AnimChunkID>(mCharacterID);
-            break;
+            return static_cast<GameUtil::AnimChunkID>(mCharacterID);
 
         // if dead, we have to check if we're also in the ghost house (base ghost if so, else dead ghost)
         case GhostTargetingState::DEAD:
-            if(mIsInGhostHome) mAnimChunkID = static_cast<GameUtil::AnimChunkID>(mCharacterID);
-            else mAnimChunkID = GameUtil::AnimChunkID::ANIM_GHOST_DEAD;
-            break;
+            if(mIsInGhostHome) return static_cast<GameUtil::AnimChunkID>(mCharacterID);
+            else return GameUtil::AnimChunkID::ANIM_GHOST_DEAD;
 
         // default cases would be SCARED and FLASHING animation, which are set elsewhere
         default:
-            break;
+            return mAnimChunkID;
     }
 }
 
@@ -152,7 +215,7 @@ void Ghost::updateSpeed()
 
             // chase or scatter has to take into account the tile type
         case GhostTargetingState::CHASE: case GhostTargetingState::SCATTER:
-            if(mCurrTile->isTunnel())
+            if(mGrid->isTunnel(mCurrTile))
             {
                 mSpeed = mBaseSpeed * mGhostSpeedTunnel;
             }
@@ -183,6 +246,9 @@ void Ghost::updateSpeed()
 
 void Ghost::chooseTargetTile()
 {
+    // the ghost types work out their chase targets in mTargetTile, so the hash is updated once they're done
+    TileIndex prevTargetTile = mTargetTile;
+
     switch(mTargetState)
     {
         // chase behavior, run ghost's specific targeting method
@@ -192,18 +258,20 @@ void Ghost::chooseTargetTile()
 
         // scatter behavior, target ghost's home corner
         case SCATTER:
-            mTargetTile = BoardManager::ConstInstace()->getGhostHomeTile(mCharacterID);
+            mTargetTile = mWorld->getConstBoardManager()->getGhostHomeTile(mCharacterID);
             break;
 
         // dead, target ghost home
         case DEAD:
-            mTargetTile = BoardManager::ConstInstace()->getGhostHomeTile(GameUtil::CharacterID::PACMAN);
+            mTargetTile = mWorld->getConstBoardManager()->getGhostHomeTile(GameUtil::CharacterID::PACMAN);
             break;
 
         // scared or flashing, don't update target (has no bearing on navigation anyways)
         default:
             break;
     }
+
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_TARGET_TILE, mCharacterID), prevTargetTile, mTargetTile);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -217,27 +285,27 @@ void Ghost::chooseNextTile()
     else
     {
         // how the ghost chooses its next tile depends on the current tile's type
-        switch(mCurrTile->getTraverseType())
+        switch(mGrid->getTraverseType(mCurrTile))
         {
-            case Tile::TileTraverseType::TRAVERSABLE:
-            case Tile::TileTraverseType::GHOST_TRAVERSABLE:
-            case Tile::TileTraverseType::TUNNEL:
+            case TileGrid::TileTraverseType::TRAVERSABLE:
+            case TileGrid::TileTraverseType::GHOST_TRAVERSABLE:
+            case TileGrid::TileTraverseType::TUNNEL:
                 handleBaseTraversable();
                 break;
 
-            case Tile::TileTraverseType::INTERSECTION:
+            case TileGrid::TileTraverseType::INTERSECTION:
                 handleIntersection();
                 break;
 
-            case Tile::TileTraverseType::NO_UP_INTERSECTION:
+            case TileGrid::TileTraverseType::NO_UP_INTERSECTION:
                 handleNoUpIntersection();
                 break;
 
-            case Tile::TileTraverseType::GHOST_HOME_ENTER:
+            case TileGrid::TileTraverseType::GHOST_HOME_ENTER:
                 handleGhostHomeEnter();
                 break;
 
-            case Tile::TileTraverseType::GHOST_HOME_EXIT:
+            case TileGrid::TileTraverseType::GHOST_HOME_EXIT:
                 handleGhostHomeExit();
                 break;
 
@@ -254,7 +322,7 @@ void Ghost::flagForDirectionReverse()
     // can only reverse direction if outside ghost home
     if(!mIsInGhostHome && mIsAlive)
     {
-        mIsFlaggedForReverse = true;
+        setFlaggedForReverse(true);
     }
 }
 
@@ -262,10 +330,10 @@ void Ghost::flagForDirectionReverse()
 
 void Ghost::setChasing()
 {
-    mCurrentPhase = GhostTargetingState::CHASE;
+    setCurrentPhase(GhostTargetingState::CHASE);
     if(mIsAlive && !mIsScared)
     {
-        mTargetState = mCurrentPhase;
+        setTargetState(mCurrentPhase);
     }
 }
 
@@ -273,10 +341,10 @@ void Ghost::setChasing()
 
 void Ghost::setScatter()
 {
-    mCurrentPhase = GhostTargetingState::SCATTER;
+    setCurrentPhase(GhostTargetingState::SCATTER);
     if(mIsAlive && !mIsScared)
     {
-        mTargetState = mCurrentPhase;
+        setTargetState(mCurrentPhase);
     }
 }
 
@@ -284,12 +352,16 @@ void Ghost::setScatter()
 
 void Ghost::scare()
 {
-    mIsScared = true;
-    mScaredTimer = mScaredDuration;
-    mTargetState = GhostTargetingState::SCARED;
+    // a scared ghost keeps the target it had when it was scared, in case it
+    // passes the ghost home entrance before it's unscared
+    chooseTargetTile();
+
+    setScared(true);
+    setTargetState(GhostTargetingState::SCARED);
     mAnimChunkID = GameUtil::AnimChunkID::ANIM_GHOST_SCARED;
+    setScaredTimer(mScaredDuration);        // set once the ghost isn't flashing, as that decides when it's due
 
-    mAnimFrame = 0;
+    restartAnimation();
 
     flagForDirectionReverse();
 }
@@ -300,8 +372,11 @@ void Ghost::flash()
 {
     if(mIsScared)
     {
-        mAnimFrame = 0;
+        restartAnimation();
         mAnimChunkID = GameUtil::AnimChunkID::ANIM_GHOST_FLASHING;
+
+        // from here, the scared timer is only due when it runs out
+        setScaredTimerDue();
     }
 }
 
@@ -312,15 +387,29 @@ void Ghost::unscare()
     if(mIsScared)
     {
         // unscare ghost, enter current phase
-        mIsScared = false;
-        mScaredTimer = 0;
-        mTargetState = mCurrentPhase;
-        mAnimFrame = 0;
+        setScared(false);
+        setScaredTimer(0);
+        setTargetState(mCurrentPhase);
+        restartAnimation();
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
+const uint32_t Ghost::getNumTargetEvaluations() const
+{
+    return mNumTargetEvaluations;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Ghost::getNumSkippedTargetEvaluations() const
+{
+    return mNumTargetChecks - mNumTargetEvaluations;
+}
+
+//-----------------------------------------------------------------------------------------
+
 void Ghost::setLiving(bool8_t isAlive)
 {
     if(isAlive)
@@ -340,10 +429,10 @@ void Ghost::spawn()
     // can only spawn a ghost that is already dead and inside ghost home
     if(mIsInGhostHome)
     {
-        mIsAlive = true;
+        setAlive(true);
         if(!mIsScared)
         {
-            mTargetState = mCurrentPhase;
+            setTargetState(mCurrentPhase);
         }
     }
 }
@@ -357,9 +446,126 @@ void Ghost::kill()
     {
         // going back to ghost house
         unscare();
-        mIsAlive = false;
-        mTargetState = GhostTargetingState::DEAD;
+        setAlive(false);
+        setTargetState(GhostTargetingState::DEAD);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setTargetState(const GhostTargetingState state)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_TARGET_STATE, mCharacterID), mTargetState, state);
+    mTargetState = state;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t Ghost::isScaredTimerRunning() const
+{
+    return mIsScared && !mIsPaused;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setScaredTimerDue() const
+{
+    // due when the timer drops below the flash threshold, unless the ghost is flashing already, then when it runs out
+    uint32_t numTicks = TICKS_UNLIMITED;
+    if(isScaredTimerRunning())
+    {
+        if(mAnimChunkID != GameUtil::AnimChunkID::ANIM_GHOST_FLASHING)
+        {
+            numTicks = GameUtil::Utilities::getNumStepsToCross(mScaredTimer, mFlashThreshold, SIM_TICK_TIME);
+        }
+        if(numTicks == TICKS_UNLIMITED)
+        {
+            numTicks = GameUtil::Utilities::getNumStepsToRunOut(mScaredTimer, SIM_TICK_TIME);
+        }
+    }
+
+    // a timer that wraps past 0 never runs out, as before
+    mWorld->setTimer(GameWorld::TimerOwner::CHARACTER_MANAGER, mCharacterID,
+        numTicks != TICKS_UNLIMITED ? mScaredTimerStart + numTicks : 0);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Ghost::getScaredTimer() const
+{
+    if(!isScaredTimerRunning())
+    {
+        return mScaredTimer;
     }
+
+    return GameUtil::Utilities::countDown(mScaredTimer, SIM_TICK_TIME, mWorld->getTick() - mScaredTimerStart);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setScaredTimer(const uint32_t time)
+{
+    // a running timer counts down from the current tick, a stopped one is kept as of tick 0
+    uint32_t start = isScaredTimerRunning() ? mWorld->getTick() : 0;
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_SCARED_TIMER, mCharacterID), mScaredTimer, time);
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_SCARED_TIMER_START, mCharacterID), mScaredTimerStart, start);
+    mScaredTimer = time;
+    mScaredTimerStart = start;
+
+    setScaredTimerDue();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setInGhostHome(const bool8_t isInGhostHome)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_IN_HOME, mCharacterID), mIsInGhostHome, isInGhostHome);
+    mIsInGhostHome = isInGhostHome;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setTargetTile(const TileIndex tile)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_TARGET_TILE, mCharacterID), mTargetTile, tile);
+    mTargetTile = tile;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setCurrentPhase(const GhostTargetingState phase)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_PHASE, mCharacterID), mCurrentPhase, phase);
+    mCurrentPhase = phase;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setScared(const bool8_t isScared)
+{
+    // the scared timer stops or starts where it is now
+    uint32_t scaredTimer = getScaredTimer();
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_SCARED, mCharacterID), mIsScared, isScared);
+    mIsScared = isScared;
+    setScaredTimer(scaredTimer);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setPaused(const bool8_t isPaused)
+{
+    // the scared timer stops or starts where it is now
+    uint32_t scaredTimer = getScaredTimer();
+    Character::setPaused(isPaused);
+    setScaredTimer(scaredTimer);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Ghost::setFlaggedForReverse(const bool8_t isFlagged)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_REVERSE, mCharacterID), mIsFlaggedForReverse, isFlagged);
+    mIsFlaggedForReverse = isFlagged;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -391,22 +597,22 @@ const bool8_t Ghost::isInGhostHome() const
 
 void Ghost::reverseDirection()
 {
-    mIsFlaggedForReverse = false;
+    setFlaggedForReverse(false);
 
     // reverse facing direction
     switch(mFacingDirection)
     {
         case GameUtil::BoardDirection::UP:
-            mFacingDirection = GameUtil::BoardDirection::DOWN;
+            setFacingDirection(GameUtil::BoardDirection::DOWN);
             break;
         case GameUtil::BoardDirection::LEFT:
-            mFacingDirection = GameUtil::BoardDirection::RIGHT;
+            setFacingDirection(GameUtil::BoardDirection::RIGHT);
             break;
         case GameUtil::BoardDirection::DOWN:
-            mFacingDirection = GameUtil::BoardDirection::UP;
+            setFacingDirection(GameUtil::BoardDirection::UP);
             break;
         case GameUtil::BoardDirection::RIGHT:
-            mFacingDirection = GameUtil::BoardDirection::LEFT;
+            setFacingDirection(GameUtil::BoardDirection::LEFT);
             break;
     }
 
@@ -417,16 +623,16 @@ void Ghost::reverseDirection()
 
 void Ghost::handleBaseTraversable()
 {
-    const Tile* neighbor = nullptr;
+    TileIndex neighbor = TILE_INVAL;
     GameUtil::BoardDirection direction = GameUtil::BoardDirection::INVAL;
 
     // iterate through all directions, and pick the first traversable tile we find that is not our previous tile
     for(uint32_t directionInt = GameUtil::BoardDirection::UP; directionInt != GameUtil::BoardDirection::INVAL; ++directionInt)
     {
         direction = static_cast<GameUtil::BoardDirection>(directionInt);
-        neighbor = mCurrTile->getNeighbor(direction);
+        neighbor = mGrid->getNeighbor(mCurrTile, direction);
 
-        if(neighbor != mPrevTile && neighbor->isTraversable())
+        if(neighbor != mPrevTile && mGrid->isTraversable(neighbor))
         {
             nextTileChosen(neighbor, direction);
             break;
@@ -477,7 +683,7 @@ void Ghost::handleNoUpIntersection()
 
 void Ghost::handleGhostHomeEnter()
 {
-    mIsInGhostHome = false;     // just outside ghost home
+    setInGhostHome(false);      // just outside ghost home
 
     if(mIsAlive)
     {
@@ -487,7 +693,7 @@ void Ghost::handleGhostHomeEnter()
     else
     {
         // else, turn down into the ghost home
-        nextTileChosen(mCurrTile->getNeighbor(GameUtil::BoardDirection::DOWN), GameUtil::BoardDirection::DOWN);
+        nextTileChosen(mGrid->getNeighbor(mCurrTile, GameUtil::BoardDirection::DOWN), GameUtil::BoardDirection::DOWN);
     }
 }
 
@@ -495,56 +701,64 @@ void Ghost::handleGhostHomeEnter()
 
 void Ghost::handleGhostHomeExit()
 {
-    mIsInGhostHome = true;      // just inside ghost home
+    setInGhostHome(true);       // just inside ghost home
 
     if(mIsAlive)
     {
         // if alive, turn up out of the ghost home
-        nextTileChosen(mCurrTile->getNeighbor(GameUtil::BoardDirection::UP), GameUtil::BoardDirection::UP);
+        nextTileChosen(mGrid->getNeighbor(mCurrTile, GameUtil::BoardDirection::UP), GameUtil::BoardDirection::UP);
     }
     else
     {
         // if dead, continue left
-        nextTileChosen(mCurrTile->getNeighbor(GameUtil::BoardDirection::LEFT), GameUtil::BoardDirection::LEFT);
+        nextTileChosen(mGrid->getNeighbor(mCurrTile, GameUtil::BoardDirection::LEFT), GameUtil::BoardDirection::LEFT);
+
+        // a ghost that was killed is back inside the ghost home, so ask to be spawned again
+        //      it was already released by its pellet trigger, so it doesn't wait on one
+        //      (ghosts that haven't been released yet also pass through here, but aren't DEAD)
+        if(mTargetState == GhostTargetingState::DEAD)
+        {
+            postSpawnEvent();
+        }
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void Ghost::chooseNeighborClosestToTarget(GameUtil::BoardDirection skipDirection)
+void Ghost::postSpawnEvent() const
 {
-    float dist = 0.0f;
-    float minDist = FLT_MAX;
-    GameUtil::BoardDirection minDir = GameUtil::BoardDirection::INVAL;
-
-    const Tile* neighbor = nullptr;
-    GameUtil::BoardDirection direction = GameUtil::BoardDirection::INVAL;
-
-    // iterate through all directions, skip given direction
-    //      select direction that would put ghost closest to its target tile
-    for(uint32_t directionInt = GameUtil::BoardDirection::UP; directionInt != GameUtil::BoardDirection::INVAL; ++directionInt)
+    const EventManager* emInstance = mWorld->getConstEventManager();
+    switch(mCharacterID)
     {
-        direction = static_cast<GameUtil::BoardDirection>(directionInt);
-        if(direction == skipDirection) continue;
-
-        // if the current neighbor is not the previous tile and is traversable...
-        neighbor = mCurrTile->getNeighbor(direction);
-        if(neighbor != mPrevTile && neighbor->isGhostTraversable())
-        {
-            // check its distance, save direction of min values
-            //      since min is overwritten only on '<', ties are given priority via the order of the map
-            //      UP, LEFT, DOWN (RIGHT is never chosen in a tie because everything else is higher priority)
-            dist = neighbor->getSquareDistToTile(mTargetTile);
-            if(dist < minDist)
-            {
-                minDist = dist;
-                minDir = direction;
-            }
-        }
+        case GameUtil::CharacterID::GHOST_RED:
+            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_RED);
+            break;
+        case GameUtil::CharacterID::GHOST_PINK:
+            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_PINK);
+            break;
+        case GameUtil::CharacterID::GHOST_BLUE:
+            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_BLUE);
+            break;
+        case GameUtil::CharacterID::GHOST_ORANGE:
+            emInstance->postEvent(EventManager::GameEvent::SPAWN_GHOST_ORANGE);
+            break;
+        default:
+            break;
     }
+}
 
-    // we now have the direction that would put us closest to the target
-    nextTileChosen(mCurrTile->getNeighbor(minDir), minDir);
+//-----------------------------------------------------------------------------------------
+
+void Ghost::chooseNeighborClosestToTarget(GameUtil::BoardDirection skipDirection)
+{
+    // the target only matters here, so this is the only place it's updated during movement
+    chooseTargetTile();
+    mNumTargetEvaluations++;
+
+    // the direction that would put us closest to the target is precomputed for every decision tile
+    //      ties are given priority in the order UP, LEFT, DOWN (RIGHT is never chosen in a tie)
+    GameUtil::BoardDirection direction = mGrid->getDirectionClosestToTarget(mCurrTile, mPrevTile, skipDirection, mTargetTile);
+    nextTileChosen(mGrid->getNeighbor(mCurrTile, direction), direction);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -552,19 +766,19 @@ void Ghost::chooseNeighborClosestToTarget(GameUtil::BoardDirection skipDirection
 void Ghost::chooseRandomNeighbor()
 {
     // choose a random direction
-    GameUtil::BoardDirection randomDir = static_cast<GameUtil::BoardDirection>(getRangedRandom(GameUtil::BoardDirection::UP, GameUtil::BoardDirection::INVAL));
-    const Tile* randomTile = mCurrTile->getNeighbor(randomDir);
+    GameUtil::BoardDirection randomDir = static_cast<GameUtil::BoardDirection>(mWorld->getRangedRandom(GameUtil::BoardDirection::UP, GameUtil::BoardDirection::INVAL));
+    TileIndex randomTile = mGrid->getNeighbor(mCurrTile, randomDir);
 
     // if the direction is not valid for movement, cycle through each direction and choose the first
     // traversable direction that is not our previous direction
-    if(!randomTile->isTraversable() || randomTile == mPrevTile)
+    if(!mGrid->isTraversable(randomTile) || randomTile == mPrevTile)
     {
         for(uint32_t directionInt = GameUtil::BoardDirection::UP; directionInt != GameUtil::BoardDirection::INVAL; ++directionInt)
         {
             randomDir = static_cast<GameUtil::BoardDirection>(directionInt);
-            randomTile = mCurrTile->getNeighbor(randomDir);
+            randomTile = mGrid->getNeighbor(mCurrTile, randomDir);
 
-            if(randomTile != mPrevTile && randomTile->isTraversable())
+            if(randomTile != mPrevTile && mGrid->isTraversable(randomTile))
             {
                 break;
             }
@@ -576,12 +790,12 @@ void Ghost::chooseRandomNeighbor()
 
 //-----------------------------------------------------------------------------------------
 
-void Ghost::nextTileChosen(const Tile* next, GameUtil::BoardDirection direction)
+void Ghost::nextTileChosen(const TileIndex next, GameUtil::BoardDirection direction)
 {
-    mNextTile = next;
-    mPrevTile = mCurrTile;
+    setNextTile(next);
+    setPrevTile(mCurrTile);
 
-    mFacingDirection = direction;
+    setFacingDirection(direction);
 
-    mMovementState = MovementState::MOVING;
+    setMovementState(MovementState::MOVING);
 }
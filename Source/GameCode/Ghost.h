@@ -19,7 +19,7 @@ public:
         DEAD
     }GhostTargetingState;
 
-    Ghost(const Tile* spawnTile, const GameUtil::CharacterID id);
+    Ghost(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
 
     /*
     * Resets variables on the character for a new level.
@@ -33,24 +33,33 @@ public:
     virtual void resetFromDeath();
 
     /*
-     * If the ghost is flagged as scared, updates the 
-     * ghost's scared timer. When the timer reaches
-     * certain thresholds, it updates the ghost's
-     * animation state to flash, and then exit scared mode.
+     * As a Character, plus the ghost's targeting, scared
+     * timer, and speeds.
      */
-    virtual void updateTimers(DWORD milliseconds);
+    virtual void saveState(CharacterState* state) const;
+    virtual void loadState(const CharacterState* state);
 
     /*
-     * Chooses the ghost's target tile, then updates
-     * movement as normal for a Character.
+     * Updates movement as normal for a Character. The
+     * ghost's target tile is chosen lazily, only when it
+     * reaches a tile where the target decides its next tile.
      */
     virtual void updateMovement(DWORD milliseconds);
 
     /*
-     * Updates the ghost's animation state. A ghost's
-     * animation state is based on its targeting state.
+     * As a Character, also counting the movement updates skipped
+     * as ones that didn't choose a target.
      */
-    virtual void updateAnimation(DWORD milliseconds);
+    virtual void skipQuietTicks(DWORD tickTime, uint32_t numTicks);
+
+    /*
+     * Handles the ghost's scared timer falling due, called by the
+     * CharacterManager. The timer only runs while the ghost is
+     * scared and not paused, and falls due on the update where it
+     * drops below the flash threshold, to flash the ghost, and on
+     * the one after it reaches 0, to unscare it.
+     */
+    void handleScaredTimer();
 
     /*
      * Updates the ghost's target state. A ghost's
@@ -96,6 +105,14 @@ public:
     const bool8_t isGhostScared() const;
     const bool8_t isInGhostHome() const;
 
+    /*
+     * Returns the number of times the ghost has chosen its target
+     * tile, and the number of movement updates it skipped choosing
+     * one, since the target isn't chosen on every update.
+     */
+    const uint32_t getNumTargetEvaluations() const;
+    const uint32_t getNumSkippedTargetEvaluations() const;
+
 private:
 
     /*
@@ -154,7 +171,7 @@ private:
 
     /*
      * The ghost moves up out of the ghost home if alive, or
-     * continues left if dead.
+     * continues left and asks to be spawned again if dead.
      */
     void handleGhostHomeExit();
 
@@ -175,10 +192,57 @@ private:
      * Handles the ghost's transition from AT_TILE to MOVING. Sets the ghost's
      * movement direction and next tile.
      */
-    void nextTileChosen(const Tile* next, GameUtil::BoardDirection direction);
+    void nextTileChosen(const TileIndex next, GameUtil::BoardDirection direction);
+
+    /*
+     * Posts the spawn event for this ghost, so a dead ghost that has
+     * returned to the ghost home comes back to life on the next frame.
+     */
+    void postSpawnEvent() const;
+
+    /*
+     * Returns true while the scared timer runs.
+     */
+    const bool8_t isScaredTimerRunning() const;
+
+    /*
+     * Sets the ghost's timer on the world for the next update its
+     * scared timer falls due on, or cancels it if there isn't one.
+     */
+    void setScaredTimerDue() const;
+
+    /*
+     * Getter and setter for the scared timer's value as of the
+     * current tick. The setter keeps the world's Zobrist hash up
+     * to date, and sets the timer due.
+     */
+    const uint32_t getScaredTimer() const;
+    void setScaredTimer(const uint32_t time);
+
+    /*
+     * Setters for the targeting state and phase, target tile, and
+     * flags, which keep the world's Zobrist hash up to date. Being
+     * scared also stops or starts the scared timer.
+     */
+    void setTargetState(const GhostTargetingState state);
+    void setTargetTile(const TileIndex tile);
+    void setCurrentPhase(const GhostTargetingState phase);
+    void setScared(const bool8_t isScared);
+    void setFlaggedForReverse(const bool8_t isFlagged);
 
 protected:
 
+    /*
+     * Setter for whether the ghost is in the ghost home, which
+     * keeps the world's Zobrist hash up to date.
+     */
+    void setInGhostHome(const bool8_t isInGhostHome);
+
+    /*
+     * As a Character, also stopping or starting the scared timer.
+     */
+    virtual void setPaused(const bool8_t isPaused);
+
     /*
      * Virtual function. Runs the ghost's algorithm for
      * targeting pacman when in the CHASE state.
@@ -198,12 +262,19 @@ protected:
      */
     virtual void chooseNextTile();
 
-    const Tile* mTargetTile;                // tile that ghost uses to select its next move target at intersections
+    /*
+     * Returns the ghost's animation chunk. A ghost's animation
+     * chunk is based on its targeting state.
+     */
+    virtual const GameUtil::AnimChunkID getAnimChunkID() const;
+
+    TileIndex mTargetTile;                  // tile that ghost uses to select its next move target at intersections
     GhostTargetingState mTargetState;       // the current method of target tile selection
     GhostTargetingState mCurrentPhase;      // the current targeting phase, 
                                             //      used to give the ghost the correct targeting phase when spawning or leaving its scared state
 
-    uint32_t mScaredTimer;
+    uint32_t mScaredTimer;                  // scared time left, as of tick mScaredTimerStart of the world's clock
+    uint32_t mScaredTimerStart;
 
     float_t mGhostSpeed;            // ghost speeds
     float_t mGhostSpeedScared;
@@ -215,4 +286,7 @@ protected:
     bool8_t mIsInGhostHome;
     bool8_t mIsScared;
     bool8_t mIsFlaggedForReverse;
+
+    uint32_t mNumTargetChecks;      // unpaused movement updates, each of which may need a target
+    uint32_t mNumTargetEvaluations; // updates that did choose a target
 };
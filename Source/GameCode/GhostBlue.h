@@ -6,7 +6,7 @@ class GhostBlue : public Ghost
 {
 public:
 
-    GhostBlue(const Tile* spawnTile, const GameUtil::CharacterID id);
+    GhostBlue(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
     virtual void reset();
     virtual void resetFromDeath();
 
@@ -2,15 +2,13 @@
 #define GHOST_ORANGE_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
 #include "Character.h"
 #include "Ghost.h"
 #include "GhostOrange.h"
@@ -18,10 +16,12 @@
 #include "CharacterManager.h"
 #include "BoardManager.h"
 
-#define EIGHT_SPRITES_SQR_DIST CHARACTER_SPRITE_OFFSET_FACTOR*CHARACTER_SPRITE_OFFSET_FACTOR*8
+#include "GameWorld.h"
 
-GhostOrange::GhostOrange(const Tile* spawnTile, const GameUtil::CharacterID id) :
-    Ghost(spawnTile, id)
+#define EIGHT_SPRITES_SQR_DIST (18*TILE_UNITS*TILE_UNITS)          // a sprite is 1.5 tiles, so 8 square sprites is 18 square tiles
+
+GhostOrange::GhostOrange(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id) :
+    Ghost(world, spawnTile, id)
 {
     // CLYDE
     // POKEY
@@ -33,8 +33,8 @@ void GhostOrange::reset()
 {
     Ghost::reset();
 
-    mIsInGhostHome = true;
-    mIsAlive = false;
+    setInGhostHome(true);
+    setAlive(false);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -43,8 +43,8 @@ void GhostOrange::resetFromDeath()
 {
     Ghost::resetFromDeath();
 
-    mIsInGhostHome = true;
-    mIsAlive = false;
+    setInGhostHome(true);
+    setAlive(false);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -52,14 +52,13 @@ void GhostOrange::resetFromDeath()
 void GhostOrange::targetPacman()
 {
     // target pacman directly at first
-    mTargetTile = CharacterManager::ConstInstance()->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
+    mTargetTile = mWorld->getConstCharacterManager()->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
     
-    Coord2D targetPosition = mTargetTile->getPosition();
-    float distToTarget = GameUtil::Utilities::squareDistance(targetPosition.x, mPosition.x, targetPosition.y, mPosition.y);
+    uint32_t distToTarget = TileGrid::getSquareDistBetween(TileGrid::getTilePosition(mTargetTile), mPosition);
 
     // if we're close enough to the target, target home corner instead
     if(distToTarget < EIGHT_SPRITES_SQR_DIST)
     {
-        mTargetTile = BoardManager::ConstInstace()->getGhostHomeTile(mCharacterID);
+        mTargetTile = mWorld->getConstBoardManager()->getGhostHomeTile(mCharacterID);
     }
 }
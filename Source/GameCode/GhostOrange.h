@@ -6,7 +6,7 @@ class GhostOrange : public Ghost
 {
 public:
 
-    GhostOrange(const Tile* spawnTile, const GameUtil::CharacterID id);
+    GhostOrange(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
     virtual void reset();
     virtual void resetFromDeath();
 
@@ -6,7 +6,7 @@ class GhostPink : public Ghost
 {
 public:
 
-    GhostPink(const Tile* spawnTile, const GameUtil::CharacterID id);
+    GhostPink(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
     virtual void reset();
     virtual void resetFromDeath();
 
@@ -2,15 +2,14 @@
 #define GHOST_RED_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "Character.h"
 #include "Ghost.h"
 #include "GhostRed.h"
@@ -19,8 +18,13 @@
 
 #include "StatsManager.h"
 
-GhostRed::GhostRed(const Tile* spawnTile, const GameUtil::CharacterID id) :
-    Ghost(spawnTile, id)
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
+GhostRed::GhostRed(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id) :
+    Ghost(world, spawnTile, id),
+    mCruiseElroyMode(GameUtil::CruiseElroyMode::NONE)
 {
     // BLINKY
     // SHADOW
@@ -32,10 +36,10 @@ void GhostRed::reset()
 {
     // reset for the new level, then reset cruise elroy mode
     Ghost::reset();
-    mCruiseElroyMode = GameUtil::CruiseElroyMode::NONE;
+    setCruiseElroyMode(GameUtil::CruiseElroyMode::NONE);
 
     // save cruise elroy speed values from the stats manager so we don't spam request them
-    const StatsManager* smInstance = StatsManager::ConstInstace();
+    const StatsManager* smInstance = mWorld->getConstStatsManager();
     mCruiseElroySpeed_1 = smInstance->getCruiseElroySpeed_1();
     mCruiseElroySpeed_2 = smInstance->getCruiseElroySpeed_2();
 }
@@ -46,7 +50,29 @@ void GhostRed::resetFromDeath()
 {
     // reset from pacman death, then reset cruise elroy mode
     Ghost::resetFromDeath();
-    mCruiseElroyMode = GameUtil::CruiseElroyMode::NONE;
+    setCruiseElroyMode(GameUtil::CruiseElroyMode::NONE);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GhostRed::saveState(CharacterState* state) const
+{
+    Ghost::saveState(state);
+
+    state->cruiseElroyMode = mCruiseElroyMode;
+    state->cruiseElroySpeed_1 = mCruiseElroySpeed_1;
+    state->cruiseElroySpeed_2 = mCruiseElroySpeed_2;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void GhostRed::loadState(const CharacterState* state)
+{
+    Ghost::loadState(state);
+
+    mCruiseElroyMode = (GameUtil::CruiseElroyMode)state->cruiseElroyMode;
+    mCruiseElroySpeed_1 = state->cruiseElroySpeed_1;
+    mCruiseElroySpeed_2 = state->cruiseElroySpeed_2;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -54,7 +80,7 @@ void GhostRed::resetFromDeath()
 void GhostRed::targetPacman()
 {
     // targets pacman directly
-    mTargetTile = CharacterManager::ConstInstance()->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
+    mTargetTile = mWorld->getConstCharacterManager()->getCharacterCurrentTile(GameUtil::CharacterID::PACMAN);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -74,7 +100,7 @@ void GhostRed::updateSpeed()
             switch(mCruiseElroyMode)
             {
                 case GameUtil::CruiseElroyMode::NONE:
-                    if(mCurrTile->isTunnel())
+                    if(mGrid->isTunnel(mCurrTile))
                     {
                         mSpeed = mBaseSpeed * mGhostSpeedTunnel;
                     }
@@ -128,9 +154,9 @@ void GhostRed::activateCruiseElroy()
     if(nextPhase != GameUtil::CruiseElroyMode::CRUISE_INVAL)
     {
         // can only experience a cruise elroy state change when all ghosts are spawned
-        if(CharacterManager::ConstInstance()->areAllGhostsSpawned())
+        if(mWorld->getConstCharacterManager()->areAllGhostsSpawned())
         {
-            mCruiseElroyMode = nextPhase;
+            setCruiseElroyMode(nextPhase);
         }
     }
 }
@@ -141,3 +167,11 @@ const  GameUtil::CruiseElroyMode  GhostRed::getCruiseElroyPhase() const
 {
     return mCruiseElroyMode;
 }
+
+//-----------------------------------------------------------------------------------------
+
+void GhostRed::setCruiseElroyMode(const GameUtil::CruiseElroyMode mode)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::CRUISE_ELROY_MODE, mCharacterID), mCruiseElroyMode, mode);
+    mCruiseElroyMode = mode;
+}
@@ -6,10 +6,17 @@ class GhostRed : public Ghost
 {
 public:
 
-    GhostRed(const Tile* spawnTile, const GameUtil::CharacterID id);
+    GhostRed(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
     virtual void reset();
     virtual void resetFromDeath();
 
+    /*
+     * As a Ghost, plus the red ghost's "Cruise Elroy" mode
+     * and speeds.
+     */
+    virtual void saveState(CharacterState* state) const;
+    virtual void loadState(const CharacterState* state);
+
     /*
      * Updates the red ghost's speed with special rules for when
      * the red ghost is in "Cruise Elroy" mode.
@@ -32,6 +39,14 @@ public:
      */
     const  GameUtil::CruiseElroyMode getCruiseElroyPhase() const;
 
+private:
+
+    /*
+     * Setter for the Cruise Elroy mode, which keeps the world's
+     * Zobrist hash up to date.
+     */
+    void setCruiseElroyMode(const GameUtil::CruiseElroyMode mode);
+
 protected:
 
     /*
@@ -0,0 +1,162 @@
+
+#define HASH_STREAM_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include <string.h>
+#include "../Framework/baseTypes.h"
+
+#include <vector>
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "Replay.h"
+#include "HashStream.h"
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
+static_assert(sizeof(HashStreamHeader) == 16, "hash stream header layout changed");
+
+HashStream::HashStream() :
+    mHashes(new Hashes()),
+    mBuildHash(Replay::getCurrentBuildHash())
+{
+}
+
+//-----------------------------------------------------------------------------------------
+
+HashStream::~HashStream()
+{
+    delete mHashes;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void HashStream::clear()
+{
+    mHashes->clear();
+    mBuildHash = Replay::getCurrentBuildHash();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void HashStream::push(const uint64_t zobristHash)
+{
+    mHashes->push_back(ZobristHash::fold(zobristHash));
+}
+
+//-----------------------------------------------------------------------------------------
+
+void HashStream::pop()
+{
+    if(!mHashes->empty())
+    {
+        mHashes->pop_back();
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t HashStream::getNumTicks() const
+{
+    return (uint32_t)mHashes->size();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t HashStream::getHash(const uint32_t tick) const
+{
+    assert(tick < mHashes->size());
+    return (*mHashes)[tick];
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t HashStream::getBuildHash() const
+{
+    return mBuildHash;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t HashStream::read(const char8_t* path)
+{
+    mHashes->clear();
+
+    FILE* file = fopen(path, "rb");
+    if(file == nullptr)
+    {
+        return false;
+    }
+
+    HashStreamHeader header;
+    bool8_t result = fread(&header, sizeof(header), 1, file) == 1 &&
+        header.magic == HASH_STREAM_FILE_MAGIC &&
+        header.version == HASH_STREAM_FILE_VERSION;
+
+    // the size comes from the file, so it's checked against what's left of it before anything is allocated
+    if(result)
+    {
+        long offset = ftell(file);
+        result = offset >= 0 && fseek(file, 0, SEEK_END) == 0;
+
+        long size = result ? ftell(file) : -1;
+        result = result && size >= offset && fseek(file, offset, SEEK_SET) == 0 &&
+            (uint64_t)header.numTicks * sizeof(uint32_t) <= (uint64_t)(size - offset);
+    }
+
+    if(result)
+    {
+        mBuildHash = header.buildHash;
+        mHashes->resize(header.numTicks);
+        result = header.numTicks == 0 || fread(mHashes->data(), header.numTicks * sizeof(uint32_t), 1, file) == 1;
+    }
+
+    fclose(file);
+
+    if(!result)
+    {
+        mHashes->clear();
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t HashStream::write(const char8_t* path) const
+{
+    FILE* file = fopen(path, "wb");
+    if(file == nullptr)
+    {
+        return false;
+    }
+
+    HashStreamHeader header;
+    header.magic = HASH_STREAM_FILE_MAGIC;
+    header.version = HASH_STREAM_FILE_VERSION;
+    header.buildHash = mBuildHash;
+    header.numTicks = (uint32_t)mHashes->size();
+
+    bool8_t result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        (mHashes->empty() || fwrite(mHashes->data(), mHashes->size() * sizeof(uint32_t), 1, file) == 1);
+
+    return fclose(file) == 0 && result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t HashStream::findFirstMismatch(const HashStream* a, const HashStream* b)
+{
+    uint32_t numTicks = a->getNumTicks() < b->getNumTicks() ? a->getNumTicks() : b->getNumTicks();
+    for(uint32_t tick = 0; tick < numTicks; ++tick)
+    {
+        if((*a->mHashes)[tick] != (*b->mHashes)[tick])
+        {
+            return tick;
+        }
+    }
+
+    return a->getNumTicks() == b->getNumTicks() ? TICKS_UNLIMITED : numTicks;
+}
@@ -0,0 +1,92 @@
+
+#define HASH_STREAM_FILE_MAGIC      0x53485350      // "PSHS" as little-endian bytes
+#define HASH_STREAM_FILE_VERSION    1
+
+/*
+ * Header at the start of a hash stream file. The numTicks
+ * hashes follow immediately.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t buildHash;         // Replay::getCurrentBuildHash() of the build that played the game
+    uint32_t numTicks;          // hashes in the stream
+}HashStreamHeader;
+
+/*
+ * A hash of a world's state for every tick of a game, from the
+ * state it starts in (tick 0) to the one it ended in.
+ *
+ * Each hash is the world's Zobrist hash folded to 32 bits, so
+ * keeping it costs nothing on top of playing, and an hour of
+ * play is under a MB. It covers every field that decides how the
+ * game plays on, see ZobristHash.h, so the first tick two streams
+ * disagree on is the first tick the games played differently.
+ *
+ * The hash doesn't depend on how a build lays out its state, so
+ * streams of the same game from two builds compare as long as
+ * both play by the same rules, which is what the build hash in
+ * the header says, see Replay::getCurrentBuildHash(). Streams
+ * with different build hashes are expected to differ from the
+ * start. See the pacdiff tool.
+ *
+ * A GameWorld fills in a stream as it plays, see
+ * GameWorld::setHashStream().
+ */
+class HashStream
+{
+public:
+
+    HashStream();
+    ~HashStream();
+
+    /*
+     * Drops every hash held.
+     */
+    void clear();
+
+    /*
+     * Adds 'zobristHash', the hash of the next tick, to the end of
+     * the stream, or drops the hash of the last tick.
+     */
+    void push(const uint64_t zobristHash);
+    void pop();
+
+    /*
+     * Returns the number of ticks held, and the hash of 'tick'.
+     */
+    const uint32_t getNumTicks() const;
+    const uint32_t getHash(const uint32_t tick) const;
+
+    /*
+     * Returns the build hash of the build that played the game.
+     */
+    const uint32_t getBuildHash() const;
+
+    /*
+     * Reads the hash stream file at 'path'. Returns false if it
+     * can't be read or isn't a hash stream file, including one
+     * whose header gives more hashes than the file holds.
+     */
+    bool8_t read(const char8_t* path);
+
+    /*
+     * Writes the stream to a file at 'path'. Returns false on failure.
+     */
+    bool8_t write(const char8_t* path) const;
+
+    /*
+     * Returns the first tick where 'a' and 'b' differ, or where one
+     * ends and the other carries on, or TICKS_UNLIMITED if they are
+     * the same.
+     */
+    static const uint32_t findFirstMismatch(const HashStream* a, const HashStream* b);
+
+private:
+
+    typedef std::vector<uint32_t> Hashes;
+    Hashes* mHashes;
+
+    uint32_t mBuildHash;
+};
@@ -2,17 +2,14 @@
 #define PACMAN_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
-#include "..\\Framework\\InputManager.h"
-#include "..\\Framework\\openGLFramework.h"
+#include "../Framework/baseTypes.h"
 
 #include <map>
 #include "Utilities.h"
-#include "Tile.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "Character.h"
 #include "Pacman.h"
 
@@ -25,12 +22,16 @@
 #include "CharacterManager.h"
 
 #include "StatsManager.h"
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
 
 #define DEATH_FRAME_DELTA_TIME  250
 #define PACMAN_FRAME_DELTA_TIME 50
 
-Pacman::Pacman(const Tile* spawnTile, const GameUtil::CharacterID id) :
-    Character(spawnTile, id)
+Pacman::Pacman(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id) :
+    Character(world, spawnTile, id),
+    mInputDirection(GameUtil::BoardDirection::INVAL)
 {
 }
 
@@ -41,12 +42,12 @@ void Pacman::reset()
     // reset stuff on the character class
     Character::reset();
 
-    mFacingDirection = GameUtil::BoardDirection::UP;
+    setFacingDirection(GameUtil::BoardDirection::UP);
 
     mFrameDeltaTime = PACMAN_FRAME_DELTA_TIME;
 
     // save pacman's speed values for the new level so we don't spam request them from the stats manager
-    const StatsManager* smInstance = StatsManager::ConstInstace();
+    const StatsManager* smInstance = mWorld->getConstStatsManager();
     mPacmanSpeed = smInstance->getPacmanSpeed();
     mPacmanSpeedDots = smInstance->getPacmanSpeedDots();
     mPacmanSpeedScared = smInstance->getPacmanScaredSpeed();
@@ -59,29 +60,101 @@ void Pacman::resetFromDeath()
 {
     Character::resetFromDeath();
 
-    mFacingDirection = GameUtil::BoardDirection::UP;
+    setFacingDirection(GameUtil::BoardDirection::UP);
 
     mFrameDeltaTime = PACMAN_FRAME_DELTA_TIME;
 }
 
 //-----------------------------------------------------------------------------------------
 
+void Pacman::saveState(CharacterState* state) const
+{
+    Character::saveState(state);
+
+    state->pacmanSpeed = mPacmanSpeed;
+    state->pacmanSpeedDots = mPacmanSpeedDots;
+    state->pacmanSpeedScared = mPacmanSpeedScared;
+    state->pacmanSpeedScaredDots = mPacmanSpeedScaredDots;
+    state->inputDirection = mInputDirection;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Pacman::loadState(const CharacterState* state)
+{
+    Character::loadState(state);
+
+    mPacmanSpeed = state->pacmanSpeed;
+    mPacmanSpeedDots = state->pacmanSpeedDots;
+    mPacmanSpeedScared = state->pacmanSpeedScared;
+    mPacmanSpeedScaredDots = state->pacmanSpeedScaredDots;
+    mInputDirection = (GameUtil::BoardDirection)state->inputDirection;
+}
+
+//-----------------------------------------------------------------------------------------
+
 void Pacman::updateMovement(DWORD milliseconds)
 {
     if(mIsAlive)
     {
         Character::updateMovement(milliseconds);
         updateUserInput();
+
+        // pacman only animates while he's moving
+        if(!mIsPaused)
+        {
+            if(mMovementState == MovementState::MOVING) releaseAnimation();
+            else holdAnimation();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Pacman::getNumQuietTicks(DWORD tickTime) const
+{
+    if(!mIsAlive || mIsPaused)
+    {
+        return TICKS_UNLIMITED;
+    }
+
+    // input in a new direction turns pacman on the next update, see updateUserInput
+    if(mInputDirection != GameUtil::BoardDirection::INVAL && mInputDirection != mFacingDirection)
+    {
+        return 0;
+    }
+
+    // pacman stopped against a wall chooses the same wall on every update, until the input turns him
+    //      his animation is held on the first of those updates
+    if(mMovementState == MovementState::AT_TILE)
+    {
+        TileIndex tileAhead = mGrid->getNeighbor(mCurrTile, mFacingDirection);
+        bool8_t isStopped = tileAhead == TILE_INVAL ||
+            (mNextTile == tileAhead && mPrevTile == mCurrTile && !mGrid->isTraversable(tileAhead));
+
+        return isStopped && mIsAnimHeld ? TICKS_UNLIMITED : 0;
     }
+
+    // a held animation is released on the next update he moves
+    if(mIsAnimHeld)
+    {
+        return 0;
+    }
+
+    return Character::getNumQuietTicks(tickTime);
 }
 
 //-----------------------------------------------------------------------------------------
 
-void Pacman::updateAnimation(DWORD milliseconds)
+void Pacman::skipQuietTicks(DWORD tickTime, uint32_t numTicks)
 {
-    if(mMovementState == MovementState::MOVING || !mIsAlive)
+    if(mIsAlive)
+    {
+        Character::skipQuietTicks(tickTime, numTicks);
+    }
+    else
     {
-        Character::updateAnimation(milliseconds);
+        saveLastPosition();
     }
 }
 
@@ -90,10 +163,10 @@ void Pacman::updateAnimation(DWORD milliseconds)
 void Pacman::updateSpeed()
 {
     // pacman uses the ghosts' scared state and whether his current tile has a pellet on it
-    if(CharacterManager::ConstInstance()->areGhostsScared())
+    if(mWorld->getConstCharacterManager()->areGhostsScared())
     {
         // speeds if ghosts are scared
-        if(mCurrTile->isPelletPresent())
+        if(mGrid->isPelletPresent(mCurrTile))
         {
             mSpeed = mBaseSpeed * mPacmanSpeedScaredDots;
         }
@@ -105,7 +178,7 @@ void Pacman::updateSpeed()
     else
     {
         // speeds if ghosts are not scared
-        if(mCurrTile->isPelletPresent())
+        if(mGrid->isPelletPresent(mCurrTile))
         {
             mSpeed = mBaseSpeed * mPacmanSpeedDots;
         }
@@ -121,14 +194,29 @@ void Pacman::updateSpeed()
 void Pacman::playDeathAnimation()
 {
     // unpause pacman so the animation will actually play
-    mIsPaused = false;
+    setPaused(false);
 
     // reset the animation frames, and make the animation play slightly slower than normal
-    mAnimFrame = 0;
-    mTimeOnCurrFrame = 0;
     mFrameDeltaTime = DEATH_FRAME_DELTA_TIME;
+    restartAnimation();
+    releaseAnimation();
     mAnimChunkID = GameUtil::AnimChunkID::ANIM_PACMAN_DEAD;
-    mFacingDirection = GameUtil::BoardDirection::UP;
+    setFacingDirection(GameUtil::BoardDirection::UP);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Pacman::setInputDirection(GameUtil::BoardDirection direction)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::PACMAN_INPUT, mCharacterID), mInputDirection, direction);
+    mInputDirection = direction;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const GameUtil::BoardDirection Pacman::getInputDirection() const
+{
+    return mInputDirection;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -140,50 +228,35 @@ void Pacman::updateUserInput()
         // pacman automatically selects his current direction of movement
         GameUtil::BoardDirection direction = mFacingDirection;
 
-        // select direction using arrow key input
-        if(g_keys->keyDown[VK_UP])
-        {
-            direction = GameUtil::BoardDirection::UP;
-        }
-        else if(g_keys->keyDown[VK_LEFT])
-        {
-            direction = GameUtil::BoardDirection::LEFT;
-        }
-        else if(g_keys->keyDown[VK_DOWN])
-        {
-            direction = GameUtil::BoardDirection::DOWN;
-        }
-        else if(g_keys->keyDown[VK_RIGHT])
+        // select direction using the latest input (INVAL when no direction is held)
+        if(mInputDirection != GameUtil::BoardDirection::INVAL)
         {
-            direction = GameUtil::BoardDirection::RIGHT;
+            direction = mInputDirection;
         }
 
         // user input may change pacman's facing direction at any time,
         // so we must consider pacman's next movement target whenever we receive new input
         if(direction != mFacingDirection)
         {
-            mFacingDirection = direction;
+            setFacingDirection(direction);
 
-            const Tile* tempTile = mCurrTile->getNeighbor(direction);
-            if(tempTile != nullptr)
+            TileIndex tempTile = mGrid->getNeighbor(mCurrTile, direction);
+            if(tempTile != TILE_INVAL)
             {
                 // if target tile is traversable
                 // we have to consider pacman's distance to the current tile center
-                if(tempTile->isTraversable())
+                if(mGrid->isTraversable(tempTile))
                 {
-                    Coord2D currTilePos = mCurrTile->getPosition();
-                    float distToCurr = GameUtil::Utilities::squareDistance(mPosition.x, currTilePos.x, mPosition.y, currTilePos.y);
                     if(mMovementState == MovementState::MOVING)
                     {
                         // if pacman is close enough to the current tile's center, he snaps to the tile's position and moves in that direction
                         //      if the player's timing is right, pacman can take corners faster than the ghosts in this way
-                        mPosition.x = currTilePos.x;
-                        mPosition.y = currTilePos.y;
+                        setPosition(TileGrid::getTilePosition(mCurrTile));
                     }
                 }
             }
 
-            mMovementState = MovementState::AT_TILE;
+            setMovementState(MovementState::AT_TILE);
         }
     }
 }
@@ -195,17 +268,17 @@ void Pacman::chooseNextTile()
     if(mIsAlive)
     {
         // automatically select the next movement target in the current direction
-        const Tile* tempTile = mCurrTile->getNeighbor(mFacingDirection);
-        if(tempTile != nullptr)
+        TileIndex tempTile = mGrid->getNeighbor(mCurrTile, mFacingDirection);
+        if(tempTile != TILE_INVAL)
         {
-            mNextTile = tempTile;
-            mPrevTile = mCurrTile;
+            setNextTile(tempTile);
+            setPrevTile(mCurrTile);
 
             // if pacman's next movement target is traversable,
             // we transition states and begin moving towards it
-            if(mNextTile->isTraversable())
+            if(mGrid->isTraversable(mNextTile))
             {
-                mMovementState = MovementState::MOVING;
+                setMovementState(MovementState::MOVING);
             }
         }
     }
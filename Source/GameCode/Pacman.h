@@ -6,20 +6,29 @@ class Pacman : public Character
 {
 public:
 
-    Pacman(const Tile* spawnTile, const GameUtil::CharacterID id);
+    Pacman(const GameWorld* world, const TileIndex spawnTile, const GameUtil::CharacterID id);
     virtual void reset();
     virtual void resetFromDeath();
 
+    /*
+     * As a Character, plus pacman's speeds and input.
+     */
+    virtual void saveState(CharacterState* state) const;
+    virtual void loadState(const CharacterState* state);
+
     /*
      * Handles movement for pacman. Ignores movement if pacman is dead.
+     * Pacman's animation is held while he isn't moving.
      */
     virtual void updateMovement(DWORD milliseconds);
 
     /*
-     * Handles pacman's animation. Pacman does not update his animation
-     * frame if he is not moving.
+     * As a Character, but pacman also isn't quiet while there's
+     * input to turn him, or while his animation is held. Pacman
+     * stopped against a wall, or dead, doesn't move at all.
      */
-    virtual void updateAnimation(DWORD milliseconds);
+    virtual const uint32_t getNumQuietTicks(DWORD tickTime) const;
+    virtual void skipQuietTicks(DWORD tickTime, uint32_t numTicks);
 
     /*
      * Updates pacman's speed. Pacman's speed is determined by whether his
@@ -33,6 +42,14 @@ public:
      */
     void playDeathAnimation();
 
+    /*
+     * Sets the direction currently held by the player, and keeps
+     * the world's Zobrist hash up to date. INVAL means no direction
+     * is held.
+     */
+    void setInputDirection(GameUtil::BoardDirection direction);
+    const GameUtil::BoardDirection getInputDirection() const;
+
 private:
 
     /*
@@ -52,4 +69,6 @@ protected:
     float_t mPacmanSpeedDots;
     float_t mPacmanSpeedScared;
     float_t mPacmanSpeedScaredDots;
+
+    GameUtil::BoardDirection mInputDirection;
 };
@@ -0,0 +1,407 @@
+
+#define REPLAY_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include <string.h>
+#include "../Framework/baseTypes.h"
+
+#include <vector>
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "BoardFile.h"
+#include "Replay.h"
+
+#include "GameWorld.h"
+
+#define RUN_DIRECTION_BITS      3
+#define RUN_DIRECTION_MASK      ((1u << RUN_DIRECTION_BITS) - 1)
+#define MAX_RUN_TICKS           (0xFFFFFFFFu >> RUN_DIRECTION_BITS)     // longer runs are split
+
+static_assert(sizeof(ReplayHeader) == 48, "replay header layout changed");
+static_assert(GameUtil::BoardDirection::INVAL <= RUN_DIRECTION_MASK, "a direction must fit in a run");
+
+Replay::Replay() :
+    mInput(new InputBytes()),
+    mCheckpoints(new Checkpoints()),
+    mRunDirection(GameUtil::BoardDirection::INVAL),
+    mRunTicks(0),
+    mReadOffset(0),
+    mTick(0),
+    mFirstDivergentTick(TICKS_UNLIMITED),
+    mIsRecording(false)
+{
+    memset(&mHeader, 0, sizeof(mHeader));
+}
+
+//-----------------------------------------------------------------------------------------
+
+Replay::~Replay()
+{
+    delete mInput;
+    delete mCheckpoints;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::startRecording(const uint32_t boardHash, const uint32_t seed)
+{
+    memset(&mHeader, 0, sizeof(mHeader));
+    mHeader.magic = REPLAY_FILE_MAGIC;
+    mHeader.version = REPLAY_FILE_VERSION;
+    mHeader.buildHash = getCurrentBuildHash();
+    mHeader.boardHash = boardHash;
+    mHeader.seed = seed;
+    mHeader.checkpointTicks = REPLAY_CHECKPOINT_TICKS;
+
+    mInput->clear();
+    mCheckpoints->clear();
+    mRunDirection = GameUtil::BoardDirection::INVAL;
+    mRunTicks = 0;
+    mTick = 0;
+    mIsRecording = true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::recordInput(const GameUtil::BoardDirection direction, const uint32_t numTicks)
+{
+    assert(mIsRecording);
+
+    // the same input as last tick lengthens the run
+    if(direction != mRunDirection)
+    {
+        flushRun();
+        mRunDirection = direction;
+    }
+
+    mRunTicks += numTicks;
+    mHeader.numTicks += numTicks;
+    mTick += numTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::recordCheckpoint(const uint32_t stateHash)
+{
+    assert(mIsRecording && isCheckpointDue());
+
+    mCheckpoints->push_back(stateHash);
+    mHeader.numCheckpoints++;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::stopRecording(const int32_t score, const int32_t level, const uint32_t stateHash)
+{
+    assert(mIsRecording);
+
+    flushRun();
+    mHeader.inputSize = (uint32_t)mInput->size();
+    mHeader.finalScore = score;
+    mHeader.finalLevel = level;
+    mHeader.finalStateHash = stateHash;
+
+    mIsRecording = false;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t Replay::isRecording() const
+{
+    return mIsRecording;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::startPlayback()
+{
+    assert(!mIsRecording);
+
+    mReadOffset = 0;
+    mTick = 0;
+    mFirstDivergentTick = TICKS_UNLIMITED;
+    readRun();
+}
+
+//-----------------------------------------------------------------------------------------
+
+const GameUtil::BoardDirection Replay::getInput() const
+{
+    return mRunDirection;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getNumTicksOnInput() const
+{
+    return mRunTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::skipTicks(uint32_t numTicks)
+{
+    mTick += numTicks;
+
+    // the run past the end of the input never ends
+    while(numTicks >= mRunTicks && mRunTicks != TICKS_UNLIMITED)
+    {
+        numTicks -= mRunTicks;
+        readRun();
+    }
+
+    if(mRunTicks != TICKS_UNLIMITED)
+    {
+        mRunTicks -= numTicks;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::checkCheckpoint(const uint32_t stateHash)
+{
+    assert(!mIsRecording && isCheckpointDue());
+
+    if(stateHash != (*mCheckpoints)[mTick / mHeader.checkpointTicks - 1] && mFirstDivergentTick == TICKS_UNLIMITED)
+    {
+        mFirstDivergentTick = mTick;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getFirstDivergentTick() const
+{
+    return mFirstDivergentTick;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getTick() const
+{
+    return mTick;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t Replay::isCheckpointDue() const
+{
+    // playback past the last checkpoint has nothing to check against
+    return mTick > 0 && mTick % mHeader.checkpointTicks == 0 &&
+        (mIsRecording || mTick / mHeader.checkpointTicks <= mHeader.numCheckpoints);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getNumTicksToCheckpoint() const
+{
+    return mHeader.checkpointTicks - mTick % mHeader.checkpointTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getBuildHash() const
+{
+    return mHeader.buildHash;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getBoardHash() const
+{
+    return mHeader.boardHash;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getSeed() const
+{
+    return mHeader.seed;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getNumTicks() const
+{
+    return mHeader.numTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t Replay::getFinalScore() const
+{
+    return mHeader.finalScore;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t Replay::getFinalLevel() const
+{
+    return mHeader.finalLevel;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getFinalStateHash() const
+{
+    return mHeader.finalStateHash;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getNumCheckpoints() const
+{
+    return mHeader.numCheckpoints;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getInputSize() const
+{
+    return (uint32_t)mInput->size();
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t Replay::read(const char8_t* path)
+{
+    mIsRecording = false;
+    mInput->clear();
+    mCheckpoints->clear();
+
+    FILE* file = fopen(path, "rb");
+    if(file == nullptr)
+    {
+        return false;
+    }
+
+    bool8_t result = fread(&mHeader, sizeof(mHeader), 1, file) == 1 &&
+        mHeader.magic == REPLAY_FILE_MAGIC &&
+        mHeader.version == REPLAY_FILE_VERSION &&
+        mHeader.checkpointTicks > 0 &&
+        mHeader.numCheckpoints <= mHeader.numTicks / mHeader.checkpointTicks;
+
+    // the sizes come from the file, so they're checked against what's left of it before anything is allocated
+    if(result)
+    {
+        long offset = ftell(file);
+        result = offset >= 0 && fseek(file, 0, SEEK_END) == 0;
+
+        long size = result ? ftell(file) : -1;
+        result = result && size >= offset && fseek(file, offset, SEEK_SET) == 0;
+
+        uint64_t numBytesLeft = result ? (uint64_t)(size - offset) : 0;
+        result = result && mHeader.inputSize <= numBytesLeft &&
+            (uint64_t)mHeader.numCheckpoints * sizeof(uint32_t) <= numBytesLeft - mHeader.inputSize;
+    }
+
+    if(result)
+    {
+        mInput->resize(mHeader.inputSize);
+        result = mHeader.inputSize == 0 || fread(mInput->data(), mHeader.inputSize, 1, file) == 1;
+    }
+
+    if(result)
+    {
+        mCheckpoints->resize(mHeader.numCheckpoints);
+        result = mHeader.numCheckpoints == 0 ||
+            fread(mCheckpoints->data(), mHeader.numCheckpoints * sizeof(uint32_t), 1, file) == 1;
+    }
+
+    fclose(file);
+
+    if(!result)
+    {
+        memset(&mHeader, 0, sizeof(mHeader));
+        mInput->clear();
+        mCheckpoints->clear();
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t Replay::write(const char8_t* path) const
+{
+    assert(!mIsRecording);
+
+    FILE* file = fopen(path, "wb");
+    if(file == nullptr)
+    {
+        return false;
+    }
+
+    bool8_t result = fwrite(&mHeader, sizeof(mHeader), 1, file) == 1 &&
+        (mInput->empty() || fwrite(mInput->data(), mInput->size(), 1, file) == 1) &&
+        (mCheckpoints->empty() || fwrite(mCheckpoints->data(), mCheckpoints->size() * sizeof(uint32_t), 1, file) == 1);
+
+    return fclose(file) == 0 && result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t Replay::getCurrentBuildHash()
+{
+    // only the rules of play, so a build that lays out its state differently still plays old replays
+    const uint32_t constants[] =
+    {
+        REPLAY_FILE_VERSION,
+        SIM_TICK_TIME,
+        TILE_UNITS
+    };
+
+    return BoardFile::checksum(constants, sizeof(constants));
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::flushRun()
+{
+    // long runs are split, so the ticks always fit alongside the direction
+    while(mRunTicks > 0)
+    {
+        uint32_t numTicks = mRunTicks < MAX_RUN_TICKS ? mRunTicks : MAX_RUN_TICKS;
+        uint32_t value = (numTicks << RUN_DIRECTION_BITS) | (uint32_t)mRunDirection;
+        while(value >= 0x80)
+        {
+            mInput->push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        mInput->push_back((uint8_t)value);
+
+        mRunTicks -= numTicks;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void Replay::readRun()
+{
+    if(mReadOffset >= mInput->size())
+    {
+        mRunDirection = GameUtil::BoardDirection::INVAL;
+        mRunTicks = TICKS_UNLIMITED;
+        return;
+    }
+
+    uint32_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = (*mInput)[mReadOffset++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while((byte & 0x80) != 0 && mReadOffset < mInput->size() && shift < 32);
+
+    mRunDirection = (GameUtil::BoardDirection)(value & RUN_DIRECTION_MASK);
+    mRunTicks = value >> RUN_DIRECTION_BITS;
+    if(mRunDirection > GameUtil::BoardDirection::INVAL)
+    {
+        mRunDirection = GameUtil::BoardDirection::INVAL;
+    }
+}
@@ -0,0 +1,218 @@
+
+#define REPLAY_FILE_MAGIC       0x4C505250      // "PRPL" as little-endian bytes
+#define REPLAY_FILE_VERSION     4               // bumped when the rules of play change, see Replay::getCurrentBuildHash()
+#define REPLAY_CHECKPOINT_TICKS 60              // ticks between state hashes kept in a replay, about a second
+
+/*
+ * Header at the start of a replay file.
+ *
+ * The encoded input (inputSize bytes) follows immediately, then
+ * the checkpoints (numCheckpoints state hashes). A replay only
+ * plays back the same way on a build with the same build hash,
+ * on the board it was recorded on.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t buildHash;         // Replay::getCurrentBuildHash() of the recording build
+    uint32_t boardHash;         // checksum of the board file the game was played on
+    uint32_t seed;              // random seed the game was played with
+    uint32_t numTicks;          // ticks of input
+    uint32_t inputSize;         // bytes of encoded input
+    int32_t finalScore;         // score, level, and state hash when the recording stopped
+    int32_t finalLevel;
+    uint32_t finalStateHash;
+    uint32_t checkpointTicks;   // ticks between checkpoints
+    uint32_t numCheckpoints;
+}ReplayHeader;
+
+/*
+ * Outcome of playing back a replay, see GameWorld::verifyReplay().
+ */
+struct ReplayResult
+{
+    int32_t score;                  // score, level, and state hash the replay played back to
+    int32_t level;
+    uint32_t stateHash;
+    uint32_t numTicks;              // ticks played back
+    uint32_t firstDivergentTick;    // first checkpoint tick, or the last tick, where the state differs
+                                    //      from the recording, TICKS_UNLIMITED if none does
+    bool8_t isMatch;                // true if the replay played back exactly as it was recorded
+};
+
+/*
+ * A recorded game: the seed the world was played with, and the
+ * input direction of every tick.
+ *
+ * Worlds are deterministic, so that is all it takes to play the
+ * game again exactly. The final score and state hash are kept to
+ * check that the game played back the same.
+ *
+ * Input is stored as runs of ticks held in the same direction.
+ * Each run is one varint (7 bits per byte, low bits first) of
+ * (numTicks << 3) | direction, so a run held for under 16 ticks
+ * is a single byte, and an hour of play is a few KB.
+ *
+ * Every REPLAY_CHECKPOINT_TICKS ticks, the world's state hash is
+ * kept as a checkpoint. Playback checks the world against each
+ * checkpoint it reaches, so a replay that plays back differently
+ * shows roughly where it went wrong, not just that it did.
+ *
+ * A GameWorld records into a replay, or plays one back in place
+ * of its input, see GameWorld::recordReplay().
+ */
+class Replay
+{
+public:
+
+    Replay();
+    ~Replay();
+
+    /*
+     * Clears the replay and starts recording a game played
+     * on 'boardHash' with 'seed'.
+     */
+    void startRecording(const uint32_t boardHash, const uint32_t seed);
+
+    /*
+     * Appends 'numTicks' ticks of input in 'direction'.
+     */
+    void recordInput(const GameUtil::BoardDirection direction, const uint32_t numTicks);
+
+    /*
+     * Appends the state hash of the current tick as a checkpoint.
+     */
+    void recordCheckpoint(const uint32_t stateHash);
+
+    /*
+     * Stops recording, and saves the game's final score, level,
+     * and state hash.
+     */
+    void stopRecording(const int32_t score, const int32_t level, const uint32_t stateHash);
+
+    /*
+     * Returns true between startRecording() and stopRecording().
+     */
+    const bool8_t isRecording() const;
+
+    /*
+     * Rewinds playback to the first tick.
+     */
+    void startPlayback();
+
+    /*
+     * Returns the input of the current tick of playback, and the
+     * number of ticks, from the current one, that it is held for.
+     * Once the input runs out, this is INVAL for TICKS_UNLIMITED.
+     */
+    const GameUtil::BoardDirection getInput() const;
+    const uint32_t getNumTicksOnInput() const;
+
+    /*
+     * Moves playback forward 'numTicks' ticks.
+     */
+    void skipTicks(uint32_t numTicks);
+
+    /*
+     * Compares 'stateHash' with the checkpoint of the current tick
+     * of playback. The first tick that doesn't match is kept.
+     */
+    void checkCheckpoint(const uint32_t stateHash);
+
+    /*
+     * Returns the first tick of playback that didn't match its
+     * checkpoint, or TICKS_UNLIMITED if all have so far.
+     */
+    const uint32_t getFirstDivergentTick() const;
+
+    /*
+     * Returns the tick recording or playback is at, the number of
+     * ticks recorded or played back so far.
+     */
+    const uint32_t getTick() const;
+
+    /*
+     * Returns true if the current tick is one with a checkpoint to
+     * record, or to check during playback.
+     */
+    const bool8_t isCheckpointDue() const;
+
+    /*
+     * Returns the number of ticks from the current one to the next
+     * checkpoint.
+     */
+    const uint32_t getNumTicksToCheckpoint() const;
+
+    /*
+     * Getters for the header.
+     */
+    const uint32_t getBuildHash() const;
+    const uint32_t getBoardHash() const;
+    const uint32_t getSeed() const;
+    const uint32_t getNumTicks() const;
+    const int32_t getFinalScore() const;
+    const int32_t getFinalLevel() const;
+    const uint32_t getFinalStateHash() const;
+    const uint32_t getNumCheckpoints() const;
+
+    /*
+     * Returns the size of the encoded input, in bytes.
+     */
+    const uint32_t getInputSize() const;
+
+    /*
+     * Reads the replay file at 'path'. Returns false if it can't
+     * be read or isn't a replay file, including one whose header
+     * gives sizes the rest of the file doesn't hold.
+     */
+    bool8_t read(const char8_t* path);
+
+    /*
+     * Writes the replay to a file at 'path'. Returns false on failure.
+     */
+    bool8_t write(const char8_t* path) const;
+
+    /*
+     * Returns the hash of the rules that decide how a world plays
+     * out: the file version, the tick length, and the fixed-point
+     * units characters move in. The board is checked separately,
+     * by its checksum. Replays only play back on a build with the
+     * same hash.
+     *
+     * How the world lays out its state is not part of it, so a
+     * replay still plays back after the state is refactored. A
+     * change to the rules of play, or to what the state hash
+     * covers, goes with a bump of REPLAY_FILE_VERSION instead.
+     */
+    static const uint32_t getCurrentBuildHash();
+
+private:
+
+    /*
+     * Appends the run of the last recorded input to the encoded input.
+     */
+    void flushRun();
+
+    /*
+     * Decodes the run at the read offset into the current run.
+     * Past the end of the input, the run is INVAL for TICKS_UNLIMITED.
+     */
+    void readRun();
+
+    ReplayHeader mHeader;
+
+    typedef std::vector<uint8_t> InputBytes;
+    InputBytes* mInput;
+
+    typedef std::vector<uint32_t> Checkpoints;
+    Checkpoints* mCheckpoints;                  // state hash every mHeader.checkpointTicks ticks
+
+    GameUtil::BoardDirection mRunDirection;     // run being recorded or played back
+    uint32_t mRunTicks;                         // ticks recorded, or left to play back, in the run
+    uint32_t mReadOffset;                       // offset of the next run to play back
+    uint32_t mTick;                             // ticks recorded or played back
+    uint32_t mFirstDivergentTick;               // first tick of playback that didn't match its checkpoint
+
+    bool8_t mIsRecording;
+};
@@ -0,0 +1,238 @@
+
+#define REWIND_BUFFER_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include <string.h>
+#include "../Framework/baseTypes.h"
+
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "WorldState.h"
+#include "RewindBuffer.h"
+
+#include "GameWorld.h"
+
+#define STATE_WORDS             (sizeof(GameWorldState) / sizeof(uint32_t))
+#define MAX_DELTA_WORDS         (STATE_WORDS * 2 + 1)       // every other word changed, plus the end of the delta
+
+#define RUN_SKIP_SHIFT          16
+#define RUN_COUNT_MASK          0xFFFF
+
+static_assert(sizeof(GameWorldState) % sizeof(uint32_t) == 0, "world state is XORed a word at a time");
+static_assert(STATE_WORDS <= RUN_COUNT_MASK, "a run's skip and count must fit in 16 bits");
+
+RewindBuffer::RewindBuffer(const uint32_t numSeconds) :
+    mNumTicksRequested(numSeconds * 1000 / SIM_TICK_TIME)
+{
+    // one more keyframe than the history needs, for the one being filled
+    mNumKeyframes = (mNumTicksRequested + REWIND_KEYFRAME_TICKS - 1) / REWIND_KEYFRAME_TICKS + 1;
+    mMaxTicks = mNumKeyframes * REWIND_KEYFRAME_TICKS;
+
+    // always room for a keyframe's worth of the largest deltas, so the newest keyframe is never dropped
+    mNumDeltaWords = mMaxTicks * REWIND_DELTA_WORDS_PER_TICK;
+    if(mNumDeltaWords < REWIND_KEYFRAME_TICKS * MAX_DELTA_WORDS)
+    {
+        mNumDeltaWords = REWIND_KEYFRAME_TICKS * MAX_DELTA_WORDS;
+    }
+
+    mKeyframes = new GameWorldState[mNumKeyframes];
+    mTickOffsets = new uint32_t[mMaxTicks];
+    mDeltas = new uint32_t[mNumDeltaWords];
+    mScratch = new uint32_t[MAX_DELTA_WORDS];
+    mNewestState = new GameWorldState();
+
+    clear();
+}
+
+//-----------------------------------------------------------------------------------------
+
+RewindBuffer::~RewindBuffer()
+{
+    delete[] mKeyframes;
+    delete[] mTickOffsets;
+    delete[] mDeltas;
+    delete[] mScratch;
+    delete mNewestState;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RewindBuffer::clear()
+{
+    mFirstTick = 0;
+    mNumTicks = 0;
+    mDeltaStart = 0;
+    mDeltaEnd = 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RewindBuffer::push(const GameWorldState* state)
+{
+    uint32_t tick = mFirstTick + mNumTicks;
+
+    if(tick % REWIND_KEYFRAME_TICKS == 0)
+    {
+        // the keyframe ring is full when every keyframe has a tick held
+        if((mNumTicks + REWIND_KEYFRAME_TICKS - 1) / REWIND_KEYFRAME_TICKS == mNumKeyframes)
+        {
+            dropOldestKeyframe();
+        }
+
+        memcpy(&mKeyframes[(tick / REWIND_KEYFRAME_TICKS) % mNumKeyframes], state, sizeof(GameWorldState));
+
+        // a keyframe's tick has no delta, the next delta starts where it would have
+        mTickOffsets[tick % mMaxTicks] = mDeltaEnd;
+    }
+    else
+    {
+        // each run of changed words is a word of (unchanged words skipped << 16) | changed words,
+        //      followed by the XOR of each changed word, and a 0 word ends the delta
+        const uint32_t* newWords = (const uint32_t*)state;
+        const uint32_t* oldWords = (const uint32_t*)mNewestState;
+        uint32_t numWords = 0;
+        uint32_t skip = 0;
+        uint32_t i = 0;
+        while(i < STATE_WORDS)
+        {
+            if(newWords[i] == oldWords[i])
+            {
+                skip++;
+                i++;
+                continue;
+            }
+
+            uint32_t runHeader = numWords++;
+            uint32_t count = 0;
+            while(i < STATE_WORDS && newWords[i] != oldWords[i])
+            {
+                mScratch[numWords++] = newWords[i] ^ oldWords[i];
+                count++;
+                i++;
+            }
+
+            mScratch[runHeader] = (skip << RUN_SKIP_SHIFT) | count;
+            skip = 0;
+        }
+        mScratch[numWords++] = 0;
+
+        // make room, never dropping the keyframe of this tick
+        while(mDeltaEnd - mDeltaStart + numWords > mNumDeltaWords)
+        {
+            assert(mFirstTick + REWIND_KEYFRAME_TICKS <= tick);
+            dropOldestKeyframe();
+        }
+
+        mTickOffsets[tick % mMaxTicks] = mDeltaEnd;
+        for(uint32_t w = 0; w < numWords; ++w)
+        {
+            mDeltas[(mDeltaEnd + w) % mNumDeltaWords] = mScratch[w];
+        }
+        mDeltaEnd += numWords;
+    }
+
+    memcpy(mNewestState, state, sizeof(GameWorldState));
+    mNumTicks++;
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t RewindBuffer::stepBack(GameWorldState* state)
+{
+    if(mNumTicks < 2)
+    {
+        return false;
+    }
+
+    mNumTicks--;
+    uint32_t droppedTick = mFirstTick + mNumTicks;
+    uint32_t tick = droppedTick - 1;
+
+    if(droppedTick % REWIND_KEYFRAME_TICKS != 0)
+    {
+        // XORing a delta back out of its tick's state gives the tick before
+        applyDelta(droppedTick, (uint32_t*)mNewestState);
+    }
+    else
+    {
+        // the dropped tick was a keyframe, so rebuild from the keyframe before it
+        uint32_t keyframeTick = tick - tick % REWIND_KEYFRAME_TICKS;
+        memcpy(mNewestState, &mKeyframes[(keyframeTick / REWIND_KEYFRAME_TICKS) % mNumKeyframes], sizeof(GameWorldState));
+        for(uint32_t t = keyframeTick + 1; t <= tick; ++t)
+        {
+            applyDelta(t, (uint32_t*)mNewestState);
+        }
+    }
+
+    mDeltaEnd = mTickOffsets[droppedTick % mMaxTicks];
+
+    memcpy(state, mNewestState, sizeof(GameWorldState));
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t RewindBuffer::getNumTicks() const
+{
+    return mNumTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t RewindBuffer::getNumTicksRequested() const
+{
+    return mNumTicksRequested;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t RewindBuffer::getMemorySize() const
+{
+    return sizeof(RewindBuffer) +
+        mNumKeyframes * sizeof(GameWorldState) +
+        mMaxTicks * sizeof(uint32_t) +
+        mNumDeltaWords * sizeof(uint32_t) +
+        MAX_DELTA_WORDS * sizeof(uint32_t) +
+        sizeof(GameWorldState);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t RewindBuffer::getNumDeltaBytes() const
+{
+    return (mDeltaEnd - mDeltaStart) * sizeof(uint32_t);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RewindBuffer::dropOldestKeyframe()
+{
+    assert(mNumTicks >= REWIND_KEYFRAME_TICKS);
+
+    mFirstTick += REWIND_KEYFRAME_TICKS;
+    mNumTicks -= REWIND_KEYFRAME_TICKS;
+
+    // the next keyframe's offset is where its first delta starts
+    mDeltaStart = mNumTicks > 0 ? mTickOffsets[mFirstTick % mMaxTicks] : mDeltaEnd;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void RewindBuffer::applyDelta(const uint32_t tick, uint32_t* state) const
+{
+    uint32_t offset = mTickOffsets[tick % mMaxTicks];
+    uint32_t i = 0;
+    uint32_t runHeader = mDeltas[offset++ % mNumDeltaWords];
+    while(runHeader != 0)
+    {
+        i += runHeader >> RUN_SKIP_SHIFT;
+        uint32_t count = runHeader & RUN_COUNT_MASK;
+        for(uint32_t c = 0; c < count; ++c)
+        {
+            state[i++] ^= mDeltas[offset++ % mNumDeltaWords];
+        }
+        runHeader = mDeltas[offset++ % mNumDeltaWords];
+    }
+}
@@ -0,0 +1,109 @@
+
+#define REWIND_KEYFRAME_TICKS           32      // ticks between full snapshots
+#define REWIND_DELTA_WORDS_PER_TICK     32      // average room for each tick's delta, in 32-bit words
+
+struct GameWorldState;
+
+/*
+ * The last few seconds of a world's states, one per tick, for
+ * stepping a game backwards.
+ *
+ * Every REWIND_KEYFRAME_TICKS ticks, the whole GameWorldState
+ * is kept as a keyframe. The ticks in between are kept as the
+ * XOR of their state with the tick before's, with the unchanged
+ * words left out, so a tick where only the characters and timers
+ * moved takes a few dozen words rather than the whole state.
+ *
+ * Stepping back one tick XORs the newest tick's delta back out
+ * of the current state. Stepping back past a keyframe rebuilds
+ * the tick before it from the previous keyframe, so a step is
+ * never more than REWIND_KEYFRAME_TICKS deltas, however long
+ * the game has been going.
+ *
+ * Keyframes and deltas are kept in rings allocated up front, so
+ * pushing a tick never allocates. Once either ring is full, the
+ * oldest keyframe and its deltas are dropped together to make
+ * room. The delta ring is sized for REWIND_DELTA_WORDS_PER_TICK
+ * words a tick; if ticks change more than that on average, the
+ * buffer holds less history than asked for rather than growing.
+ */
+class RewindBuffer
+{
+public:
+
+    /*
+     * Allocates room for at least 'numSeconds' of history.
+     */
+    RewindBuffer(const uint32_t numSeconds);
+    ~RewindBuffer();
+
+    /*
+     * Drops all history.
+     */
+    void clear();
+
+    /*
+     * Adds the state of the next tick as the newest in the buffer.
+     * Padding in 'state' must be zeroed, so it doesn't show up in
+     * the delta.
+     */
+    void push(const GameWorldState* state);
+
+    /*
+     * Drops the newest tick, and copies the state of the tick before
+     * it to 'state'. Returns false, and leaves the buffer as is, if
+     * there is no earlier tick.
+     */
+    bool8_t stepBack(GameWorldState* state);
+
+    /*
+     * Returns the number of ticks of history held.
+     */
+    const uint32_t getNumTicks() const;
+
+    /*
+     * Returns the number of ticks of history the buffer was asked to
+     * hold. It holds more when deltas are small, and less when they
+     * overflow the delta ring.
+     */
+    const uint32_t getNumTicksRequested() const;
+
+    /*
+     * Returns the bytes allocated for the buffer, and the bytes of
+     * deltas held.
+     */
+    const uint32_t getMemorySize() const;
+    const uint32_t getNumDeltaBytes() const;
+
+private:
+
+    /*
+     * Drops the oldest keyframe and the deltas that follow it.
+     */
+    void dropOldestKeyframe();
+
+    /*
+     * XORs the delta of tick 'tick' into 'state'.
+     */
+    void applyDelta(const uint32_t tick, uint32_t* state) const;
+
+    uint32_t mNumTicksRequested;
+
+    GameWorldState* mKeyframes;         // ring of keyframes, the one for tick t is at (t / REWIND_KEYFRAME_TICKS) % mNumKeyframes
+    uint32_t mNumKeyframes;
+
+    uint32_t* mTickOffsets;             // ring of where each tick's delta starts in the delta ring, indexed by tick % mMaxTicks
+    uint32_t mMaxTicks;                 //      a keyframe tick has no delta, so its offset is where the next delta starts
+
+    uint32_t* mDeltas;                  // ring of delta words, see push() for the encoding
+    uint32_t mNumDeltaWords;
+    uint32_t mDeltaStart;               // offsets of the oldest delta word held and of the next to write
+    uint32_t mDeltaEnd;                 //      count up forever, and wrap around the ring when used
+
+    uint32_t* mScratch;                 // room for one delta, encoded before it's copied into the ring
+
+    GameWorldState* mNewestState;       // the newest tick's state, which the next delta is taken against
+
+    uint32_t mFirstTick;                // oldest tick held, always a keyframe, counted from the last clear()
+    uint32_t mNumTicks;
+};
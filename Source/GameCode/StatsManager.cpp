@@ -2,20 +2,24 @@
 #define STATS_MANAGER_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "glut.h"
-#include "..\\Framework\\baseTypes.h"
-#include "..\\Framework\\openglframework.h"
+#include "../Framework/baseTypes.h"
+#ifndef PACSIM_HEADLESS
+#include "../Framework/openGLFramework.h"
+#endif
 
 #include "Utilities.h"
 #include "StatsManager.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 
-#include <queue>
 #include "EventManager.h"
 
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
 #define HIGH_SCORE_FILE "Assets\\HighScore.dat"
 
 #define POINTS_PELLET       10      // points amounts
@@ -32,66 +36,49 @@
 #define MAX_GHOST_KILLS     16      // number of ghost kills for bonus
 
 
-StatsManager* StatsManager::_instance = nullptr;
-
-StatsManager::StatsManager()
+StatsManager::StatsManager(const GameWorld* world) :
+    mWorld(world),
+    mLevel(0),
+    mLives(0),
+    mScore(0),
+    mGhostsKilledOnPellet(0),
+    mGhostKillCount(0)
 {
 }
 
 //-----------------------------------------------------------------------------------------
 
-StatsManager* StatsManager::Instance()
-{
-    if(_instance == nullptr)
-    {
-        _instance = new StatsManager();
-    }
-
-    return _instance;
-}
-
-//-----------------------------------------------------------------------------------------
-
-const StatsManager* StatsManager::ConstInstace()
-{
-    if(_instance == nullptr)
-    {
-        _instance = new StatsManager();
-    }
-
-    return _instance;
-}
-
-//-----------------------------------------------------------------------------------------
-
 void StatsManager::init()
 {
-    mLevel = 0;
-    mLives = 0;
-    mScore = 0;
+    setLevel(0);
+    setLives(0);
+    setScore(0);
     mHighScore = 0;
     mPrevScore = 0;
 
-    mGhostsKilledOnPellet = 0;  // counts the number of ghosts killed for the current power pellet
-    mGhostKillCount = 0;        // counts total number of ghosts killed on this level
+    setGhostsKilledOnPellet(0);     // counts the number of ghosts killed for the current power pellet
+    setGhostKillCount(0);           // counts total number of ghosts killed on this level
 
     // read from high score file
+    //      headless simulations don't persist a high score
+#ifndef PACSIM_HEADLESS
     readHighScoreFile();
+#endif
 }
 
 //-----------------------------------------------------------------------------------------
 
 void StatsManager::reset()
 {
-    mLevel = 1;                 // start on level 1
-    mLives = 3;                 // with 3 lives (1st one is consumed on level start)
-    mScore = 0;                 // with score of 0
+    setLevel(1);                // start on level 1
+    setLives(3);                // with 3 lives (1st one is consumed on level start)
+    setScore(0);                // with score of 0
     mPrevScore = 0;
 
     mTableIndex = 0;            // used to look up values in lookup tables
 
-    mGhostsKilledOnPellet = 0;
-    mGhostKillCount = 0;
+    setGhostsKilledOnPellet(0);
+    setGhostKillCount(0);
 
     // reset all stats for level 1
     mPacmanSpeed = 0.8f;                // pacman speeds
@@ -111,7 +98,9 @@ void StatsManager::reset()
 
 void StatsManager::shutdown()
 {
+#ifndef PACSIM_HEADLESS
     writeHighScoreFile();
+#endif
 }
 
 //-----------------------------------------------------------------------------------------
@@ -143,13 +132,82 @@ void StatsManager::writeHighScoreFile()
 
 //-----------------------------------------------------------------------------------------
 
+void StatsManager::saveState(StatsState* state) const
+{
+    state->level = mLevel;
+    state->lives = mLives;
+    state->score = mScore;
+    state->highScore = mHighScore;
+    state->prevScore = mPrevScore;
+    state->tableIndex = mTableIndex;
+    state->ghostsKilledOnPellet = mGhostsKilledOnPellet;
+    state->ghostKillCount = mGhostKillCount;
+
+    state->pacmanSpeed = mPacmanSpeed;
+    state->pacmanSpeedDots = mPacmanSpeedDots;
+    state->pacmanSpeedScared = mPacmanSpeedScared;
+    state->pacmanSpeedScaredDots = mPacmanSpeedScaredDots;
+    state->ghostSpeed = mGhostSpeed;
+    state->ghostSpeedScared = mGhostSpeedScared;
+    state->ghostSpeedTunnel = mGhostSpeedTunnel;
+    state->cruiseElroySpeed = mCruiseElroySpeed;
+    state->cruiseElroyDots = mCruiseElroyDots;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::loadState(const StatsState* state)
+{
+    mLevel = state->level;
+    mLives = state->lives;
+    mScore = state->score;
+    mHighScore = state->highScore;
+    mPrevScore = state->prevScore;
+    mTableIndex = state->tableIndex;
+    mGhostsKilledOnPellet = state->ghostsKilledOnPellet;
+    mGhostKillCount = state->ghostKillCount;
+
+    mPacmanSpeed = state->pacmanSpeed;
+    mPacmanSpeedDots = state->pacmanSpeedDots;
+    mPacmanSpeedScared = state->pacmanSpeedScared;
+    mPacmanSpeedScaredDots = state->pacmanSpeedScaredDots;
+    mGhostSpeed = state->ghostSpeed;
+    mGhostSpeedScared = state->ghostSpeedScared;
+    mGhostSpeedTunnel = state->ghostSpeedTunnel;
+    mCruiseElroySpeed = state->cruiseElroySpeed;
+    mCruiseElroyDots = state->cruiseElroyDots;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::loadLevelState(const StatsState* state, const bool8_t isNewGame)
+{
+    int32_t highScore = mHighScore;
+    int32_t score = mScore;
+    int32_t prevScore = mPrevScore;
+    int32_t lives = mLives;
+
+    loadState(state);
+
+    // the high score carries over into every game, the score and lives into the next level
+    mHighScore = highScore;
+    if(!isNewGame)
+    {
+        setScore(score);
+        setLives(lives);
+        mPrevScore = prevScore;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
 void StatsManager::nextLevel()
 {
     // increments level number and resets the ghost kill counters
-    mGhostsKilledOnPellet = 0;
-    mGhostKillCount = 0;
+    setGhostsKilledOnPellet(0);
+    setGhostKillCount(0);
 
-    mLevel++;
+    setLevel(mLevel + 1);
     mTableIndex = mLevel < 21 ? mLevel - 1 : 20;
 
     // some stats follow a mathematical pattern and may be updated this way instead of stored in a large table
@@ -184,10 +242,12 @@ void StatsManager::nextLevel()
             mPacmanSpeedScaredDots -= 0.04f;
             break;
 
+#ifndef PACSIM_HEADLESS
         case 256:
             g_keys->keyDown[VK_ESCAPE] = true;  // kill screen at level 256
             keyProcess();
             break;
+#endif
     }
 }
 
@@ -197,15 +257,15 @@ void StatsManager::consumeLife()
 {
     if(mLives > 0)
     {
-        mLives--;
+        setLives(mLives - 1);
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void StatsManager::pelletCollected()
+void StatsManager::pelletCollected(const int32_t numPellets)
 {
-    updateScore(POINTS_PELLET);
+    updateScore(POINTS_PELLET * numPellets);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -214,7 +274,7 @@ void StatsManager::powerPelletCollected()
 {
     // collecting a power pellet resets the counter for the number
     // of ghosts killed on the current power pellet
-    mGhostsKilledOnPellet = 0;
+    setGhostsKilledOnPellet(0);
     updateScore(POINTS_POWER_PELLET);
 }
 
@@ -222,8 +282,8 @@ void StatsManager::powerPelletCollected()
 
 void StatsManager::ghostKilled()
 {
-    mGhostsKilledOnPellet++;
-    mGhostKillCount++;
+    setGhostsKilledOnPellet(mGhostsKilledOnPellet + 1);
+    setGhostKillCount(mGhostKillCount + 1);
 
     switch(mGhostsKilledOnPellet)
     {
@@ -292,13 +352,13 @@ void StatsManager::fruitCollected()
 void StatsManager::updateScore(const int32_t points)
 {
     mPrevScore = mScore;
-    mScore += points;
+    setScore(mScore + points);
 
     // extra lives at 10k and 100k points
     if((mScore >= EXTRA_LIFE_ONE && mPrevScore < EXTRA_LIFE_ONE) || (mScore >= EXTRA_LIFE_TWO && mPrevScore < EXTRA_LIFE_TWO))
     {
-        EventManager::ConstInstace()->postSoundEvent(EventManager::SoundEvent::SOUND_EXTRA_LIFE);
-        mLives++;
+        mWorld->getConstEventManager()->postSoundEvent(EventManager::SoundEvent::SOUND_EXTRA_LIFE);
+        setLives(mLives + 1);
     }
 
     // update high score
@@ -317,6 +377,13 @@ const int32_t StatsManager::getHighScore() const
 
 //-----------------------------------------------------------------------------------------
 
+const int32_t StatsManager::getLevel() const
+{
+    return mLevel;
+}
+
+//-----------------------------------------------------------------------------------------
+
 const int32_t StatsManager::getScore() const
 {
     return mScore;
@@ -449,3 +516,43 @@ const float_t StatsManager::getCruiseElroyDots_2() const
 {
     return mCruiseElroyDots / 2.0f;
 }
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::setLevel(const int32_t level)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::LEVEL), mLevel, level);
+    mLevel = level;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::setLives(const int32_t lives)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::LIVES), mLives, lives);
+    mLives = lives;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::setScore(const int32_t score)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::SCORE), mScore, score);
+    mScore = score;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::setGhostsKilledOnPellet(const int32_t numKilled)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOSTS_KILLED_ON_PELLET), mGhostsKilledOnPellet, numKilled);
+    mGhostsKilledOnPellet = numKilled;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void StatsManager::setGhostKillCount(const int32_t numKilled)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::GHOST_KILL_COUNT), mGhostKillCount, numKilled);
+    mGhostKillCount = numKilled;
+}
@@ -1,4 +1,7 @@
 
+class GameWorld;
+struct StatsState;
+
 /*
  * Manages the current level, score, highscore,
  * and stats for speed and timing.
@@ -14,8 +17,7 @@ class StatsManager
 {
 public:
 
-    static StatsManager* Instance();
-    static const StatsManager* ConstInstace();
+    StatsManager(const GameWorld* world);
     void init();
 
     /*
@@ -39,6 +41,20 @@ public:
      */
     void writeHighScoreFile();
 
+    /*
+     * Copies the level, score, and stats out to 'state',
+     * or back in from it.
+     */
+    void saveState(StatsState* state) const;
+    void loadState(const StatsState* state);
+
+    /*
+     * Loads a level's start state from 'state', keeping the high
+     * score, and unless 'isNewGame' the score and lives, which
+     * carry over. See GameWorld::startLevel().
+     */
+    void loadLevelState(const StatsState* state, const bool8_t isNewGame);
+
     /*
      * Increments the level counter and updates stats
      * values.
@@ -51,9 +67,9 @@ public:
     void consumeLife();
 
     /*
-     * Updates the score for a collected pellet.
+     * Updates the score for 'numPellets' collected pellets.
      */
-    void pelletCollected();
+    void pelletCollected(const int32_t numPellets);
 
     /*
      * Updates the score for a collected power pellet,
@@ -84,6 +100,11 @@ public:
      */
     const int32_t getHighScore() const;
 
+    /*
+     * Returns the current level number.
+     */
+    const int32_t getLevel() const;
+
     /*
      * Returns the score.
      */
@@ -136,15 +157,23 @@ public:
 
 private:
 
-    StatsManager();
-
     /*
      * Adds 'points' to score, and updates the highscore
      * if necessary.
      */
     void updateScore(const int32_t points);
 
-    static StatsManager* _instance;
+    /*
+     * Setters for the level, lives, score, and ghost kill counts,
+     * which keep the world's Zobrist hash up to date.
+     */
+    void setLevel(const int32_t level);
+    void setLives(const int32_t lives);
+    void setScore(const int32_t score);
+    void setGhostsKilledOnPellet(const int32_t numKilled);
+    void setGhostKillCount(const int32_t numKilled);
+
+    const GameWorld* mWorld;
 
     int32_t mLevel;
     int32_t mLives;
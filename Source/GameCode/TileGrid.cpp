@@ -0,0 +1,820 @@
+
+#define TILE_GRID_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include <string.h>
+#include "../Framework/baseTypes.h"
+
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "WorldState.h"
+#include "BoardFile.h"
+
+#include "EventManager.h"
+
+#define HALF_TILE_SPRITE_SIZE       TILE_SPRITE_OFFSET_FACTOR/2.0f
+
+#define PELLET_SIZE             5.0f*3.25f/2.0f
+#define POWER_PELLET_SIZE       15.0f*3.25f/2.0f
+
+#define TILE_ANIM_CHUNK_SIZE    1.0f/NUM_TILE_ANIM_CHUNKS
+#define TILE_ROW_SIZE           1.0f/NUM_TILE_TEXTURE_ROWS
+#define TILE_COL_SIZE           1.0f/(NUM_TILE_TEXTURE_COLS*NUM_TILE_ANIM_CHUNKS)
+
+#define TILE_FRAME_DELTA_TIME   250
+
+static_assert(NUM_BOARD_COLS < sizeof(PelletRow) * 8, "a board row must fit in one PelletRow");
+
+TileGrid::TileGrid() :
+#ifndef PACSIM_HEADLESS
+    mTileDisplayList(0),
+    mNumPelletQuads(0),
+    mPelletVerts(nullptr),
+    mStartPelletVerts(nullptr),
+    mPelletTexCoords(nullptr),
+#endif
+    mNumDecisionTiles(0),
+    mDecisionRanks(nullptr),
+    mFlashStartTime(0),
+    mIsFlashing(false)
+{
+    // every tile starts as a wall with no pellet and no neighbors
+    for(int32_t index = 0; index < NUM_BOARD_TILES; ++index)
+    {
+        mTraverseType[index] = TileTraverseType::NON_TRAVERSABLE;
+        mTextureOffset[index].x = 0.0f;
+        mTextureOffset[index].y = 0.0f;
+
+        for(int32_t direction = GameUtil::BoardDirection::UP; direction != GameUtil::BoardDirection::INVAL; ++direction)
+        {
+            mNeighbors[index][direction] = TILE_INVAL;
+        }
+
+#ifndef PACSIM_HEADLESS
+        mPelletQuad[index] = -1;
+#endif
+        mDecisionSlot[index] = -1;
+    }
+
+    memset(mPellets, 0, sizeof(mPellets));
+    memset(mPowerPellets, 0, sizeof(mPowerPellets));
+    memset(mStartPellets, 0, sizeof(mStartPellets));
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::init(const Coord2D& boardPosition)
+{
+    mBoardPosition.x = boardPosition.x;
+    mBoardPosition.y = boardPosition.y;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::reset()
+{
+    // turn the pellets back on
+    memcpy(mPellets, mStartPellets, sizeof(mPellets));
+#ifndef PACSIM_HEADLESS
+    if(mNumPelletQuads > 0)
+    {
+        memcpy(mPelletVerts, mStartPelletVerts, mNumPelletQuads * 4 * sizeof(Coord2D));
+    }
+#endif
+
+    // stop the flash animation
+    mIsFlashing = false;
+    mFlashStartTime = 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::saveState(TileGridState* state) const
+{
+    memcpy(state->pellets, mPellets, sizeof(mPellets));
+    state->flashStartTime = mFlashStartTime;
+    state->isFlashing = mIsFlashing;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::loadState(const TileGridState* state)
+{
+#ifndef PACSIM_HEADLESS
+    // restore or collapse the quads of pellets that were collected or put back since the save
+    for(int32_t row = 0; row < NUM_BOARD_ROWS; ++row)
+    {
+        PelletRow changed = mPellets[row] ^ state->pellets[row];
+        for(int32_t col = 0; changed != 0; ++col, changed >>= 1)
+        {
+            if((changed & 1) != 0)
+            {
+                int32_t quad = mPelletQuad[getTileIndex(row, col)];
+                Coord2D* verts = &mPelletVerts[quad * 4];
+                if((state->pellets[row] & ((PelletRow)1 << col)) != 0)
+                {
+                    memcpy(verts, &mStartPelletVerts[quad * 4], 4 * sizeof(Coord2D));
+                }
+                else
+                {
+                    verts[1] = verts[2] = verts[3] = verts[0];
+                }
+            }
+        }
+    }
+#endif
+
+    memcpy(mPellets, state->pellets, sizeof(mPellets));
+    mFlashStartTime = state->flashStartTime;
+    mIsFlashing = state->isFlashing;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::shutdown()
+{
+#ifndef PACSIM_HEADLESS
+    if(mTileDisplayList != 0)
+    {
+        glDeleteLists(mTileDisplayList, 1);
+        mTileDisplayList = 0;
+    }
+
+    delete[] mPelletVerts;
+    delete[] mStartPelletVerts;
+    delete[] mPelletTexCoords;
+    mPelletVerts = mStartPelletVerts = mPelletTexCoords = nullptr;
+    mNumPelletQuads = 0;
+#endif
+
+    delete[] mDecisionRanks;
+    mDecisionRanks = nullptr;
+    mNumDecisionTiles = 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
+void TileGrid::drawTiles(const uint32_t gameTime)
+{
+    // compile the maze quads once, using the first animation chunk
+    if(mTileDisplayList == 0)
+    {
+        Coord2D vertTR, vertBL, textureSize;
+
+        textureSize.x = TILE_COL_SIZE;
+        textureSize.y = TILE_ROW_SIZE;
+
+        mTileDisplayList = glGenLists(1);
+        glNewList(mTileDisplayList, GL_COMPILE);
+        glBegin(GL_QUADS);
+
+        for(TileIndex index = 0; index < NUM_BOARD_TILES; ++index)
+        {
+            // offset vert positions so the tile's position is its center
+            Coord2D position = getPosition(index);
+            vertTR.x = (position.x + HALF_TILE_SPRITE_SIZE);
+            vertTR.y = (position.y - HALF_TILE_SPRITE_SIZE);
+            vertBL.x = (position.x - HALF_TILE_SPRITE_SIZE);
+            vertBL.y = (position.y + HALF_TILE_SPRITE_SIZE);
+
+            GameUtil::Utilities::drawSprite(vertTR, vertBL, mTextureOffset[index], textureSize);
+        }
+
+        glEnd();
+        glEndList();
+    }
+
+    glColor4ub(0xFF, 0xFF, 0xFF, 0xFF);
+
+    // all tiles flash together, so the animation frame is a single texture offset
+    int32_t animFrame = mIsFlashing ? ((gameTime - mFlashStartTime) / TILE_FRAME_DELTA_TIME) % NUM_TILE_ANIM_CHUNKS : 0;
+
+    glMatrixMode(GL_TEXTURE);
+    glPushMatrix();
+    glTranslatef(animFrame * TILE_ANIM_CHUNK_SIZE, 0.0f, 0.0f);
+
+    glCallList(mTileDisplayList);
+
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
+#endif
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
+void TileGrid::drawPellets()
+{
+    glColor4ub(0xFF, 0xFF, 0xFF, 0xFF);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glVertexPointer(2, GL_FLOAT, 0, mPelletVerts);
+    glTexCoordPointer(2, GL_FLOAT, 0, mPelletTexCoords);
+    glDrawArrays(GL_QUADS, 0, mNumPelletQuads * 4);
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+#endif
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
+void TileGrid::buildPelletQuads()
+{
+    delete[] mPelletVerts;
+    delete[] mStartPelletVerts;
+    delete[] mPelletTexCoords;
+
+    mNumPelletQuads = getNumStartPellets();
+    mPelletVerts = new Coord2D[mNumPelletQuads * 4];
+    mStartPelletVerts = new Coord2D[mNumPelletQuads * 4];
+    mPelletTexCoords = new Coord2D[mNumPelletQuads * 4];
+
+    int32_t quad = 0;
+    for(TileIndex index = 0; index < NUM_BOARD_TILES; ++index)
+    {
+        int32_t row = getRow(index);
+        int32_t col = getCol(index);
+
+        mPelletQuad[index] = -1;
+        if(((mStartPellets[row] >> col) & 1) == 0) continue;
+
+        // set radius of the pellet based on the pellet type
+        float_t pelletSize = (mPowerPellets[row] >> col) & 1 ? POWER_PELLET_SIZE : PELLET_SIZE;
+
+        Coord2D position = getPosition(index);
+        Coord2D* verts = &mStartPelletVerts[quad * 4];
+        Coord2D* texCoords = &mPelletTexCoords[quad * 4];
+
+        // same corner order as Utilities::drawSprite
+        verts[0].x = position.x - pelletSize;   verts[0].y = position.y - pelletSize;     // top left
+        verts[1].x = position.x + pelletSize;   verts[1].y = position.y - pelletSize;     // top right
+        verts[2].x = position.x + pelletSize;   verts[2].y = position.y + pelletSize;     // bottom right
+        verts[3].x = position.x - pelletSize;   verts[3].y = position.y + pelletSize;     // bottom left
+
+        texCoords[0].x = 0.0f;  texCoords[0].y = 0.0f;
+        texCoords[1].x = 1.0f;  texCoords[1].y = 0.0f;
+        texCoords[2].x = 1.0f;  texCoords[2].y = 1.0f;
+        texCoords[3].x = 0.0f;  texCoords[3].y = 1.0f;
+
+        mPelletQuad[index] = (int16_t)quad;
+        quad++;
+    }
+
+    memcpy(mPelletVerts, mStartPelletVerts, mNumPelletQuads * 4 * sizeof(Coord2D));
+}
+#endif
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::load(const BoardFileData* data)
+{
+    memcpy(mTraverseType, data->traverseType, sizeof(mTraverseType));
+    memcpy(mNeighbors, data->neighbors, sizeof(mNeighbors));
+    memcpy(mStartPellets, data->pellets, sizeof(mStartPellets));
+    memcpy(mPowerPellets, data->powerPellets, sizeof(mPowerPellets));
+    memcpy(mTextureOffset, data->textureOffsets, sizeof(mTextureOffset));
+
+#ifndef PACSIM_HEADLESS
+    buildPelletQuads();
+#endif
+    buildDecisionTable();
+
+    reset();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::store(BoardFileData* data) const
+{
+    memcpy(data->traverseType, mTraverseType, sizeof(mTraverseType));
+    memcpy(data->neighbors, mNeighbors, sizeof(mNeighbors));
+    memcpy(data->pellets, mStartPellets, sizeof(mStartPellets));
+    memcpy(data->powerPellets, mPowerPellets, sizeof(mPowerPellets));
+    memcpy(data->textureOffsets, mTextureOffset, sizeof(mTextureOffset));
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::setTile(const TileIndex index, const TileTraverseType traverse, const TilePelletType pellet, const Coord2D& textureOffset)
+{
+    mTraverseType[index] = traverse;
+
+    PelletRow bit = (PelletRow)1 << getCol(index);
+    int32_t row = getRow(index);
+
+    mStartPellets[row] &= ~bit;
+    mPowerPellets[row] &= ~bit;
+    if(pellet != TilePelletType::NO_PELLET)
+    {
+        mStartPellets[row] |= bit;
+    }
+    if(pellet == TilePelletType::POWER_PELLET)
+    {
+        mPowerPellets[row] |= bit;
+    }
+    mPellets[row] = mStartPellets[row];
+
+    mTextureOffset[index].x = textureOffset.x;
+    mTextureOffset[index].y = textureOffset.y;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::connectTiles()
+{
+    for(int32_t y = 0; y < NUM_BOARD_ROWS; ++y)
+    {
+        for(int32_t x = 0; x < NUM_BOARD_COLS; ++x)
+        {
+            TileIndex* neighbors = mNeighbors[getTileIndex(y, x)];
+
+            // the order of the neighbors is important...
+            //      if two or more neighbors would place a ghost equidistant to its target,
+            //      the order of the neighbors is the priority with which the ghost chooses its next tile
+            neighbors[GameUtil::BoardDirection::UP] = y > 0 ? getTileIndex(y - 1, x) : TILE_INVAL;
+            neighbors[GameUtil::BoardDirection::LEFT] = x > 0 ? getTileIndex(y, x - 1) : TILE_INVAL;
+            neighbors[GameUtil::BoardDirection::DOWN] = y < NUM_BOARD_ROWS - 1 ? getTileIndex(y + 1, x) : TILE_INVAL;
+            neighbors[GameUtil::BoardDirection::RIGHT] = x < NUM_BOARD_COLS - 1 ? getTileIndex(y, x + 1) : TILE_INVAL;
+
+            // special case for left and right neighbors of teleport tiles
+            if(isTeleporter(getTileIndex(y, x)))
+            {
+                if(x == 0)
+                {
+                    // left teleporter's left neighbor is right teleporter
+                    neighbors[GameUtil::BoardDirection::LEFT] = getTileIndex(y, NUM_BOARD_COLS - 1);
+                }
+                else
+                {
+                    // right teleporter's right neighbor is left teleporter
+                    neighbors[GameUtil::BoardDirection::RIGHT] = getTileIndex(y, 0);
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t TileGrid::collectPellet(const TileIndex index, const EventManager* emInstance)
+{
+    bool8_t result = false;
+
+    // if this tile has a pellet that has not yet been collected...
+    TilePelletType pellet = getPelletType(index);
+    if(pellet != TilePelletType::NO_PELLET)
+    {
+        result = true;
+
+        emInstance->postSoundEvent(EventManager::SoundEvent::SOUND_PELLET);
+
+        if(pellet == TilePelletType::POWER_PELLET)
+        {
+            // scare ghosts if collected power pellet
+            emInstance->postEvent(EventManager::GameEvent::POINTS_POWER_PELLET);
+            emInstance->postEvent(EventManager::GameEvent::SCARE_GHOSTS);
+        }
+        else
+        {
+            emInstance->postEvent(EventManager::GameEvent::POINTS_PELLET, 1);
+        }
+
+        mPellets[getRow(index)] &= ~((PelletRow)1 << getCol(index));
+
+#ifndef PACSIM_HEADLESS
+        // collapse the pellet's quad so it is no longer drawn
+        Coord2D* verts = &mPelletVerts[mPelletQuad[index] * 4];
+        verts[1] = verts[2] = verts[3] = verts[0];
+#endif
+    }
+
+    // returns whether we collected a pellet or not
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::activateFlash(const uint32_t gameTime)
+{
+    mIsFlashing = true;
+    mFlashStartTime = gameTime;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TileIndex TileGrid::getNeighbor(const TileIndex index, const GameUtil::BoardDirection direction) const
+{
+    return mNeighbors[index][direction];
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TileIndex TileGrid::getTileAtOffset(const TileIndex index, const int32_t dx, const int32_t dy) const
+{
+    int32_t row = getRow(index);
+    int32_t col = getCol(index) + dx;
+
+    // along the row, wrap around if the end we went past is a teleporter, else stop at the edge
+    if(col < 0)
+    {
+        col = isTeleporter(getTileIndex(row, 0)) ? (col % NUM_BOARD_COLS + NUM_BOARD_COLS) % NUM_BOARD_COLS : 0;
+    }
+    else if(col >= NUM_BOARD_COLS)
+    {
+        col = isTeleporter(getTileIndex(row, NUM_BOARD_COLS - 1)) ? col % NUM_BOARD_COLS : NUM_BOARD_COLS - 1;
+    }
+
+    // along the column, always stop at the edge
+    row += dy;
+    if(row < 0)
+    {
+        row = 0;
+    }
+    else if(row >= NUM_BOARD_ROWS)
+    {
+        row = NUM_BOARD_ROWS - 1;
+    }
+
+    return getTileIndex(row, col);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TileIndex TileGrid::getTileAhead(const TileIndex index, const int32_t num, const GameUtil::BoardDirection direction) const
+{
+    switch(direction)
+    {
+        case GameUtil::BoardDirection::UP:      return getTileAtOffset(index, 0, -num);
+        case GameUtil::BoardDirection::LEFT:    return getTileAtOffset(index, -num, 0);
+        case GameUtil::BoardDirection::DOWN:    return getTileAtOffset(index, 0, num);
+        case GameUtil::BoardDirection::RIGHT:   return getTileAtOffset(index, num, 0);
+        default:                                return index;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TileIndex TileGrid::getTileIndex(const int32_t row, const int32_t col)
+{
+    return (TileIndex)((row * NUM_BOARD_COLS) + col);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t TileGrid::getRow(const TileIndex index)
+{
+    return index / NUM_BOARD_COLS;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t TileGrid::getCol(const TileIndex index)
+{
+    return index % NUM_BOARD_COLS;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const Coord2D TileGrid::getPosition(const TileIndex index) const
+{
+    Coord2D position;
+
+    // y position is reversed, need to compensate
+    position.x = mBoardPosition.x + (float)(getCol(index) - NUM_BOARD_COLS / 2.0f) * TILE_SPRITE_OFFSET_FACTOR;
+    position.y = mBoardPosition.y - (float)(getRow(index) - NUM_BOARD_ROWS / 2.0f) * TILE_SPRITE_OFFSET_FACTOR;
+
+    return position;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const Coord2D TileGrid::getPosition(const TilePosition& tilePosition) const
+{
+    Coord2D position;
+
+    // y position is reversed, need to compensate
+    position.x = mBoardPosition.x + ((float)tilePosition.x / TILE_UNITS - NUM_BOARD_COLS / 2.0f) * TILE_SPRITE_OFFSET_FACTOR;
+    position.y = mBoardPosition.y - ((float)tilePosition.y / TILE_UNITS - NUM_BOARD_ROWS / 2.0f) * TILE_SPRITE_OFFSET_FACTOR;
+
+    return position;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TilePosition TileGrid::getTilePosition(const TileIndex index)
+{
+    TilePosition position;
+    position.x = getCol(index) * TILE_UNITS;
+    position.y = getRow(index) * TILE_UNITS;
+
+    return position;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t TileGrid::getSquareDistBetween(const TilePosition& from, const TilePosition& to)
+{
+    int32_t diffX = to.x - from.x;
+    int32_t diffY = to.y - from.y;
+
+    return (uint32_t)(diffX * diffX) + (uint32_t)(diffY * diffY);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TileGrid::TileTraverseType TileGrid::getTraverseType(const TileIndex index) const
+{
+    return (TileTraverseType)mTraverseType[index];
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t TileGrid::isTeleporter(const TileIndex index) const
+{
+    return mTraverseType[index] == TileTraverseType::TELEPORT;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t TileGrid::isTunnel(const TileIndex index) const
+{
+    // teleporter tiles are also part of the tunnel
+    return mTraverseType[index] == TileTraverseType::TUNNEL || mTraverseType[index] == TileTraverseType::TELEPORT;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t TileGrid::isTraversable(const TileIndex index) const
+{
+    // traversible if not marked "non-traversable" or "ghost-traversable"
+    return mTraverseType[index] != TileTraverseType::NON_TRAVERSABLE && mTraverseType[index] != TileTraverseType::GHOST_TRAVERSABLE;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t TileGrid::isGhostTraversable(const TileIndex index) const
+{
+    // ghost traversible if not marked "non-traversable"
+    return mTraverseType[index] != TileTraverseType::NON_TRAVERSABLE;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const bool8_t TileGrid::isPelletPresent(const TileIndex index) const
+{
+    return (mPellets[getRow(index)] >> getCol(index)) & 1;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const TileGrid::TilePelletType TileGrid::getPelletType(const TileIndex index) const
+{
+    if(!isPelletPresent(index))
+    {
+        return TilePelletType::NO_PELLET;
+    }
+
+    return (mPowerPellets[getRow(index)] >> getCol(index)) & 1 ? TilePelletType::POWER_PELLET : TilePelletType::PELLET;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const PelletRow TileGrid::getPelletRow(const int32_t row) const
+{
+    return mPellets[row];
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t TileGrid::getNumPellets() const
+{
+    int32_t count = 0;
+    for(int32_t row = 0; row < NUM_BOARD_ROWS; ++row)
+    {
+        count += GameUtil::Utilities::popCount(mPellets[row]);
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t TileGrid::getNumStartPellets() const
+{
+    int32_t count = 0;
+    for(int32_t row = 0; row < NUM_BOARD_ROWS; ++row)
+    {
+        count += GameUtil::Utilities::popCount(mStartPellets[row]);
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t TileGrid::getNumPelletsInRadius(const TileIndex center, const int32_t radius) const
+{
+    int32_t centerRow = getRow(center);
+    int32_t centerCol = getCol(center);
+    int32_t count = 0;
+
+    for(int32_t dy = -radius; dy <= radius; ++dy)
+    {
+        int32_t row = centerRow + dy;
+        if(row < 0 || row >= NUM_BOARD_ROWS) continue;
+
+        // widest column offset on this row that is still inside the circle
+        int32_t halfWidth = radius;
+        while(halfWidth * halfWidth + dy * dy > radius * radius)
+        {
+            halfWidth--;
+        }
+
+        // mask the columns [centerCol - halfWidth, centerCol + halfWidth], clamped to the board
+        int32_t minCol = centerCol - halfWidth < 0 ? 0 : centerCol - halfWidth;
+        int32_t maxCol = centerCol + halfWidth >= NUM_BOARD_COLS ? NUM_BOARD_COLS - 1 : centerCol + halfWidth;
+
+        PelletRow mask = (((PelletRow)1 << (maxCol + 1)) - 1) & ~(((PelletRow)1 << minCol) - 1);
+        count += GameUtil::Utilities::popCount(mPellets[row] & mask);
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const float_t TileGrid::getSquareDistBetween(const TileIndex from, const TileIndex to) const
+{
+    Coord2D fromPos = getPosition(from);
+    Coord2D toPos = getPosition(to);
+    return GameUtil::Utilities::squareDistance(toPos.x, fromPos.x, toPos.y, fromPos.y);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const GameUtil::BoardDirection TileGrid::getDirectionClosestToTarget(const TileIndex index, const TileIndex prev,
+    const GameUtil::BoardDirection skipDirection, const TileIndex target) const
+{
+    int32_t slot = mDecisionSlot[index];
+    if(slot < 0)
+    {
+        return findDirectionClosestToTarget(index, prev, skipDirection, target);
+    }
+
+    // take the closest neighbor the ghost is allowed to move to
+    uint8_t ranks = mDecisionRanks[slot * NUM_BOARD_TILES + target];
+    for(int32_t rank = 0; rank < 4; ++rank)
+    {
+        GameUtil::BoardDirection direction = static_cast<GameUtil::BoardDirection>((ranks >> (rank * 2)) & 0x3);
+        TileIndex neighbor = mNeighbors[index][direction];
+
+        if(direction != skipDirection && neighbor != prev && neighbor != TILE_INVAL && isGhostTraversable(neighbor))
+        {
+            return direction;
+        }
+    }
+
+    return GameUtil::BoardDirection::INVAL;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const GameUtil::BoardDirection TileGrid::findDirectionClosestToTarget(const TileIndex index, const TileIndex prev,
+    const GameUtil::BoardDirection skipDirection, const TileIndex target) const
+{
+    float dist = 0.0f;
+    float minDist = FLT_MAX;
+    GameUtil::BoardDirection minDir = GameUtil::BoardDirection::INVAL;
+
+    TileIndex neighbor = TILE_INVAL;
+    GameUtil::BoardDirection direction = GameUtil::BoardDirection::INVAL;
+
+    // iterate through all directions, skip given direction
+    //      select direction that would put ghost closest to its target tile
+    for(uint32_t directionInt = GameUtil::BoardDirection::UP; directionInt != GameUtil::BoardDirection::INVAL; ++directionInt)
+    {
+        direction = static_cast<GameUtil::BoardDirection>(directionInt);
+        if(direction == skipDirection) continue;
+
+        // if the current neighbor is not the previous tile and is traversable...
+        neighbor = mNeighbors[index][direction];
+        if(neighbor != prev && neighbor != TILE_INVAL && isGhostTraversable(neighbor))
+        {
+            // check its distance, save direction of min values
+            //      since min is overwritten only on '<', ties are given priority via the order of the map
+            //      UP, LEFT, DOWN (RIGHT is never chosen in a tie because everything else is higher priority)
+            dist = getSquareDistBetween(neighbor, target);
+            if(dist < minDist)
+            {
+                minDist = dist;
+                minDir = direction;
+            }
+        }
+    }
+
+    return minDir;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TileGrid::buildDecisionTable()
+{
+    delete[] mDecisionRanks;
+    mNumDecisionTiles = 0;
+
+    // ghosts only choose by distance at intersections and the ghost home entrance
+    for(TileIndex index = 0; index < NUM_BOARD_TILES; ++index)
+    {
+        switch(mTraverseType[index])
+        {
+            case TileTraverseType::INTERSECTION:
+            case TileTraverseType::NO_UP_INTERSECTION:
+            case TileTraverseType::GHOST_HOME_ENTER:
+                mDecisionSlot[index] = (int16_t)mNumDecisionTiles++;
+                break;
+            default:
+                mDecisionSlot[index] = -1;
+                break;
+        }
+    }
+
+    mDecisionRanks = new uint8_t[mNumDecisionTiles * NUM_BOARD_TILES];
+
+    for(TileIndex index = 0; index < NUM_BOARD_TILES; ++index)
+    {
+        int32_t slot = mDecisionSlot[index];
+        if(slot < 0) continue;
+
+        for(TileIndex target = 0; target < NUM_BOARD_TILES; ++target)
+        {
+            // neighbors that can never be taken sort last, their order doesn't matter
+            float_t dist[4];
+            int32_t order[4];
+            for(int32_t direction = GameUtil::BoardDirection::UP; direction != GameUtil::BoardDirection::INVAL; ++direction)
+            {
+                TileIndex neighbor = mNeighbors[index][direction];
+                dist[direction] = neighbor != TILE_INVAL && isGhostTraversable(neighbor) ? getSquareDistBetween(neighbor, target) : FLT_MAX;
+                order[direction] = direction;
+            }
+
+            // insertion sort by distance, stable so ties keep direction order
+            for(int32_t i = 1; i < 4; ++i)
+            {
+                int32_t direction = order[i];
+                int32_t j = i;
+                for(; j > 0 && dist[direction] < dist[order[j - 1]]; --j)
+                {
+                    order[j] = order[j - 1];
+                }
+                order[j] = direction;
+            }
+
+            mDecisionRanks[slot * NUM_BOARD_TILES + target] = (uint8_t)(order[0] | (order[1] << 2) | (order[2] << 4) | (order[3] << 6));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const int32_t TileGrid::verifyDecisionTable() const
+{
+    int32_t numMismatches = 0;
+
+    const GameUtil::BoardDirection skipDirections[] = {
+        GameUtil::BoardDirection::INVAL,
+        GameUtil::BoardDirection::UP,
+        GameUtil::BoardDirection::DOWN
+    };
+
+    for(TileIndex index = 0; index < NUM_BOARD_TILES; ++index)
+    {
+        if(mDecisionSlot[index] < 0) continue;
+
+        // a ghost arrives from one of the neighbors, or from nowhere if it was placed on the tile
+        for(int32_t from = GameUtil::BoardDirection::UP; from <= GameUtil::BoardDirection::INVAL; ++from)
+        {
+            TileIndex prev = from != GameUtil::BoardDirection::INVAL ? mNeighbors[index][from] : index;
+
+            for(uint32_t skip = 0; skip < sizeof(skipDirections) / sizeof(skipDirections[0]); ++skip)
+            {
+                for(TileIndex target = 0; target < NUM_BOARD_TILES; ++target)
+                {
+                    if(getDirectionClosestToTarget(index, prev, skipDirections[skip], target) !=
+                        findDirectionClosestToTarget(index, prev, skipDirections[skip], target))
+                    {
+                        numMismatches++;
+                    }
+                }
+            }
+        }
+    }
+
+    return numMismatches;
+}
@@ -0,0 +1,347 @@
+#define NUM_BOARD_ROWS 36
+#define NUM_BOARD_COLS 28
+#define NUM_BOARD_TILES (NUM_BOARD_ROWS*NUM_BOARD_COLS)
+
+#define NUM_TILE_ANIM_CHUNKS    2
+#define NUM_TILE_TEXTURE_ROWS   6
+#define NUM_TILE_TEXTURE_COLS   4
+
+#define TILE_INVAL              -1
+
+#define TILE_SPRITE_SIZE            32
+#define TILE_SPRITE_OFFSET_FACTOR   (TILE_SPRITE_SIZE*3.25f)     // size of a tile in the OpenGL space
+
+#define TILE_UNITS              1024                            // fixed-point steps per tile
+
+class EventManager;
+struct BoardFileData;
+struct TileGridState;
+
+/*
+ * Index of a tile on the board, (row * NUM_BOARD_COLS) + col.
+ * TILE_INVAL is used where there is no tile, such as past
+ * the edge of the board.
+ */
+typedef int16_t TileIndex;
+
+/*
+ * Fixed-point position on the board, in 1/TILE_UNITS of a tile.
+ * x is the column and y is the row, so (0,0) is the center of the
+ * top left tile and y grows DOWN. Characters move in these units
+ * so their movement is exact integer math.
+ */
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+}TilePosition;
+
+/*
+ * One row of a pellet bitboard. Bit 'col' is set if the
+ * tile at that column has a pellet.
+ */
+typedef uint32_t PelletRow;
+
+/*
+ * The tiles of the board of play.
+ *
+ * Tiles are stored as flat arrays indexed by TileIndex rather
+ * than as objects, so the data characters read every frame
+ * (traverse type, pellets, and neighbors) sits in a few
+ * contiguous KB.
+ *
+ * Each tile has four neighbors, stored in the order of the
+ * directions UP, LEFT, DOWN, RIGHT. This way, we can look up a
+ * tile's neighbor in a direction with a single array load.
+ *
+ * Pellets are stored as bitboards, one PelletRow per board row.
+ * Counting the remaining pellets is a popcount per row, and a
+ * level reset copies the starting bitboard back over.
+ */
+class TileGrid
+{
+public:
+
+    /*
+     * Enumeration of traversal types.
+     */
+    typedef enum
+    {
+        NON_TRAVERSABLE,        // characters cannot go here
+        TRAVERSABLE,            // characters can go here
+        GHOST_TRAVERSABLE,      // only ghosts can go here
+
+        INTERSECTION,           // intersection, ghost decision zone
+        NO_UP_INTERSECTION,     // intersection, ghost decision zone, ghosts cannot choose up direction
+        GHOST_HOME_EXIT,        // intersection, ghost decision zone, exit for ghost home
+        GHOST_HOME_ENTER,       // intersection, ghost decision zone, entrance for ghost home
+
+        TELEPORT,               // one of two warp tiles
+        TUNNEL                  // tiles leading up to teleport
+    }TileTraverseType;
+
+    /*
+     * Enumeration of pellet states.
+     */
+    typedef enum
+    {
+        NO_PELLET,              // no pellet
+        PELLET,                 // spawns with normal pellet
+        POWER_PELLET            // spawns with power pellet
+    }TilePelletType;
+
+    TileGrid();
+
+    /*
+     * Stores the position of the board's center, which
+     * tile positions are offset from.
+     */
+    void init(const Coord2D& boardPosition);
+
+    /*
+     * Turns all pellets back on and stops the flash animation.
+     */
+    void reset();
+
+    /*
+     * Copies the uncollected pellets and the flash animation
+     * out to 'state', or back in from it. Loading only touches
+     * the pellet quads of pellets that differ.
+     */
+    void saveState(TileGridState* state) const;
+    void loadState(const TileGridState* state);
+
+    /*
+     * Releases the grid's OpenGL resources.
+     */
+    void shutdown();
+
+    /*
+     * Draws every tile sprite. Takes into account animation frame.
+     *
+     * The maze never changes, so its quads are compiled into a display
+     * list on the first draw and replayed after. The flash animation
+     * shifts the texture matrix over to the second animation chunk
+     * rather than rebuilding the quads. The frame is derived from
+     * 'gameTime' and the time the flash started.
+     */
+    void drawTiles(const uint32_t gameTime);
+
+    /*
+     * Draws the pellet sprite of every tile with an uncollected pellet.
+     *
+     * Pellet quads are kept in a vertex array built when the board is
+     * loaded. Collecting a pellet collapses its quad to a point, and a
+     * reset copies the starting quads back, so drawing is a single
+     * glDrawArrays with no per-pellet work.
+     */
+    void drawPellets();
+
+    /*
+     * Copies the tiles, neighbors, and pellets of a compiled board
+     * into the grid, and resets the grid.
+     */
+    void load(const BoardFileData* data);
+
+    /*
+     * Copies the tiles, neighbors, and pellets of the grid into
+     * 'data'. Used by the board compiler.
+     */
+    void store(BoardFileData* data) const;
+
+    /*
+     * Sets the traversal type, starting pellet, and texture offset
+     * of the tile at 'index'. Used by the board compiler.
+     */
+    void setTile(const TileIndex index, const TileTraverseType traverse, const TilePelletType pellet, const Coord2D& textureOffset);
+
+    /*
+     * Connects each tile to its neighbors. Used by the board compiler. The left teleporter's
+     * left neighbor is the right teleporter, and vice versa.
+     * Neighbors past the edge of the board are TILE_INVAL.
+     */
+    void connectTiles();
+
+    /*
+     * If the tile at 'index' has an uncollected pellet, marks it as
+     * collected, posts the pellet events to 'emInstance', and returns
+     * true. Otherwise, returns false.
+     */
+    bool8_t collectPellet(const TileIndex index, const EventManager* emInstance);
+
+    /*
+     * Activates the flash animation of all tiles, starting at 'gameTime'.
+     */
+    void activateFlash(const uint32_t gameTime);
+
+    /*
+     * Returns the neighbor of 'index' in the given direction.
+     */
+    const TileIndex getNeighbor(const TileIndex index, const GameUtil::BoardDirection direction) const;
+
+    /*
+     * Returns the tile 'dx' columns along the row of 'index', then 'dy'
+     * rows along that column (negative is LEFT and UP). This is the
+     * tile found by stepping through neighbors one at a time: steps
+     * off the edge of the board stop at the edge, except through a
+     * teleporter, which wraps around to the other end of the row.
+     *
+     * Teleporters are always at the ends of a row, so this is index
+     * arithmetic rather than a walk.
+     */
+    const TileIndex getTileAtOffset(const TileIndex index, const int32_t dx, const int32_t dy) const;
+
+    /*
+     * Returns the tile 'num' tiles from 'index' in the given direction,
+     * as getTileAtOffset.
+     */
+    const TileIndex getTileAhead(const TileIndex index, const int32_t num, const GameUtil::BoardDirection direction) const;
+
+    /*
+     * Conversions between a tile index and its (row, col) on the board.
+     */
+    static const TileIndex getTileIndex(const int32_t row, const int32_t col);
+    static const int32_t getRow(const TileIndex index);
+    static const int32_t getCol(const TileIndex index);
+
+    /*
+     * Returns the (x,y) position of the tile in the OpenGL space.
+     */
+    const Coord2D getPosition(const TileIndex index) const;
+
+    /*
+     * Returns the (x,y) position of a fixed-point board position
+     * in the OpenGL space. Tile centers match getPosition(index).
+     */
+    const Coord2D getPosition(const TilePosition& position) const;
+
+    /*
+     * Returns the fixed-point position of the tile's center.
+     */
+    static const TilePosition getTilePosition(const TileIndex index);
+
+    /*
+     * Returns the square-distance between two fixed-point positions.
+     * Any two positions on the board fit in 32 bits.
+     */
+    static const uint32_t getSquareDistBetween(const TilePosition& from, const TilePosition& to);
+
+    /*
+     * Various getter functions for the traversal type of
+     * a tile.
+     */
+    const TileTraverseType getTraverseType(const TileIndex index) const;
+    const bool8_t isTeleporter(const TileIndex index) const;
+    const bool8_t isTunnel(const TileIndex index) const;
+    const bool8_t isTraversable(const TileIndex index) const;
+    const bool8_t isGhostTraversable(const TileIndex index) const;
+
+    /*
+     * Returns true if the tile has an uncollected pellet.
+     */
+    const bool8_t isPelletPresent(const TileIndex index) const;
+
+    /*
+     * Returns the type of the uncollected pellet on the tile,
+     * or NO_PELLET if it has been collected.
+     */
+    const TilePelletType getPelletType(const TileIndex index) const;
+
+    /*
+     * Returns the row of the pellet bitboard for the given board row.
+     */
+    const PelletRow getPelletRow(const int32_t row) const;
+
+    /*
+     * Returns the number of uncollected pellets on the board, and the
+     * number of pellets the board starts with.
+     */
+    const int32_t getNumPellets() const;
+    const int32_t getNumStartPellets() const;
+
+    /*
+     * Returns the number of uncollected pellets on tiles within
+     * 'radius' tiles (straight-line distance) of 'center'.
+     */
+    const int32_t getNumPelletsInRadius(const TileIndex center, const int32_t radius) const;
+
+    /*
+     * Returns the square-distance between the positions of two tiles.
+     */
+    const float_t getSquareDistBetween(const TileIndex from, const TileIndex to) const;
+
+    /*
+     * Returns the direction a ghost at 'index' takes to get closest to
+     * 'target', never going back to 'prev' or going in 'skipDirection'.
+     * Ties go to UP, then LEFT, DOWN, and RIGHT.
+     *
+     * For decision tiles (intersections and the ghost home entrance),
+     * this is a load from the decision table. Other tiles fall back to
+     * findDirectionClosestToTarget.
+     */
+    const GameUtil::BoardDirection getDirectionClosestToTarget(const TileIndex index, const TileIndex prev,
+        const GameUtil::BoardDirection skipDirection, const TileIndex target) const;
+
+    /*
+     * Same as getDirectionClosestToTarget, but compares the distance
+     * from each neighbor to the target rather than using the table.
+     */
+    const GameUtil::BoardDirection findDirectionClosestToTarget(const TileIndex index, const TileIndex prev,
+        const GameUtil::BoardDirection skipDirection, const TileIndex target) const;
+
+    /*
+     * Checks the decision table against findDirectionClosestToTarget for
+     * every decision tile, previous tile, skip direction, and target.
+     * Returns the number of decisions that don't match.
+     */
+    const int32_t verifyDecisionTable() const;
+
+private:
+
+    // hot data, read by characters every frame
+
+    uint8_t mTraverseType[NUM_BOARD_TILES];
+    TileIndex mNeighbors[NUM_BOARD_TILES][4];           // neighbors in the order UP, LEFT, DOWN, RIGHT
+
+    PelletRow mPellets[NUM_BOARD_ROWS];                 // uncollected pellets
+    PelletRow mPowerPellets[NUM_BOARD_ROWS];            // tiles that spawn with a power pellet rather than a normal one
+
+    // cold data, only read on reset and draw
+
+    PelletRow mStartPellets[NUM_BOARD_ROWS];            // pellets the board spawns with
+    Coord2D mTextureOffset[NUM_BOARD_TILES];            // percent offset from texture file origin to each tile's image
+
+    Coord2D mBoardPosition;
+
+    /*
+     * Builds the decision table from the loaded tiles. Needs the
+     * board position, since distances are between tile positions.
+     */
+    void buildDecisionTable();
+
+    // decision table, for each decision tile and target tile, the four directions out of the decision tile
+    //      packed 2 bits each, ordered by the distance of that neighbor to the target (ties in direction order)
+    //      a decision is the first of those that the ghost is allowed to take
+
+    int16_t mDecisionSlot[NUM_BOARD_TILES];             // row of each tile in the decision table, -1 if not a decision tile
+    int32_t mNumDecisionTiles;
+    uint8_t* mDecisionRanks;                            // mNumDecisionTiles rows of NUM_BOARD_TILES targets
+
+#ifndef PACSIM_HEADLESS
+    /*
+     * Builds the pellet vertex arrays from the starting pellets.
+     */
+    void buildPelletQuads();
+
+    GLuint mTileDisplayList;                            // maze quads, compiled on the first draw
+
+    int16_t mPelletQuad[NUM_BOARD_TILES];               // quad of each tile's pellet in the pellet arrays, -1 if none
+    int32_t mNumPelletQuads;
+    Coord2D* mPelletVerts;                              // 4 verts per pellet, collapsed to a point once collected
+    Coord2D* mStartPelletVerts;
+    Coord2D* mPelletTexCoords;
+#endif
+
+    uint32_t mFlashStartTime;                           // all tiles flash together
+    bool8_t mIsFlashing;
+};
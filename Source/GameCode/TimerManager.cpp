@@ -2,101 +2,93 @@
 #define TIMER_MANAGER_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "..\\Framework\\baseTypes.h"
+#include "../Framework/baseTypes.h"
 
 #include "TimerManager.h"
 
-#include <queue>
 #include "EventManager.h"
 
 #include "Utilities.h"
+#include "TileGrid.h"
+#include "WorldState.h"
 #include "StatsManager.h"
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
 
 
 #define START_GAME_PAUSE_DURATION   4000
-#define START_GAME_HALF             2000
+#define START_GAME_PAUSE_HALF       2000
 
 #define END_GAME_PAUSE_DURATION     3000
-#define END_GAME_HALF               1500
+#define END_GAME_PAUSE_HALF         1500
 
 #define GHOST_KILL_PAUSE_DURATION   750
 
+static_assert(TimerManager::NUM_TIMERS == NUM_STATE_TIMERS, "TimerState must hold every timer");
+static_assert(TimerManager::NUM_TIMERS <= NUM_OWNER_TIMERS, "the world must have room for every timer");
 
-TimerManager* TimerManager::_instance = nullptr;
 
-TimerManager::TimerManager()
+TimerManager::TimerManager(const GameWorld* world) :
+    mWorld(world),
+    mWillConsumeLife(false),
+    mDidLose(false)
 {
+    for(int32_t id = 0; id < NUM_TIMERS; ++id)
+    {
+        mTimers[id] = 0;
+    }
 }
 
 //-----------------------------------------------------------------------------------------
 
-TimerManager* TimerManager::Instance()
+void TimerManager::init()
 {
-    if(_instance == nullptr)
-    {
-        _instance = new TimerManager();
-    }
-
-    return _instance;
 }
 
 //-----------------------------------------------------------------------------------------
 
-const TimerManager* TimerManager::ConstInstace()
+void TimerManager::reset()
 {
-    if(_instance == nullptr)
+    // cancel all timers
+    for(int32_t id = 0; id < NUM_TIMERS; ++id)
     {
-        _instance = new TimerManager();
+        setTimer((TimerID)id, 0);
     }
 
-    return _instance;
-}
-
-//-----------------------------------------------------------------------------------------
-
-void TimerManager::init()
-{
+    // reset boolean values
+    setWillConsumeLife(false);
+    setDidLose(false);
 }
 
 //-----------------------------------------------------------------------------------------
 
-void TimerManager::reset()
+void TimerManager::saveState(TimerState* state) const
 {
-    // reset timer values to 0
-    mStartGameTimer = 0;
-    mEndGameTimer = 0;
-    mDeadGhostTimer = 0;
+    for(int32_t id = 0; id < NUM_TIMERS; ++id)
+    {
+        state->timers[id] = mTimers[id];
+    }
 
-    // reset boolean values
-    mHalfPauseTimePassed = false;
-    mWillConsumeLife = false;
-    mDidLose = false;
+    state->willConsumeLife = mWillConsumeLife;
+    state->didLose = mDidLose;
 }
 
 //-----------------------------------------------------------------------------------------
 
-void TimerManager::updateTimers(DWORD milliseconds)
+void TimerManager::loadState(const TimerState* state)
 {
-    // check if we need to update each timer
-    //      start level and end level timers are given higher priority than the dead ghost timer
-    if(mStartGameTimer > 0)
-    {
-        updateStartGameTimer(milliseconds);
-    }
-    
-    else if(mEndGameTimer > 0)
-    {
-        updateEndGameTimer(milliseconds);
-    }
-    
-    else if(mDeadGhostTimer > 0)
+    // the world's timers are cleared as a state is loaded, so the set ones go back on
+    for(int32_t id = 0; id < NUM_TIMERS; ++id)
     {
-        updateDeadGhostTimer(milliseconds);
+        mTimers[id] = state->timers[id];
+        mWorld->setTimer(GameWorld::TimerOwner::TIMER_MANAGER, id, mTimers[id]);
     }
+
+    mWillConsumeLife = state->willConsumeLife;
+    mDidLose = state->didLose;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -107,94 +99,124 @@ void TimerManager::shutdown()
 
 //-----------------------------------------------------------------------------------------
 
-void TimerManager::updateStartGameTimer(DWORD milliseconds)
+void TimerManager::handleTimer(const TimerID id)
 {
-    mStartGameTimer -= milliseconds;
+    // the timer is off the wheel, so it's cleared before handling it can set it again
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::TIMER, id), mTimers[id], 0);
+    mTimers[id] = 0;
 
-    if(mStartGameTimer <= 0)
-    {
-        // timer finished, unpause game 
-        const EventManager* emInstance = EventManager::ConstInstace();
-        emInstance->postEvent(EventManager::GameEvent::UI_ENTER_GAME);
-        emInstance->postEvent(EventManager::GameEvent::UNPAUSE);
-        mStartGameTimer = 0;
-    }
-    else if(mStartGameTimer < START_GAME_HALF && !mHalfPauseTimePassed)
+    const EventManager* emInstance = mWorld->getConstEventManager();
+    switch(id)
     {
-        // start game pause half over, make characters visible
-        const EventManager* emInstance = EventManager::ConstInstace();
-        emInstance->postEvent(EventManager::GameEvent::UI_ENTER_PREGAME_2);
-        emInstance->postEvent(EventManager::GameEvent::CHARACTERS_VISIBLE);
-        mHalfPauseTimePassed = true;
-
-        // if flagged to consume a life on startup, do so
-        if(mWillConsumeLife)
+        case START_GAME_HALF:
         {
-            emInstance->postEvent(EventManager::GameEvent::CONSUME_LIFE);
-        }
-    }
-}
+            // start game pause half over, make characters visible
+            emInstance->postEvent(EventManager::GameEvent::UI_ENTER_PREGAME_2);
+            emInstance->postEvent(EventManager::GameEvent::CHARACTERS_VISIBLE);
 
-//-----------------------------------------------------------------------------------------
+            // if flagged to consume a life on startup, do so
+            if(mWillConsumeLife)
+            {
+                emInstance->postEvent(EventManager::GameEvent::CONSUME_LIFE);
+            }
+            break;
+        }
 
-void TimerManager::updateEndGameTimer(DWORD milliseconds)
-{
-    mEndGameTimer -= milliseconds;
+        case START_GAME_END:
+        {
+            // timer finished, unpause game
+            emInstance->postEvent(EventManager::GameEvent::UI_ENTER_GAME);
+            emInstance->postEvent(EventManager::GameEvent::UNPAUSE);
+            break;
+        }
 
-    if(mEndGameTimer <= 0)
-    {
-        mEndGameTimer = 0;
-        if(mDidLose)
+        case END_GAME_HALF:
         {
-            // check lives remaining if we died -- restart level or game over
-            if(StatsManager::ConstInstace()->getLives() == 0)
+            // end game pause half over, make ghosts invisible
+            emInstance->postEvent(EventManager::GameEvent::GHOSTS_INVISIBLE);
+
+            if(mDidLose)
             {
-                EventManager::ConstInstace()->postEvent(EventManager::GameEvent::GAME_OVER);
+                // if flagged as loss, start pacman's death animation
+                emInstance->postEvent(EventManager::GameEvent::PLAY_PACMAN_DEATH_ANIM);
+                emInstance->postSoundEvent(EventManager::SoundEvent::SOUND_PACMAN_DEATH);
             }
             else
             {
-                EventManager::ConstInstace()->postEvent(EventManager::GameEvent::START_FROM_GAME_LOSE);
+                // otherwise, check the bonus points earned this level
+                emInstance->postEvent(EventManager::GameEvent::POINTS_KILL_BONUS);
+                emInstance->postEvent(EventManager::GameEvent::PLAY_TILE_FLASH);
             }
+            break;
         }
-        else
+
+        case END_GAME_END:
         {
-            // end game pause finished, reset for next level on win
-            EventManager::ConstInstace()->postEvent(EventManager::GameEvent::START_FROM_GAME_WIN);
+            if(mDidLose)
+            {
+                // check lives remaining if we died -- restart level or game over
+                if(mWorld->getConstStatsManager()->getLives() == 0)
+                {
+                    emInstance->postEvent(EventManager::GameEvent::GAME_OVER);
+                }
+                else
+                {
+                    emInstance->postEvent(EventManager::GameEvent::START_FROM_GAME_LOSE);
+                }
+            }
+            else
+            {
+                // end game pause finished, reset for next level on win
+                emInstance->postEvent(EventManager::GameEvent::START_FROM_GAME_WIN);
+            }
+            break;
         }
-    }
-    else if(mEndGameTimer < END_GAME_HALF && !mHalfPauseTimePassed)
-    {
-        // end game pause half over, make ghosts invisible
-        const EventManager* emInstance = EventManager::ConstInstace();
-        emInstance->postEvent(EventManager::GameEvent::GHOSTS_INVISIBLE);
-        mHalfPauseTimePassed = true;
 
-        if(mDidLose)
+        case DEAD_GHOST_END:
         {
-            // if flagged as loss, start pacman's death animation
-            emInstance->postEvent(EventManager::GameEvent::PLAY_PACMAN_DEATH_ANIM);
-            emInstance->postSoundEvent(EventManager::SoundEvent::SOUND_PACMAN_DEATH);
+            // short pause on ghost death finished, unpause
+            emInstance->postEvent(EventManager::GameEvent::UNPAUSE);
+            break;
         }
-        else
+
+        default:
         {
-            // otherwise, check the bonus points earned this level
-            emInstance->postEvent(EventManager::GameEvent::POINTS_KILL_BONUS);
-            emInstance->postEvent(EventManager::GameEvent::PLAY_TILE_FLASH);
+            break;
         }
     }
 }
 
 //-----------------------------------------------------------------------------------------
 
-void TimerManager::updateDeadGhostTimer(DWORD milliseconds)
+void TimerManager::activatePause(const TimerID halfTimer, const TimerID endTimer, const int32_t duration, const int32_t half)
 {
-    mDeadGhostTimer -= milliseconds;
+    // the pause counts down once the more urgent pauses are over
+    TimerID firstTimer = halfTimer < endTimer ? halfTimer : endTimer;
+    uint32_t startTick = mWorld->getTick();
+    for(int32_t id = 0; id < firstTimer; ++id)
+    {
+        if(mTimers[id] > startTick)
+        {
+            startTick = mTimers[id];
+        }
+    }
+
+    // a timer counting down from 'duration' ms passes a threshold on the update it drops below it
+    uint32_t oldEndTick = mTimers[endTimer] != 0 ? mTimers[endTimer] : startTick;
+    uint32_t endTick = startTick + GameUtil::Utilities::getNumStepsAbove(duration, 1, SIM_TICK_TIME) + 1;
+    if(halfTimer != NUM_TIMERS)
+    {
+        setTimer(halfTimer, startTick + GameUtil::Utilities::getNumStepsAbove(duration, half, SIM_TICK_TIME) + 1);
+    }
+    setTimer(endTimer, endTick);
 
-    if(mDeadGhostTimer <= 0)
+    // the less urgent pauses wait for this one to end
+    for(int32_t id = endTimer + 1; id < NUM_TIMERS; ++id)
     {
-        // short pause on ghost death finished, unpause
-        EventManager::ConstInstace()->postEvent(EventManager::GameEvent::UNPAUSE);
-        mDeadGhostTimer = 0;
+        if(mTimers[id] != 0)
+        {
+            setTimer((TimerID)id, mTimers[id] + endTick - oldEndTick);
+        }
     }
 }
 
@@ -203,9 +225,8 @@ void TimerManager::updateDeadGhostTimer(DWORD milliseconds)
 void TimerManager::activateStartTimerFromMenu()
 {
     // starting level from the menu takes the full time and consumes a life on startup
-    mStartGameTimer = START_GAME_PAUSE_DURATION;
-    mHalfPauseTimePassed = false;
-    mWillConsumeLife = true;
+    activatePause(START_GAME_HALF, START_GAME_END, START_GAME_PAUSE_DURATION, START_GAME_PAUSE_HALF);
+    setWillConsumeLife(true);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -213,9 +234,8 @@ void TimerManager::activateStartTimerFromMenu()
 void TimerManager::activateStartTimerFromWin()
 {
     // starting level from a win takes less time than usual and does not consume a life on startup
-    mStartGameTimer = START_GAME_HALF - 1;
-    mHalfPauseTimePassed = false;
-    mWillConsumeLife = false;
+    activatePause(START_GAME_HALF, START_GAME_END, START_GAME_PAUSE_HALF - 1, START_GAME_PAUSE_HALF);
+    setWillConsumeLife(false);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -223,9 +243,8 @@ void TimerManager::activateStartTimerFromWin()
 void TimerManager::activateStartTimerFromLoss()
 {
     // starting level from a lost life takes less time and consumes a life on startup
-    mStartGameTimer = START_GAME_HALF - 1;
-    mHalfPauseTimePassed = false;
-    mWillConsumeLife = true;
+    activatePause(START_GAME_HALF, START_GAME_END, START_GAME_PAUSE_HALF - 1, START_GAME_PAUSE_HALF);
+    setWillConsumeLife(true);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -233,9 +252,8 @@ void TimerManager::activateStartTimerFromLoss()
 void TimerManager::activateEndGameTimerWin()
 {
     // level has ended, mark didLose false
-    mEndGameTimer = END_GAME_PAUSE_DURATION;
-    mHalfPauseTimePassed = false;
-    mDidLose = false;
+    activatePause(END_GAME_HALF, END_GAME_END, END_GAME_PAUSE_DURATION, END_GAME_PAUSE_HALF);
+    setDidLose(false);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -243,15 +261,39 @@ void TimerManager::activateEndGameTimerWin()
 void TimerManager::activateEndGameTimerLoss()
 {
     // level has ended, mark didLose true
-    mEndGameTimer = END_GAME_PAUSE_DURATION;
-    mHalfPauseTimePassed = false;
-    mDidLose = true;
+    activatePause(END_GAME_HALF, END_GAME_END, END_GAME_PAUSE_DURATION, END_GAME_PAUSE_HALF);
+    setDidLose(true);
 }
 
 //-----------------------------------------------------------------------------------------
 
 void TimerManager::activateDeadGhostTimer()
 {
-    mDeadGhostTimer = GHOST_KILL_PAUSE_DURATION;
+    activatePause(NUM_TIMERS, DEAD_GHOST_END, GHOST_KILL_PAUSE_DURATION, 0);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerManager::setTimer(const TimerID id, const uint32_t tick)
+{
+    mWorld->setTimer(GameWorld::TimerOwner::TIMER_MANAGER, id, tick);
+
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::TIMER, id), mTimers[id], tick);
+    mTimers[id] = tick;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerManager::setWillConsumeLife(const bool8_t willConsumeLife)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::WILL_CONSUME_LIFE), mWillConsumeLife, willConsumeLife);
+    mWillConsumeLife = willConsumeLife;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerManager::setDidLose(const bool8_t didLose)
+{
+    mWorld->updateZobristHash(ZobristHash::getKey(ZobristHash::Field::DID_LOSE), mDidLose, didLose);
+    mDidLose = didLose;
 }
-    
\ No newline at end of file
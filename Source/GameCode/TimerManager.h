@@ -1,4 +1,7 @@
 
+class GameWorld;
+struct TimerState;
+
 /*
  * Manages timers that control game flow during
  * pauses at the beginning and ending of a level.
@@ -11,25 +14,69 @@
  *
  * Such events could be changing the UIManager state,
  * playing an animation, or unpausing the game to begin play.
+ *
+ * Each threshold is a timer set on the GameWorld's TimerWheel,
+ * for the tick it is crossed on, so nothing is counted down while
+ * the game waits, and ticks with nothing due cost nothing. New
+ * time-based mechanics are a new TimerID and its handler.
+ *
+ * Only one pause counts down at a time: the start of level
+ * pause before the end of level pause, before the pause for a
+ * ghost being eaten. A pause that starts while a more urgent one
+ * runs is set for after that one ends, and starting a pause puts
+ * back the less urgent ones by as long as it lasts.
  */
 class TimerManager
 {
 public:
 
-    static TimerManager* Instance();
-    static const TimerManager* ConstInstace();
+    /*
+     * Enumeration of the timers, in the order of the pauses
+     * they belong to.
+     */
+    typedef enum
+    {
+        START_GAME_HALF,            // start of level pause
+        START_GAME_END,
+        END_GAME_HALF,              // end of level pause
+        END_GAME_END,
+        DEAD_GHOST_END,             // pause for a ghost being eaten
+
+        NUM_TIMERS
+    }TimerID;
+
+    TimerManager(const GameWorld* world);
     void init();
 
     /*
-     * Resets all timers to 0 and boolean flags
-     * to false.
+     * Cancels all timers, and sets boolean flags to false.
      */
     void reset();
 
     /*
-     * Calls the handler function for any active timers. 
+     * Copies the timers and flags out to 'state', or back
+     * in from it, setting the timers on the world's clock
+     * again.
+     */
+    void saveState(TimerState* state) const;
+    void loadState(const TimerState* state);
+
+    /*
+     * Handles timer 'id' falling due, called by the world.
+     *
+     * Half way through the start of level pause, it makes the
+     * characters visible, and if flagged to consume a life, posts a
+     * CONSUME_LIFE event. At the end, it posts an UNPAUSE event.
+     *
+     * Half way through the end of level pause, if flagged as a loss,
+     * it posts an event to play pacman's death animation, otherwise
+     * one to play the tile flash animation. At the end, it posts an
+     * event to restart the same level, or start the next one.
+     *
+     * At the end of the pause for a ghost being eaten, it posts an
+     * UNPAUSE event.
      */
-    void updateTimers(DWORD milliseconds);
+    void handleTimer(const TimerID id);
     void shutdown();
 
     /*
@@ -69,46 +116,31 @@ public:
 
 private:
 
-    TimerManager();
-
     /*
-     * Handles the countdown for a short pause before the start
-     * of play. 
-     *
-     * If flagged to consume a life, it posts a CONSUME_LIFE
-     * event.
-     *
-     * At the end, it posts an UNPAUSE event.
+     * Starts the pause ending with timer 'endTimer', with its
+     * threshold timer 'halfTimer' (NUM_TIMERS for none). The timers
+     * are set for when the pause's countdown, from 'duration' ms,
+     * would fall below 'half' ms and to 0.
      */
-    void updateStartGameTimer(DWORD milliseconds);
+    void activatePause(const TimerID halfTimer, const TimerID endTimer, const int32_t duration, const int32_t half);
 
     /*
-     * Handles the countdown for a short pause at the end of
-     * play.
-     *
-     * If flagged as a loss, it posts an event to play pacman's
-     * death animation when half over. When finished, it posts
-     * an event to restart the same level.
-     *
-     * If not flagged as a loss, it posts an event to play the
-     * tile flash animation when half over. When finished, it
-     * posts an event to start the next level.
+     * Sets timer 'id' to fall due on 'tick', or cancels it if 'tick'
+     * is 0. Keeps the world's Zobrist hash up to date.
      */
-    void updateEndGameTimer(DWORD milliseconds);
+    void setTimer(const TimerID id, const uint32_t tick);
 
     /*
-     * Handles the countdown for the short pause when a ghost
-     * is eaten. Posts an UNPAUSE event when finished.
+     * Setters for the flags the pauses end on, which keep the
+     * world's Zobrist hash up to date.
      */
-    void updateDeadGhostTimer(DWORD milliseconds);
+    void setWillConsumeLife(const bool8_t willConsumeLife);
+    void setDidLose(const bool8_t didLose);
 
-    static TimerManager* _instance;
+    const GameWorld* mWorld;
 
-    int32_t mStartGameTimer;            // timers
-    int32_t mEndGameTimer;
-    int32_t mDeadGhostTimer;
+    uint32_t mTimers[NUM_TIMERS];       // tick each timer falls due on, or 0 if not set
 
-    bool8_t mHalfPauseTimePassed;       // game flow control booleans
-    bool8_t mWillConsumeLife;
+    bool8_t mWillConsumeLife;           // game flow control booleans
     bool8_t mDidLose;
 };
@@ -0,0 +1,355 @@
+
+#define TIMER_WHEEL_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include "../Framework/baseTypes.h"
+
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "TimerWheel.h"
+
+#include "GameWorld.h"
+
+
+#define NUM_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+#define SLOT_MASK       (NUM_SLOTS - 1)
+#define OVERFLOW_LIST   (TIMER_WHEEL_LEVELS << TIMER_WHEEL_SLOT_BITS)
+#define DUE_LIST        (OVERFLOW_LIST + 1)
+#define NO_INDEX        -1
+
+static_assert(TIMER_WHEEL_SLOT_BITS <= 6, "a level's slots must fit in its 64-bit bitmap");
+static_assert(TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS < 32, "the wheel must cover less than the whole clock");
+static_assert(TIMER_WHEEL_CAPACITY <= 0x7FFF, "a timer's index must fit in a handle and a list link");
+
+TimerWheel::TimerWheel()
+{
+    for(int32_t i = 0; i < TIMER_WHEEL_CAPACITY; ++i)
+    {
+        mTimers[i].generation = 1;
+        mTimers[i].list = NO_INDEX;
+    }
+
+    clear();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::clear()
+{
+    // every handle given out goes stale, and every timer goes back to the pool
+    for(int16_t i = 0; i < TIMER_WHEEL_CAPACITY; ++i)
+    {
+        Timer& timer = mTimers[i];
+        if(timer.list != NO_INDEX && ++timer.generation == 0)
+        {
+            timer.generation = 1;
+        }
+        timer.list = NO_INDEX;
+        timer.next = i + 1 < TIMER_WHEEL_CAPACITY ? i + 1 : NO_INDEX;
+    }
+    mFreeTimer = 0;
+
+    for(int32_t list = 0; list <= DUE_LIST; ++list)
+    {
+        mHeads[list] = NO_INDEX;
+        mTails[list] = NO_INDEX;
+    }
+    for(int32_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+        mOccupied[level] = 0;
+    }
+
+    mTick = 0;
+    mNextTick = TICKS_UNLIMITED;
+    mNumTimers = 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t TimerWheel::getTick() const
+{
+    return mTick;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::setTick(const uint32_t tick)
+{
+    // timers are placed relative to the clock, so it can't jump under them
+    assert(mNumTimers == 0);
+    mTick = tick;
+    updateNextTick();
+}
+
+//-----------------------------------------------------------------------------------------
+
+TimerHandle TimerWheel::schedule(const uint32_t tick, const int32_t id)
+{
+    assert(tick > mTick);
+    assert(mFreeTimer != NO_INDEX);
+    if(mFreeTimer == NO_INDEX)
+    {
+        return TIMER_WHEEL_NO_TIMER;
+    }
+
+    int16_t index = mFreeTimer;
+    Timer& timer = mTimers[index];
+    mFreeTimer = timer.next;
+
+    timer.tick = tick;
+    timer.id = id;
+    place(index);
+    mNumTimers++;
+
+    updateNextTick();
+    return ((TimerHandle)timer.generation << 16) | (TimerHandle)index;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::cancel(const TimerHandle handle)
+{
+    uint32_t index = handle & 0xFFFF;
+    if(handle == TIMER_WHEEL_NO_TIMER || index >= TIMER_WHEEL_CAPACITY)
+    {
+        return;
+    }
+
+    // a stale handle's timer has been freed since, and maybe reused
+    const Timer& timer = mTimers[index];
+    if(timer.list == NO_INDEX || timer.generation != (handle >> 16))
+    {
+        return;
+    }
+
+    release((int16_t)index);
+    updateNextTick();
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::advance()
+{
+    mTick++;
+
+    // nothing falls due or needs cascading before the next tick
+    if(mTick < mNextTick)
+    {
+        return;
+    }
+
+    // entering a new block of ticks at some level, bring its timers down, from the top level down
+    if((mTick & ((1u << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1)) == 0)
+    {
+        cascade(OVERFLOW_LIST);
+    }
+    for(int32_t level = TIMER_WHEEL_LEVELS - 1; level > 0; --level)
+    {
+        uint32_t shift = TIMER_WHEEL_SLOT_BITS * level;
+        if((mTick & ((1u << shift) - 1)) == 0)
+        {
+            cascade((int16_t)((level << TIMER_WHEEL_SLOT_BITS) | ((mTick >> shift) & SLOT_MASK)));
+        }
+    }
+
+    // then everything in this tick's slot is due
+    int16_t list = (int16_t)(mTick & SLOT_MASK);
+    int16_t index = mHeads[list];
+    while(index != NO_INDEX)
+    {
+        int16_t next = mTimers[index].next;
+        unlink(index);
+        link(index, DUE_LIST);
+        index = next;
+    }
+
+    updateNextTick();
+}
+
+//-----------------------------------------------------------------------------------------
+
+bool8_t TimerWheel::popDue(int32_t& id, const int32_t firstId, const int32_t endId)
+{
+    for(int16_t index = mHeads[DUE_LIST]; index != NO_INDEX; index = mTimers[index].next)
+    {
+        if(mTimers[index].id >= firstId && mTimers[index].id < endId)
+        {
+            id = mTimers[index].id;
+            release(index);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t TimerWheel::getNumQuietTicks() const
+{
+    return mNextTick == TICKS_UNLIMITED ? TICKS_UNLIMITED : mNextTick - mTick - 1;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::skip(const uint32_t numTicks)
+{
+    assert(numTicks <= getNumQuietTicks());
+    mTick += numTicks;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t TimerWheel::getNumTimers() const
+{
+    return mNumTimers;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::link(const int16_t index, const int16_t list)
+{
+    Timer& timer = mTimers[index];
+    timer.list = list;
+    timer.prev = mTails[list];
+    timer.next = NO_INDEX;
+
+    if(mTails[list] != NO_INDEX)
+    {
+        mTimers[mTails[list]].next = index;
+    }
+    else
+    {
+        mHeads[list] = index;
+    }
+    mTails[list] = index;
+
+    if(list < OVERFLOW_LIST)
+    {
+        mOccupied[list >> TIMER_WHEEL_SLOT_BITS] |= 1ull << (list & SLOT_MASK);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::unlink(const int16_t index)
+{
+    Timer& timer = mTimers[index];
+    int16_t list = timer.list;
+
+    if(timer.prev != NO_INDEX)
+    {
+        mTimers[timer.prev].next = timer.next;
+    }
+    else
+    {
+        mHeads[list] = timer.next;
+    }
+
+    if(timer.next != NO_INDEX)
+    {
+        mTimers[timer.next].prev = timer.prev;
+    }
+    else
+    {
+        mTails[list] = timer.prev;
+    }
+
+    if(list < OVERFLOW_LIST && mHeads[list] == NO_INDEX)
+    {
+        mOccupied[list >> TIMER_WHEEL_SLOT_BITS] &= ~(1ull << (list & SLOT_MASK));
+    }
+
+    timer.list = NO_INDEX;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::release(const int16_t index)
+{
+    unlink(index);
+
+    Timer& timer = mTimers[index];
+    if(++timer.generation == 0)
+    {
+        timer.generation = 1;
+    }
+    timer.next = mFreeTimer;
+    mFreeTimer = index;
+
+    mNumTimers--;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::place(const int16_t index)
+{
+    // the lowest level whose block of ticks the timer shares with the clock
+    uint32_t tick = mTimers[index].tick;
+    for(int32_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+        uint32_t blockShift = TIMER_WHEEL_SLOT_BITS * (level + 1);
+        if((tick >> blockShift) == (mTick >> blockShift))
+        {
+            uint32_t slot = (tick >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK;
+            link(index, (int16_t)((level << TIMER_WHEEL_SLOT_BITS) | slot));
+            return;
+        }
+    }
+
+    link(index, OVERFLOW_LIST);
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::cascade(const int16_t list)
+{
+    // take the whole list off at once, as a timer can be placed back into it
+    int16_t index = mHeads[list];
+    mHeads[list] = NO_INDEX;
+    mTails[list] = NO_INDEX;
+    if(list < OVERFLOW_LIST)
+    {
+        mOccupied[list >> TIMER_WHEEL_SLOT_BITS] &= ~(1ull << (list & SLOT_MASK));
+    }
+
+    while(index != NO_INDEX)
+    {
+        int16_t next = mTimers[index].next;
+        place(index);
+        index = next;
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+void TimerWheel::updateNextTick()
+{
+    // the first occupied slot after the clock's, at the lowest level that has one,
+    //      is either a timer falling due or a block of timers to cascade
+    for(int32_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+        uint32_t slotShift = TIMER_WHEEL_SLOT_BITS * level;
+        uint32_t blockShift = slotShift + TIMER_WHEEL_SLOT_BITS;
+        uint32_t slot = (mTick >> slotShift) & SLOT_MASK;
+
+        uint64_t laterSlots = mOccupied[level] & ~((2ull << slot) - 1);
+        if(laterSlots != 0)
+        {
+            mNextTick = ((mTick >> blockShift) << blockShift) +
+                (GameUtil::Utilities::countTrailingZeros(laterSlots) << slotShift);
+            return;
+        }
+    }
+
+    if(mHeads[OVERFLOW_LIST] != NO_INDEX)
+    {
+        uint32_t topShift = TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS;
+        mNextTick = ((mTick >> topShift) + 1) << topShift;
+        return;
+    }
+
+    mNextTick = TICKS_UNLIMITED;
+}
@@ -0,0 +1,153 @@
+
+#define TIMER_WHEEL_CAPACITY        16      // timers a wheel holds at once
+#define TIMER_WHEEL_SLOT_BITS       6       // each level has 1 << TIMER_WHEEL_SLOT_BITS slots
+#define TIMER_WHEEL_LEVELS          3       // levels of slots, covering 1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS) ticks
+#define TIMER_WHEEL_NO_TIMER        0       // handle of no timer
+
+typedef uint32_t TimerHandle;
+
+/*
+ * Hierarchical timer wheel, which calls timers up on the tick
+ * they fall due.
+ *
+ * The wheel keeps its own clock, counted in ticks by advance().
+ * Each timer is scheduled for an absolute tick on that clock, and
+ * carries an ID its owner uses to tell what the timer was for.
+ *
+ * Level 0 has a slot for each tick of the current block of 64
+ * ticks. Level 1 has a slot for each block of 64 ticks in the
+ * current block of 4096, and so on up, with timers past the top
+ * level kept in one overflow list. As the clock enters a block,
+ * the timers of that block's slot are cascaded down a level.
+ *
+ * Scheduling and cancelling a timer is O(1): it is linked into,
+ * or unlinked from, its slot's list. The wheel also keeps a lower
+ * bound on the tick the next timer falls due, from a bitmap of
+ * each level's occupied slots, so advancing the clock does no work
+ * on a tick where nothing is due, and a run of such ticks can be
+ * skipped over at once.
+ *
+ * Timers are kept in a pool allocated along with the wheel, so
+ * scheduling a timer never allocates. A handle names a timer
+ * until it fires or is cancelled; the handle of a timer that has
+ * fired or been cancelled names no timer, even once its slot in
+ * the pool is reused.
+ */
+class TimerWheel
+{
+public:
+
+    TimerWheel();
+
+    /*
+     * Drops every timer, and sets the clock back to 0.
+     */
+    void clear();
+
+    /*
+     * Getter and setter for the clock. The clock can only be set
+     * while no timers are scheduled.
+     */
+    const uint32_t getTick() const;
+    void setTick(const uint32_t tick);
+
+    /*
+     * Schedules a timer with ID 'id' to fall due on 'tick', which
+     * must be after the current tick. Returns its handle.
+     */
+    TimerHandle schedule(const uint32_t tick, const int32_t id);
+
+    /*
+     * Cancels the timer with handle 'handle', if it hasn't fired
+     * or been cancelled already.
+     */
+    void cancel(const TimerHandle handle);
+
+    /*
+     * Advances the clock by one tick. The timers that fall due on
+     * the new tick are then handed out by popDue(), and should all
+     * be taken off before the clock moves on again.
+     */
+    void advance();
+
+    /*
+     * Takes the next timer due on the current tick, with an ID from
+     * 'firstId' up to, but not including, 'endId', off the wheel,
+     * setting 'id' to its ID. Timers due on the same tick come off
+     * in no set order. Returns false once there are none left.
+     */
+    bool8_t popDue(int32_t& id, const int32_t firstId, const int32_t endId);
+
+    /*
+     * Returns the number of ticks, from now, that can be advanced
+     * over without a timer falling due. This can be fewer than the
+     * ticks to the next timer, where timers wait to be cascaded.
+     */
+    const uint32_t getNumQuietTicks() const;
+
+    /*
+     * Advances the clock by 'numTicks' at once. Only for ticks
+     * covered by getNumQuietTicks().
+     */
+    void skip(const uint32_t numTicks);
+
+    /*
+     * Returns the number of timers scheduled.
+     */
+    const uint32_t getNumTimers() const;
+
+private:
+
+    /*
+     * A timer in the pool, linked into the list of its slot. Free
+     * timers are linked through 'next'.
+     */
+    typedef struct
+    {
+        uint32_t tick;
+        int32_t id;
+        uint16_t generation;            // bumped each time the timer is freed, so old handles go stale
+        int16_t list;                   // list the timer is linked into, or -1 while free
+        int16_t prev;
+        int16_t next;
+    }Timer;
+
+    /*
+     * Links timer 'index' onto the end of 'list', or unlinks it
+     * from its list.
+     */
+    void link(const int16_t index, const int16_t list);
+    void unlink(const int16_t index);
+
+    /*
+     * Unlinks timer 'index', and returns it to the pool.
+     */
+    void release(const int16_t index);
+
+    /*
+     * Links timer 'index' into the slot for its tick, relative to
+     * the current tick.
+     */
+    void place(const int16_t index);
+
+    /*
+     * Places every timer in 'list' again, moving it down a level.
+     */
+    void cascade(const int16_t list);
+
+    /*
+     * Works out the lower bound on the tick the next timer falls due.
+     */
+    void updateNextTick();
+
+    Timer mTimers[TIMER_WHEEL_CAPACITY];
+    int16_t mFreeTimer;                 // first timer of the free list, or -1
+
+    int16_t mHeads[(TIMER_WHEEL_LEVELS << TIMER_WHEEL_SLOT_BITS) + 2];     // each slot's list, then overflow, then due
+    int16_t mTails[(TIMER_WHEEL_LEVELS << TIMER_WHEEL_SLOT_BITS) + 2];
+    uint64_t mOccupied[TIMER_WHEEL_LEVELS];                                 // bit per slot with timers in it
+
+    uint32_t mTick;
+    uint32_t mNextTick;                 // no timer falls due, or needs cascading, before this tick
+    uint32_t mNumTimers;
+};
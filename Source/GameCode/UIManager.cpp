@@ -17,11 +17,12 @@
 #include "Utilities.h"
 #include "UIManager.h"
 
-#include <queue>
 #include "EventManager.h"
 
 #include "StatsManager.h"
 
+#include "GameWorld.h"
+
 #define TEXT_SPRITESHEET    "Assets\\Images\\Text.png"
 #define LIVES_SPRITESHEET   "Assets\\Images\\LifeSymbol.png"
 #define MENU_IMAGE          "Assets\\Images\\Menu.png"
@@ -74,6 +75,7 @@
 UIManager* UIManager::_instance = nullptr;
 
 UIManager::UIManager() :
+    mWorld(nullptr),
     mTextSpritesheetID(0),
     mLivesSpritesheetID(0),
     mMenuImageID(0)
@@ -106,8 +108,10 @@ const UIManager* UIManager::ConstInstace()
 
 //-----------------------------------------------------------------------------------------
 
-void UIManager::init()
+void UIManager::init(const GameWorld* world)
 {
+    mWorld = world;
+
     mTextSpritesheetID = SOIL_load_OGL_texture(TEXT_SPRITESHEET, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID,
         SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
     assert(mTextSpritesheetID > 0);
@@ -124,7 +128,7 @@ void UIManager::init()
     mScoreString = "00";
 
     // initialize score string using the stats manager's value
-    int32_t highScore = StatsManager::ConstInstace()->getHighScore();
+    int32_t highScore = mWorld->getConstStatsManager()->getHighScore();
     if(highScore > 0)
     {
         char8_t buffer[16];
@@ -157,9 +161,7 @@ void UIManager::update()
         if(g_keys->keyDown[VK_SPACE])
         {
             // switching ui state and posting event to begin start-game-timer
-            const EventManager* emManager = EventManager::ConstInstace();
-            emManager->postEvent(EventManager::GameEvent::START_FROM_MENU);
-            emManager->postSoundEvent(EventManager::SoundEvent::SOUND_START);
+            mWorld->startGame();
 
             setUIState(GameUtil::UIState::UI_PREGAME_1);
         }
@@ -305,7 +307,7 @@ void UIManager::drawLives()
 
     Coord2D vertTR, vertBL, textureCoord, textureSize;
 
-    int32_t lives = StatsManager::ConstInstace()->getLives();
+    int32_t lives = mWorld->getConstStatsManager()->getLives();
     for(int32_t i = 0; i < lives; ++i)
     {
         vertBL.x = LIVES_POS_X + (UI_ELEM_OFFSET_FACTOR * i);
@@ -330,7 +332,7 @@ void UIManager::drawLives()
 
 void UIManager::updateScoreStrings()
 {
-    const StatsManager* smInstance = StatsManager::ConstInstace();
+    const StatsManager* smInstance = mWorld->getConstStatsManager();
     
     // a "perfect score" in pacman is 3333360, so we are more than safe using a buffer of size 16 for the score string
     char8_t buffer[16];
@@ -1,4 +1,6 @@
 
+class GameWorld;
+
 /*
  * Manages UI elements.
  *
@@ -13,9 +15,10 @@ public:
     static const UIManager* ConstInstace();
 
     /*
-     * Loads UI images. Initializes the score strings.
+     * Loads UI images. Initializes the score strings from
+     * the stats of the given 'world', which the UI displays.
      */
-    void init();
+    void init(const GameWorld* world);
 
     /*
      * Resets the score string for a new game.
@@ -90,6 +93,8 @@ private:
 
     static UIManager* _instance;
 
+    const GameWorld* mWorld;
+
     GameUtil::UIState mCurrentState;
 
     std::string mScoreString;
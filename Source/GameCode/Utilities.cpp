@@ -2,15 +2,17 @@
 #define UTILITIES_CPP
 
 #include <stdio.h>
-#include <windows.h>											// Header File For Windows
-#include <gl\gl.h>											    // Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
+#include "../Framework/platform.h"
 #include <assert.h>
-#include "glut.h"
-#include "..\\Framework\\baseTypes.h"
+#include <math.h>
+#include "../Framework/baseTypes.h"
 
 #include "Utilities.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace GameUtil
 {
     float Utilities::squareDistance(const float x1, const float x2, const float y1, const float y2)
@@ -23,6 +25,88 @@ namespace GameUtil
 
 //-----------------------------------------------------------------------------------------
 
+    uint32_t Utilities::popCount(const uint32_t bits)
+    {
+#ifdef _MSC_VER
+        return __popcnt(bits);
+#else
+        return __builtin_popcount(bits);
+#endif
+    }
+
+//-----------------------------------------------------------------------------------------
+
+    uint32_t Utilities::countTrailingZeros(const uint64_t bits)
+    {
+        assert(bits != 0);
+
+        // a word at a time, as 32-bit builds have no 64-bit bit scan
+        uint32_t low = (uint32_t)bits;
+        uint32_t offset = 0;
+        if(low == 0)
+        {
+            low = (uint32_t)(bits >> 32);
+            offset = 32;
+        }
+
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, low);
+        return offset + index;
+#else
+        return offset + __builtin_ctz(low);
+#endif
+    }
+
+//-----------------------------------------------------------------------------------------
+
+    uint32_t Utilities::getNumStepsAbove(const uint32_t timer, const uint32_t threshold, const uint32_t step)
+    {
+        return timer >= threshold ? (timer - threshold) / step : 0;
+    }
+
+//-----------------------------------------------------------------------------------------
+
+    uint32_t Utilities::countDown(const uint32_t timer, const uint32_t step, const uint32_t numSteps)
+    {
+        if(timer % step == 0 && numSteps >= timer / step)
+        {
+            return 0;
+        }
+
+        return timer - step * numSteps;
+    }
+
+//-----------------------------------------------------------------------------------------
+
+    uint32_t Utilities::getNumStepsToCross(const uint32_t timer, const uint32_t threshold, const uint32_t step)
+    {
+        uint32_t numSteps = getNumStepsAbove(timer, threshold, step) + 1;
+        return numSteps <= timer / step ? numSteps : TICKS_UNLIMITED;
+    }
+
+//-----------------------------------------------------------------------------------------
+
+    uint32_t Utilities::getNumStepsToRunOut(const uint32_t timer, const uint32_t step)
+    {
+        return timer % step == 0 ? timer / step + 1 : TICKS_UNLIMITED;
+    }
+
+//-----------------------------------------------------------------------------------------
+
+    uint32_t Utilities::squareRoot(const uint32_t value)
+    {
+        // the float root can be off by one either way, so correct it
+        uint32_t root = (uint32_t)sqrt((double)value);
+        while(root > 0 && root * root > value) --root;
+        while(root < 0xFFFF && (root + 1) * (root + 1) <= value) ++root;
+
+        return root;
+    }
+
+//-----------------------------------------------------------------------------------------
+
+#ifndef PACSIM_HEADLESS
     void Utilities::drawSprite(const Coord2D& vertTR, const Coord2D& vertBL, const Coord2D& textureCoord, const Coord2D& textureSize)
     {
         // this function draws the textures, but it is up to the caller to provide the data
@@ -39,4 +123,5 @@ namespace GameUtil
         glTexCoord2f(textureCoord.x, textureCoord.y + textureSize.y);                   // bottom left
         glVertex3f(vertBL.x, vertBL.y, 0.0);
     }
+#endif
 }
@@ -1,4 +1,6 @@
 
+#define TICKS_UNLIMITED     0xFFFFFFFFu     // number of quiet ticks when nothing is waiting to happen
+
 namespace GameUtil
 {
     /*
@@ -13,6 +15,49 @@ namespace GameUtil
          */
         static float squareDistance(const float x1, const float x2, const float y1, const float y2);
 
+        /*
+         * Returns the number of set bits in 'bits'.
+         */
+        static uint32_t popCount(const uint32_t bits);
+
+        /*
+         * Returns the index of the lowest set bit in 'bits', which
+         * must not be 0.
+         */
+        static uint32_t countTrailingZeros(const uint64_t bits);
+
+        /*
+         * Returns how many times 'timer' can be counted down by 'step'
+         * and stay at or above 'threshold'.
+         */
+        static uint32_t getNumStepsAbove(const uint32_t timer, const uint32_t threshold, const uint32_t step);
+
+        /*
+         * Returns 'timer' counted down by 'step', 'numSteps' times,
+         * where each count only takes it down if it is above 0. A
+         * timer that lands on 0 stays there; one that steps past 0
+         * wraps round, as it is unsigned.
+         */
+        static uint32_t countDown(const uint32_t timer, const uint32_t step, const uint32_t numSteps);
+
+        /*
+         * Returns the count, of 'step' at a time as countDown(), on
+         * which 'timer' first drops below 'threshold', or
+         * TICKS_UNLIMITED if it wraps past 0 first.
+         */
+        static uint32_t getNumStepsToCross(const uint32_t timer, const uint32_t threshold, const uint32_t step);
+
+        /*
+         * Returns the count, of 'step' at a time as countDown(), that
+         * finds 'timer' at 0, or TICKS_UNLIMITED if it wraps past 0.
+         */
+        static uint32_t getNumStepsToRunOut(const uint32_t timer, const uint32_t step);
+
+        /*
+         * Returns the largest integer whose square is at most 'value'.
+         */
+        static uint32_t squareRoot(const uint32_t value);
+
         /*
          * Draws a sprite with OpenGL coordinates given by 
          * 'vertTR' (top-right) and 'vertBL' (bottom-left),
@@ -0,0 +1,217 @@
+
+#define MAX_STATE_EVENTS        32      // queued events a snapshot can hold, per queue
+#define NUM_STATE_CHARACTERS    5       // pacman and the four ghosts, indexed by GameUtil::CharacterID
+#define NUM_STATE_TIMERS        5       // TimerManager timers, indexed by TimerManager::TimerID
+#define NUM_STATE_RANDOM_WORDS  4       // words of RandomGenerator state
+
+/*
+ * Snapshot of a game world's state.
+ *
+ * A GameWorldState holds everything that changes while a world
+ * plays: pellets, character positions and states, timers, stats,
+ * queued events, and the random number generator. Everything else
+ * (the board's tiles, spawn points, textures) is fixed once the
+ * world is initialized, and is not part of the state.
+ *
+ * Each struct is plain data with no pointers, so a snapshot is a
+ * flat buffer: it can be copied with memcpy or kept in an array
+ * of snapshots. Enumerations are stored as int32_t. A snapshot
+ * only makes sense to a world of the same build, initialized
+ * with the same board.
+ *
+ * Each manager fills in and restores its own part, see
+ * GameWorld::saveState().
+ *
+ * Countdowns that run while the game plays (the ghost phase
+ * timer, each ghost's scared timer, and the fruit timer) are
+ * kept as their value as of a tick of the world's clock, which
+ * they count down from while they run, so they don't change on
+ * every tick. A stopped countdown is kept as of tick 0.
+ */
+
+/*
+ * StatsManager state. The speed and timing stats are
+ * derived from the level, but are kept so that loading
+ * doesn't need to look them up again.
+ */
+struct StatsState
+{
+    int32_t level;
+    int32_t lives;
+    int32_t score;
+    int32_t highScore;
+    int32_t prevScore;
+    int32_t tableIndex;
+    int32_t ghostsKilledOnPellet;
+    int32_t ghostKillCount;
+
+    float_t pacmanSpeed;
+    float_t pacmanSpeedDots;
+    float_t pacmanSpeedScared;
+    float_t pacmanSpeedScaredDots;
+    float_t ghostSpeed;
+    float_t ghostSpeedScared;
+    float_t ghostSpeedTunnel;
+    float_t cruiseElroySpeed;
+    float_t cruiseElroyDots;
+};
+
+/*
+ * EventManager state, the events queued for the next tick
+ * in the order they were posted.
+ */
+struct EventState
+{
+    int32_t gameEventHead;                          // ring slot of the first game event, see EventManager::updateGameEventHash()
+    int32_t numGameEvents;
+    int32_t gameEvents[MAX_STATE_EVENTS];           // EventManager::GameEvent
+    int32_t gameEventData[MAX_STATE_EVENTS];        // data posted with each game event
+    int32_t numSoundEvents;
+    int32_t soundEvents[MAX_STATE_EVENTS];          // EventManager::SoundEvent
+};
+
+/*
+ * TimerManager state. Timers are kept as the tick they fall
+ * due on, counted on the world's clock.
+ */
+struct TimerState
+{
+    uint32_t timers[NUM_STATE_TIMERS];      // tick each TimerManager::TimerID falls due on, or 0 if not set
+    bool8_t willConsumeLife;
+    bool8_t didLose;
+};
+
+/*
+ * TileGrid state, the uncollected pellets and the flash
+ * animation.
+ */
+struct TileGridState
+{
+    PelletRow pellets[NUM_BOARD_ROWS];
+    uint32_t flashStartTime;
+    bool8_t isFlashing;
+};
+
+/*
+ * BoardManager state. The pellet triggers are rebuilt from
+ * the level rather than saved.
+ */
+struct BoardState
+{
+    TileGridState grid;
+    int32_t nextPelletTrigger;
+    bool8_t isRearmPending;
+    bool8_t isTriggerCheckPending;
+};
+
+/*
+ * FruitManager state.
+ */
+struct FruitState
+{
+    int32_t fruitType;                              // GameUtil::FruitType
+    int32_t phase;                                  // GameUtil::FruitPhase
+    uint32_t collectedFruit;                        // bit 'type' is set for each collected GameUtil::FruitType
+    int32_t timer;
+    uint32_t timerStart;                            // tick of the world's clock 'timer' is as of
+    bool8_t isVisible;
+    bool8_t isPaused;
+};
+
+/*
+ * Character state. Holds the fields of every character type;
+ * each type saves and restores the ones it has, and leaves
+ * the rest alone.
+ */
+struct CharacterState
+{
+    // Character
+
+    int32_t animChunkID;                            // GameUtil::AnimChunkID
+    uint32_t animStartTime;
+    uint32_t animHoldTime;
+    uint32_t frameDeltaTime;
+    int32_t facingDirection;                        // GameUtil::BoardDirection
+    int32_t movementState;                          // Character::MovementState
+    TilePosition position;
+    TilePosition lastPosition;
+    float_t speed;
+    TileIndex prevTile;
+    TileIndex currTile;
+    TileIndex nextTile;
+    bool8_t isAnimHeld;
+    bool8_t isPaused;
+    bool8_t isVisible;
+    bool8_t isAlive;
+    bool8_t didTeleport;
+
+    // Pacman
+
+    float_t pacmanSpeed;
+    float_t pacmanSpeedDots;
+    float_t pacmanSpeedScared;
+    float_t pacmanSpeedScaredDots;
+    int32_t inputDirection;                         // GameUtil::BoardDirection
+
+    // Ghost
+
+    TileIndex targetTile;
+    int32_t targetState;                            // Ghost::GhostTargetingState
+    int32_t currentPhase;                           // Ghost::GhostTargetingState
+    uint32_t scaredTimer;
+    uint32_t scaredTimerStart;                      // tick of the world's clock 'scaredTimer' is as of
+    float_t ghostSpeed;
+    float_t ghostSpeedScared;
+    float_t ghostSpeedTunnel;
+    uint32_t scaredDuration;
+    uint32_t flashThreshold;
+    bool8_t isInGhostHome;
+    bool8_t isScared;
+    bool8_t isFlaggedForReverse;
+
+    // GhostRed
+
+    int32_t cruiseElroyMode;                        // GameUtil::CruiseElroyMode
+    float_t cruiseElroySpeed_1;
+    float_t cruiseElroySpeed_2;
+};
+
+/*
+ * CharacterManager state, including each character's.
+ */
+struct CharacterManagerState
+{
+    int32_t ghostTimerPhase;
+    uint32_t phaseTimer;
+    uint32_t phaseTimerStart;                       // tick of the world's clock 'phaseTimer' is as of
+    uint32_t scatterThreshold_2;
+    uint32_t scatterThreshold_3;
+    uint32_t scatterThreshold_4;
+    uint32_t chaseThreshold_1;
+    uint32_t chaseThreshold_2;
+    uint32_t chaseThreshold_3;
+    bool8_t isPaused;
+
+    CharacterState characters[NUM_STATE_CHARACTERS];
+};
+
+/*
+ * State of a whole world. The benchmark counters (steps and
+ * ghost target evaluations) are not part of it.
+ */
+struct GameWorldState
+{
+    int32_t applicationState;                       // GameWorld::ApplicationState
+    uint32_t gameTime;
+    uint32_t tickTime;
+    uint32_t tick;                                  // the world's clock, see GameWorld::getTick()
+    uint32_t random[NUM_STATE_RANDOM_WORDS];
+    uint64_t zobristHash;                           // the world's ZobristHash, so loading needn't work it out again
+
+    StatsState stats;
+    EventState events;
+    TimerState timers;
+    BoardState board;
+    FruitState fruit;
+    CharacterManagerState characters;
+};
@@ -0,0 +1,180 @@
+
+#define ZOBRIST_HASH_CPP
+
+#include <stdio.h>
+#include "../Framework/platform.h"
+#include <assert.h>
+#include "../Framework/baseTypes.h"
+
+#include "Utilities.h"
+#include "TileGrid.h"
+#include "WorldState.h"
+#include "EventManager.h"
+#include "ZobristHash.h"
+
+#include "GameWorld.h"
+
+static_assert(NUM_BOARD_TILES <= (1 << ZOBRIST_INDEX_BITS), "a tile index must fit in a key");
+
+ZobristHash::ZobristHash() :
+    mValue(0)
+{
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint64_t ZobristHash::getValue() const
+{
+    return mValue;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void ZobristHash::setValue(const uint64_t value)
+{
+    mValue = value;
+}
+
+//-----------------------------------------------------------------------------------------
+
+void ZobristHash::update(const uint32_t key, const uint32_t oldValue, const uint32_t newValue)
+{
+    if(oldValue != newValue)
+    {
+        mValue ^= getValueKey(key, oldValue) ^ getValueKey(key, newValue);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t ZobristHash::getKey(const Field field, const int32_t index)
+{
+    return ((uint32_t)field << ZOBRIST_INDEX_BITS) | (uint32_t)index;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t ZobristHash::getEventValue(const int32_t type, const int32_t data)
+{
+    // event types start after EVENT_INVAL, so no event is 0
+    return (uint32_t)type | ((uint32_t)data << 8);
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint32_t ZobristHash::fold(const uint64_t value)
+{
+    return (uint32_t)(value ^ (value >> 32));
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint64_t ZobristHash::compute(const GameWorldState* state)
+{
+    uint64_t value = 0;
+
+    for(int32_t row = 0; row < NUM_BOARD_ROWS; ++row)
+    {
+        for(int32_t col = 0; col < NUM_BOARD_COLS; ++col)
+        {
+            uint32_t hasPellet = (state->board.grid.pellets[row] >> col) & 1;
+            value ^= getValueKey(getKey(Field::PELLET, TileGrid::getTileIndex(row, col)), hasPellet);
+        }
+    }
+
+    for(int32_t c = GameUtil::CharacterID::PACMAN; c < NUM_STATE_CHARACTERS; ++c)
+    {
+        const CharacterState& character = state->characters.characters[c];
+        value ^= getValueKey(getKey(Field::CHARACTER_TILE, c), (uint32_t)character.currTile);
+        value ^= getValueKey(getKey(Field::CHARACTER_PREV_TILE, c), (uint32_t)character.prevTile);
+        value ^= getValueKey(getKey(Field::CHARACTER_NEXT_TILE, c), (uint32_t)character.nextTile);
+        value ^= getValueKey(getKey(Field::CHARACTER_FACING, c), (uint32_t)character.facingDirection);
+        value ^= getValueKey(getKey(Field::CHARACTER_POSITION_X, c), (uint32_t)character.position.x);
+        value ^= getValueKey(getKey(Field::CHARACTER_POSITION_Y, c), (uint32_t)character.position.y);
+        value ^= getValueKey(getKey(Field::CHARACTER_MOVEMENT_STATE, c), (uint32_t)character.movementState);
+        value ^= getValueKey(getKey(Field::CHARACTER_PAUSED, c), (uint32_t)character.isPaused);
+        value ^= getValueKey(getKey(Field::CHARACTER_ALIVE, c), (uint32_t)character.isAlive);
+        value ^= getValueKey(getKey(Field::CHARACTER_TELEPORTED, c), (uint32_t)character.didTeleport);
+
+        if(c == GameUtil::CharacterID::PACMAN)
+        {
+            value ^= getValueKey(getKey(Field::PACMAN_INPUT, c), (uint32_t)character.inputDirection);
+        }
+        else
+        {
+            value ^= getValueKey(getKey(Field::GHOST_TARGET_STATE, c), (uint32_t)character.targetState);
+            value ^= getValueKey(getKey(Field::GHOST_TARGET_TILE, c), (uint32_t)character.targetTile);
+            value ^= getValueKey(getKey(Field::GHOST_PHASE, c), (uint32_t)character.currentPhase);
+            value ^= getValueKey(getKey(Field::GHOST_SCARED_TIMER, c), character.scaredTimer);
+            value ^= getValueKey(getKey(Field::GHOST_SCARED_TIMER_START, c), character.scaredTimerStart);
+            value ^= getValueKey(getKey(Field::GHOST_SCARED, c), (uint32_t)character.isScared);
+            value ^= getValueKey(getKey(Field::GHOST_IN_HOME, c), (uint32_t)character.isInGhostHome);
+            value ^= getValueKey(getKey(Field::GHOST_REVERSE, c), (uint32_t)character.isFlaggedForReverse);
+        }
+
+        if(c == GameUtil::CharacterID::GHOST_RED)
+        {
+            value ^= getValueKey(getKey(Field::CRUISE_ELROY_MODE, c), (uint32_t)character.cruiseElroyMode);
+        }
+    }
+
+    for(int32_t t = 0; t < NUM_STATE_TIMERS; ++t)
+    {
+        value ^= getValueKey(getKey(Field::TIMER, t), state->timers.timers[t]);
+    }
+
+    for(int32_t w = 0; w < NUM_STATE_RANDOM_WORDS; ++w)
+    {
+        value ^= getValueKey(getKey(Field::RANDOM, w), state->random[w]);
+    }
+
+    for(int32_t type = GameUtil::FruitType::FRUIT_KEY; type != GameUtil::FruitType::FRUIT_TYPE_INVAL; ++type)
+    {
+        uint32_t isCollected = (state->fruit.collectedFruit >> type) & 1;
+        value ^= getValueKey(getKey(Field::COLLECTED_FRUIT, type), isCollected);
+    }
+
+    // every slot of the game event queue is hashed, empty ones as 0
+    const EventState& events = state->events;
+    for(int32_t slot = 0; slot < EVENT_QUEUE_CAPACITY; ++slot)
+    {
+        int32_t i = (slot - events.gameEventHead) & (EVENT_QUEUE_CAPACITY - 1);
+        uint32_t event = i < events.numGameEvents ? getEventValue(events.gameEvents[i], events.gameEventData[i]) : 0;
+        value ^= getValueKey(getKey(Field::GAME_EVENT, slot), event);
+    }
+
+    value ^= getValueKey(getKey(Field::TIMER_CLOCK), state->tick);
+    value ^= getValueKey(getKey(Field::WILL_CONSUME_LIFE), (uint32_t)state->timers.willConsumeLife);
+    value ^= getValueKey(getKey(Field::DID_LOSE), (uint32_t)state->timers.didLose);
+    value ^= getValueKey(getKey(Field::GHOST_TIMER_PHASE), (uint32_t)state->characters.ghostTimerPhase);
+    value ^= getValueKey(getKey(Field::GHOST_PHASE_TIMER), state->characters.phaseTimer);
+    value ^= getValueKey(getKey(Field::GHOST_PHASE_TIMER_START), state->characters.phaseTimerStart);
+    value ^= getValueKey(getKey(Field::CHARACTERS_PAUSED), (uint32_t)state->characters.isPaused);
+    value ^= getValueKey(getKey(Field::FRUIT_TIMER), (uint32_t)state->fruit.timer);
+    value ^= getValueKey(getKey(Field::FRUIT_TIMER_START), state->fruit.timerStart);
+    value ^= getValueKey(getKey(Field::FRUIT_PHASE), (uint32_t)state->fruit.phase);
+    value ^= getValueKey(getKey(Field::FRUIT_VISIBLE), (uint32_t)state->fruit.isVisible);
+    value ^= getValueKey(getKey(Field::FRUIT_PAUSED), (uint32_t)state->fruit.isPaused);
+    value ^= getValueKey(getKey(Field::LEVEL), (uint32_t)state->stats.level);
+    value ^= getValueKey(getKey(Field::LIVES), (uint32_t)state->stats.lives);
+    value ^= getValueKey(getKey(Field::SCORE), (uint32_t)state->stats.score);
+    value ^= getValueKey(getKey(Field::GHOSTS_KILLED_ON_PELLET), (uint32_t)state->stats.ghostsKilledOnPellet);
+    value ^= getValueKey(getKey(Field::GHOST_KILL_COUNT), (uint32_t)state->stats.ghostKillCount);
+    value ^= getValueKey(getKey(Field::NEXT_PELLET_TRIGGER), (uint32_t)state->board.nextPelletTrigger);
+    value ^= getValueKey(getKey(Field::REARM_PENDING), (uint32_t)state->board.isRearmPending);
+    value ^= getValueKey(getKey(Field::TRIGGER_CHECK_PENDING), (uint32_t)state->board.isTriggerCheckPending);
+    value ^= getValueKey(getKey(Field::APPLICATION_STATE), (uint32_t)state->applicationState);
+
+    return value;
+}
+
+//-----------------------------------------------------------------------------------------
+
+const uint64_t ZobristHash::getValueKey(const uint32_t key, const uint32_t value)
+{
+    // splitmix64 of the key and value side by side
+    uint64_t z = (((uint64_t)key << 32) | value) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
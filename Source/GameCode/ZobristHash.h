@@ -0,0 +1,155 @@
+
+#define ZOBRIST_INDEX_BITS      16      // a key is (field << ZOBRIST_INDEX_BITS) | index, see ZobristHash::getKey()
+
+struct GameWorldState;
+
+/*
+ * 64-bit Zobrist hash of a world's state, for search and for
+ * spotting states that have been seen before.
+ *
+ * The hash is the XOR of one 64-bit key for the current value
+ * of each field it covers. When a field changes, the key of its
+ * old value is XORed out and the key of its new value XORed in,
+ * so the hash is kept up to date at the same O(1) cost for any
+ * change, without looking at the rest of the state.
+ *
+ * Timers and positions take too many values to keep a table of
+ * random keys for, so each key is mixed from the field, its
+ * index, and its value (splitmix64) instead, which hashes as
+ * well as a table would.
+ *
+ * The hash covers everything that decides how the game plays
+ * on: the pellets; each character's tiles, position, facing,
+ * movement state, and flags; pacman's input; each ghost's
+ * targeting state, phase, target tile, scared timer, and flags;
+ * the red ghost's Cruise Elroy mode; the world's clock; the game
+ * flow timers and flags; the ghost phase and its timer; the
+ * fruit's timer, phase, flags, and the fruit collected; the level,
+ * lives, score, and ghost kill counts; the next pellet trigger;
+ * the application state; the random generator; and the queued
+ * game events. A countdown is covered by its value and the tick
+ * it's as of, see WorldState.h.
+ *
+ * What's left out doesn't change how the game plays: animation
+ * and visibility are only drawn, speeds and phase lengths are
+ * looked up from the level, a character's speed and last position
+ * are worked out again on every tick, and the high score, previous
+ * score, game time, and sounds are only shown or played. Two worlds
+ * with the same hash play on the same way for the same input.
+ *
+ * The fields and their keys are part of the replay and hash
+ * stream formats, see Replay.h: a change to what the hash covers
+ * goes with a bump of REPLAY_FILE_VERSION.
+ *
+ * The world changes the hash as its managers and characters
+ * change these fields, see GameWorld::updateZobristHash(). A
+ * saved state carries the hash with it, so loading or cloning
+ * a state just restores it; the world works it out again from
+ * scratch with compute() only when every manager is reset at
+ * once, and to check the kept hash with -verify.
+ */
+class ZobristHash
+{
+public:
+
+    /*
+     * Enumeration of the fields the hash covers.
+     */
+    typedef enum
+    {
+        PELLET,                     // indexed by TileIndex, 1 while the tile's pellet is uncollected
+
+        CHARACTER_TILE,             // indexed by GameUtil::CharacterID
+        CHARACTER_PREV_TILE,
+        CHARACTER_NEXT_TILE,
+        CHARACTER_FACING,
+        CHARACTER_POSITION_X,
+        CHARACTER_POSITION_Y,
+        CHARACTER_MOVEMENT_STATE,
+        CHARACTER_PAUSED,
+        CHARACTER_ALIVE,
+        CHARACTER_TELEPORTED,
+        PACMAN_INPUT,
+        GHOST_TARGET_STATE,
+        GHOST_TARGET_TILE,
+        GHOST_PHASE,
+        GHOST_SCARED_TIMER,
+        GHOST_SCARED_TIMER_START,
+        GHOST_SCARED,
+        GHOST_IN_HOME,
+        GHOST_REVERSE,
+        CRUISE_ELROY_MODE,
+
+        TIMER,                      // indexed by TimerManager::TimerID, the tick it falls due on
+        RANDOM,                     // indexed by word of the random generator's state
+        COLLECTED_FRUIT,            // indexed by GameUtil::FruitType, 1 once collected
+        GAME_EVENT,                 // indexed by event queue slot, see getEventValue()
+
+        TIMER_CLOCK,                // not indexed, the world's clock
+        WILL_CONSUME_LIFE,
+        DID_LOSE,
+        GHOST_TIMER_PHASE,
+        GHOST_PHASE_TIMER,
+        GHOST_PHASE_TIMER_START,
+        CHARACTERS_PAUSED,
+        FRUIT_TIMER,
+        FRUIT_TIMER_START,
+        FRUIT_PHASE,
+        FRUIT_VISIBLE,
+        FRUIT_PAUSED,
+        LEVEL,
+        LIVES,
+        SCORE,
+        GHOSTS_KILLED_ON_PELLET,
+        GHOST_KILL_COUNT,
+        NEXT_PELLET_TRIGGER,
+        REARM_PENDING,
+        TRIGGER_CHECK_PENDING,
+        APPLICATION_STATE
+    }Field;
+
+    ZobristHash();
+
+    /*
+     * Getter and setter for the hash.
+     */
+    const uint64_t getValue() const;
+    void setValue(const uint64_t value);
+
+    /*
+     * Changes the field with key 'key' from 'oldValue' to 'newValue'.
+     */
+    void update(const uint32_t key, const uint32_t oldValue, const uint32_t newValue);
+
+    /*
+     * Returns the key of field 'field' at 'index', for update().
+     */
+    static const uint32_t getKey(const Field field, const int32_t index = 0);
+
+    /*
+     * Returns the value a queued game event of type 'type' posted
+     * with 'data' is hashed as. An empty queue slot is 0, which
+     * no event is.
+     */
+    static const uint32_t getEventValue(const int32_t type, const int32_t data);
+
+    /*
+     * Returns 'value' folded to 32 bits, for the replay checkpoints
+     * and hash streams.
+     */
+    static const uint32_t fold(const uint64_t value);
+
+    /*
+     * Returns the hash of 'state', worked out from scratch.
+     */
+    static const uint64_t compute(const GameWorldState* state);
+
+private:
+
+    /*
+     * Returns the 64-bit key of the field with key 'key' holding 'value'.
+     */
+    static const uint64_t getValueKey(const uint32_t key, const uint32_t value);
+
+    uint64_t mValue;
+};
@@ -0,0 +1,887 @@
+
+#define PAC_SIM_CPP
+
+/*
+ * Headless driver for the pacsim library.
+ *
+ * Plays games with no window, renderer or audio by stepping
+ * GameWorlds a fixed number of milliseconds per frame and feeding
+ * them scripted input. Prints the final stats of each game.
+ *
+ * Several independent worlds may be hosted at once. They are stepped
+ * side by side, one frame each in turn, and each plays its own games.
+ *
+ * Must be run from a directory containing the Assets folder.
+ *
+ * Usage: pacsim [-worlds N] [-games N] [-frames N] [-dt MS] [-seed N] [-script SCRIPT] [-verify] [-events] [-clone]
+ *               [-record FILE] [-replay FILE [-hashes FILE]] [-rewind SECONDS]
+ *
+ * A script is a comma separated list of <direction><frames> steps,
+ * where direction is one of U, L, D, R, or '.' for no input.
+ * The script loops until the game ends (e.g. "L40,U25,R40,D25").
+ *
+ * Each world has its own random number generator. World w is seeded
+ * with the -seed value plus w, so every world's games can be replayed
+ * on their own.
+ *
+ * -verify checks the ghost decision table against the distance
+ * comparisons it replaces, for every decision the board allows,
+ * before playing. It then plays the script on two worlds side by
+ * side, winning a level every few seconds, where one world starts
+ * each level from its kept start state and the other resets every
+ * manager, and checks that their states match after every frame.
+ * Last, it plays long games of random input and random game events,
+ * some a frame at a time and some fast forwarded, checking the
+ * Zobrist hash the world keeps up to date against one worked out
+ * from scratch after every step. Then it checks the rewind buffer, as
+ * -rewind does, over a game played in frames shorter than a tick.
+ * Exits with an error if anything differs.
+ *
+ * -events plays each script step with a single fastForward() rather
+ * than a frame at a time, so the world jumps from one tile arrival or
+ * timer expiry to the next. Results match frame-stepped play.
+ *
+ * -clone checks the world state snapshots. Each world has a second
+ * world beside it, and after every step the state of the playing
+ * world is loaded into the other, which then plays on in its place.
+ * Results match play without it. Afterwards, times how long a clone
+ * takes.
+ *
+ * -record saves the first game of world 0 to a replay file. -replay
+ * verifies a replay file instead of playing scripts: it fast forwards
+ * the replay on its own world, checks the state at each of the
+ * replay's checkpoints and at the end against the recording, and
+ * prints the final score, level, and state hash, and the first tick
+ * where the state diverged, if any. Exits with an error if the replay
+ * doesn't match. With -hashes, the hash of every tick of the replay
+ * is saved to a hash stream file as it plays back, to compare with
+ * another build's using the pacdiff tool.
+ *
+ * -rewind checks the rewind buffer. Each world keeps the given number
+ * of seconds of history, and at the end of each game steps back
+ * through all of it, checking the state against the one each frame
+ * that ran a tick left the world in. Exits with an error if any differ. Afterwards,
+ * reports the buffer's memory use and how long a step back takes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../Framework/platform.h"
+#include "../Framework/baseTypes.h"
+#include "../Framework/random.h"
+
+#include <map>
+#include "../GameCode/Utilities.h"
+#include "../GameCode/TileGrid.h"
+#include "../GameCode/BoardManager.h"
+#include "../GameCode/WorldState.h"
+#include "../GameCode/EventManager.h"
+#include <vector>
+#include "../GameCode/BoardFile.h"
+#include "../GameCode/Replay.h"
+#include "../GameCode/RewindBuffer.h"
+#include "../GameCode/HashStream.h"
+#include "../GameCode/GameWorld.h"
+
+#define DEFAULT_NUM_WORLDS      1
+#define DEFAULT_NUM_GAMES       1
+#define DEFAULT_MAX_FRAMES      216000      // one hour of play at 60 frames per second
+#define DEFAULT_FRAME_TIME      16
+#define DEFAULT_SCRIPT          "L40,U25,R40,D25,L60,D40,R60,U40"
+
+#define MAX_SCRIPT_STEPS        256
+
+#define NUM_TIMED_CLONES        1000000
+
+#define NUM_VERIFY_GAMES        3           // the first game builds the level start states, the others load them
+#define VERIFY_GAME_FRAMES      20000
+#define VERIFY_LEVEL_FRAMES     300         // frames between forced level wins, in the first game
+#define VERIFY_LEVEL_FRAMES_STEP 37         // added for each game after, so each plays differently into its levels
+
+#define NUM_ZOBRIST_GAMES       8           // every other game is fast forwarded
+#define ZOBRIST_GAME_FRAMES     36000       // ten minutes of play
+#define ZOBRIST_STEP_FRAMES     90          // most frames a random script step holds its direction for
+#define ZOBRIST_EVENT_CHANCE    200         // one step in this many posts a random game event
+
+#define REWIND_VERIFY_SECONDS   30          // history kept by the world checked with -verify
+#define REWIND_VERIFY_FRAMES    3600        // one minute of play, at a frame time shorter than a tick
+#define REWIND_VERIFY_FRAME_TIME 5
+
+typedef struct
+{
+    GameUtil::BoardDirection direction;
+    int32_t frames;
+}ScriptStep;
+
+typedef struct
+{
+    uint32_t gameTime;
+    uint32_t stateHash;
+}FrameHash;
+
+typedef std::vector<FrameHash> FrameHashes;
+
+typedef struct
+{
+    GameWorld* world;
+    GameWorld* clone;           // world that the next step plays on in, with -clone
+    RewindBuffer* rewind;       // history kept by the world, with -rewind
+    FrameHashes* frameHashes;   // state each frame of the current game left the world in, with -rewind
+    int32_t game;               // index of the game being played
+    int32_t frame;              // frames played in the current game
+    int32_t stepIndex;          // current script step
+    int32_t framesOnStep;       // frames played on the current script step
+    uint32_t startTime;         // world game time when the current game started
+}SimWorld;
+
+//-----------------------------------------------------------------------------------------
+
+static int32_t parseScript(const char8_t* script, ScriptStep* steps, int32_t maxSteps)
+{
+    int32_t numSteps = 0;
+    const char8_t* curr = script;
+
+    while(*curr != '\0' && numSteps < maxSteps)
+    {
+        GameUtil::BoardDirection direction;
+        switch(*curr)
+        {
+            case 'U': direction = GameUtil::BoardDirection::UP;     break;
+            case 'L': direction = GameUtil::BoardDirection::LEFT;   break;
+            case 'D': direction = GameUtil::BoardDirection::DOWN;   break;
+            case 'R': direction = GameUtil::BoardDirection::RIGHT;  break;
+            case '.': direction = GameUtil::BoardDirection::INVAL;  break;
+            default:
+                return -1;
+        }
+
+        char8_t* end = nullptr;
+        long frames = strtol(curr + 1, &end, 10);
+        if(end == curr + 1 || frames <= 0)
+        {
+            return -1;
+        }
+
+        steps[numSteps].direction = direction;
+        steps[numSteps].frames = (int32_t)frames;
+        numSteps++;
+
+        curr = end;
+        if(*curr == ',')
+        {
+            curr++;
+        }
+    }
+
+    return numSteps;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void printUsage()
+{
+    fprintf(stderr, "usage: pacsim [-worlds N] [-games N] [-frames N] [-dt MS] [-seed N] [-script SCRIPT] [-verify] [-events] [-clone]\n"
+        "              [-record FILE] [-replay FILE [-hashes FILE]] [-rewind SECONDS]\n");
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void startGame(SimWorld& sim)
+{
+    // settle any pending events so the world is sitting in the menu, then start
+    sim.world->update(0);
+    sim.world->startGame();
+
+    sim.frame = 0;
+    sim.stepIndex = 0;
+    sim.framesOnStep = 0;
+    sim.startTime = 0;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static uint32_t getSnapshotHash(const GameWorld* world)
+{
+    // the whole snapshot, not just the gameplay fields the state hash covers, so the checks
+    // below also catch animation or anything else that a level start or rewind gets wrong
+    //      the padding bytes are zeroed so only the state's values are hashed
+    GameWorldState state;
+    memset(&state, 0, sizeof(state));
+    world->saveState(&state);
+
+    // the high score carries over from earlier games, and the time carried over between updates
+    state.tickTime = 0;
+    state.stats.highScore = 0;
+
+    return BoardFile::checksum(&state, sizeof(state));
+}
+
+//-----------------------------------------------------------------------------------------
+
+static bool8_t stepGame(SimWorld& sim, const ScriptStep* steps, int32_t numSteps, int32_t frameTime, int32_t maxFrames)
+{
+    // plays one frame of the current game, returns true when the game has ended
+    sim.world->setInput(steps[sim.stepIndex].direction);
+    sim.world->update(frameTime);
+
+    if(++sim.framesOnStep >= steps[sim.stepIndex].frames)
+    {
+        sim.framesOnStep = 0;
+        sim.stepIndex = (sim.stepIndex + 1) % numSteps;
+    }
+
+    sim.frame++;
+
+    // the first update only moves us from the menu into the game
+    return (sim.frame > 1 && !sim.world->isInGame()) || sim.frame > maxFrames;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static bool8_t fastForwardGame(SimWorld& sim, const ScriptStep* steps, int32_t numSteps, int32_t frameTime, int32_t maxFrames)
+{
+    // plays the rest of the current script step at once, returns true when the game has ended
+    //      the first frame is played alone, since it only moves us from the menu into the game
+    int32_t frames = sim.frame == 0 ? 1 : steps[sim.stepIndex].frames - sim.framesOnStep;
+    if(frames > maxFrames + 1 - sim.frame)
+    {
+        frames = maxFrames + 1 - sim.frame;
+    }
+
+    sim.world->setInput(steps[sim.stepIndex].direction);
+    sim.world->fastForward(frames * frameTime);
+
+    if(sim.frame == 0)
+    {
+        sim.startTime = sim.world->getGameTime();
+    }
+
+    sim.framesOnStep += frames;
+    if(sim.framesOnStep >= steps[sim.stepIndex].frames)
+    {
+        sim.framesOnStep = 0;
+        sim.stepIndex = (sim.stepIndex + 1) % numSteps;
+    }
+
+    sim.frame += frames;
+
+    if(sim.frame > 1 && !sim.world->isInGame())
+    {
+        // the game ended partway through, on the first frame with time for the tick it ended on
+        uint32_t playTime = sim.world->getGameTime() - sim.startTime;
+        sim.frame = 1 + (int32_t)((playTime + frameTime - 1) / frameTime);
+        return true;
+    }
+
+    return sim.frame > maxFrames;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static int32_t verifyLevelStarts(const ScriptStep* steps, int32_t numSteps, int32_t frameTime, uint32_t seed)
+{
+    // world 1 drops its level start states every frame, so it always resets every manager
+    SimWorld sims[2];
+    for(int32_t w = 0; w < 2; ++w)
+    {
+        sims[w].world = new GameWorld();
+        sims[w].world->init();
+        sims[w].world->setRandomSeed(seed);
+    }
+
+    int32_t numMismatches = 0;
+    int32_t numLevels = 0;
+    for(int32_t game = 0; game < NUM_VERIFY_GAMES; ++game)
+    {
+        startGame(sims[0]);
+        startGame(sims[1]);
+
+        int32_t levelFrames = VERIFY_LEVEL_FRAMES + game * VERIFY_LEVEL_FRAMES_STEP;
+
+        bool8_t didEnd = false;
+        while(!didEnd)
+        {
+            sims[1].world->clearLevelStates();
+
+            // winning levels rather than clearing the board keeps the checks to the level starts
+            if(sims[0].frame % levelFrames == levelFrames - 1)
+            {
+                sims[0].world->getConstEventManager()->postEvent(EventManager::GameEvent::LEVEL_WIN);
+                sims[1].world->getConstEventManager()->postEvent(EventManager::GameEvent::LEVEL_WIN);
+            }
+
+            didEnd = stepGame(sims[0], steps, numSteps, frameTime, VERIFY_GAME_FRAMES);
+            stepGame(sims[1], steps, numSteps, frameTime, VERIFY_GAME_FRAMES);
+
+            if(getSnapshotHash(sims[0].world) != getSnapshotHash(sims[1].world))
+            {
+                numMismatches++;
+            }
+        }
+
+        numLevels += sims[0].world->getLevel();
+    }
+
+    printf("level starts: %d levels played, %d frames mismatched\n", numLevels, numMismatches);
+
+    for(int32_t w = 0; w < 2; ++w)
+    {
+        sims[w].world->shutdown();
+        delete sims[w].world;
+    }
+
+    return numMismatches;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static int32_t verifyZobristHash(int32_t frameTime, uint32_t seed)
+{
+    // events that jump the game into states random input rarely reaches
+    const EventManager::GameEvent events[] =
+    {
+        EventManager::GameEvent::SPAWN_GHOST_PINK,
+        EventManager::GameEvent::SPAWN_GHOST_BLUE,
+        EventManager::GameEvent::SPAWN_GHOST_ORANGE,
+        EventManager::GameEvent::SCARE_GHOSTS,
+        EventManager::GameEvent::CRUISE_ELROY,
+        EventManager::GameEvent::ACTIVATE_FRUIT,
+        EventManager::GameEvent::LEVEL_WIN
+    };
+    const int32_t numEvents = sizeof(events) / sizeof(events[0]);
+
+    SimWorld sim;
+    sim.world = new GameWorld();
+    sim.world->init();
+    sim.world->setRandomSeed(seed);
+
+    RandomGenerator random(seed);
+    ScriptStep steps[MAX_SCRIPT_STEPS];
+
+    int32_t numMismatches = 0;
+    long long numChecks = 0;
+    for(int32_t game = 0; game < NUM_ZOBRIST_GAMES; ++game)
+    {
+        for(int32_t s = 0; s < MAX_SCRIPT_STEPS; ++s)
+        {
+            steps[s].direction = (GameUtil::BoardDirection)random.getRangedRandom(GameUtil::BoardDirection::UP, GameUtil::BoardDirection::INVAL + 1);
+            steps[s].frames = random.getRangedRandom(1, ZOBRIST_STEP_FRAMES + 1);
+        }
+
+        startGame(sim);
+
+        bool8_t didEnd = false;
+        while(!didEnd)
+        {
+            if(sim.frame > 0 && random.getRangedRandom(0, ZOBRIST_EVENT_CHANCE) == 0)
+            {
+                sim.world->getConstEventManager()->postEvent(events[random.getRangedRandom(0, numEvents)]);
+            }
+
+            didEnd = game % 2 == 0 ?
+                stepGame(sim, steps, MAX_SCRIPT_STEPS, frameTime, ZOBRIST_GAME_FRAMES) :
+                fastForwardGame(sim, steps, MAX_SCRIPT_STEPS, frameTime, ZOBRIST_GAME_FRAMES);
+
+            if(sim.world->getZobristHash() != sim.world->computeZobristHash())
+            {
+                numMismatches++;
+            }
+            numChecks++;
+        }
+    }
+
+    printf("zobrist hash: %d games, %lld steps checked, %d mismatched\n", NUM_ZOBRIST_GAMES, numChecks, numMismatches);
+
+    sim.world->shutdown();
+    delete sim.world;
+
+    return numMismatches;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void keepFrameHash(SimWorld& sim)
+{
+    // a frame that ran no tick still passes its input on to pacman, which the tick it's
+    // applied on keeps, so only the frames that ran a tick are stepped back to
+    uint32_t gameTime = sim.world->getGameTime();
+    if(!sim.frameHashes->empty() && sim.frameHashes->back().gameTime == gameTime)
+    {
+        return;
+    }
+
+    FrameHash frameHash = { gameTime, getSnapshotHash(sim.world) };
+    sim.frameHashes->push_back(frameHash);
+}
+
+//-----------------------------------------------------------------------------------------
+
+static int32_t checkRewind(SimWorld& sim, long long& numStepsBack, long long& numFramesChecked)
+{
+    // steps back through the whole history, checking each frame's state on the way, then puts the world back
+    GameWorldState endState;
+    sim.world->saveState(&endState);
+
+    const FrameHashes& frameHashes = *sim.frameHashes;
+    int32_t index = (int32_t)frameHashes.size() - 1;
+    int32_t numMismatches = 0;
+    do
+    {
+        uint32_t gameTime = sim.world->getGameTime();
+        uint32_t stateHash = getSnapshotHash(sim.world);
+        while(index >= 0 && frameHashes[index].gameTime >= gameTime)
+        {
+            if(frameHashes[index].gameTime == gameTime)
+            {
+                numFramesChecked++;
+                if(frameHashes[index].stateHash != stateHash)
+                {
+                    numMismatches++;
+                }
+            }
+            index--;
+        }
+    }
+    while(sim.world->rewindTick() && ++numStepsBack);
+
+    sim.world->loadState(&endState);
+    sim.frameHashes->clear();
+
+    return numMismatches;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static int32_t verifyRewind(const ScriptStep* steps, int32_t numSteps, uint32_t seed)
+{
+    // frames shorter than a tick leave some frames that run no tick at all
+    SimWorld sim;
+    sim.world = new GameWorld();
+    sim.world->init();
+    sim.world->setRandomSeed(seed);
+    sim.rewind = new RewindBuffer(REWIND_VERIFY_SECONDS);
+    sim.frameHashes = new FrameHashes();
+    sim.world->setRewindBuffer(sim.rewind);
+
+    startGame(sim);
+
+    bool8_t didEnd = false;
+    while(!didEnd)
+    {
+        didEnd = stepGame(sim, steps, numSteps, REWIND_VERIFY_FRAME_TIME, REWIND_VERIFY_FRAMES);
+        keepFrameHash(sim);
+    }
+
+    long long numStepsBack = 0;
+    long long numFramesChecked = 0;
+    int32_t numMismatches = checkRewind(sim, numStepsBack, numFramesChecked);
+
+    printf("rewind: %lld ticks stepped back at %dms frames, %lld frames checked, %d mismatches\n", numStepsBack,
+        REWIND_VERIFY_FRAME_TIME, numFramesChecked, numMismatches);
+
+    sim.world->shutdown();
+    delete sim.world;
+    delete sim.rewind;
+    delete sim.frameHashes;
+
+    return numMismatches;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static int32_t verifyReplay(const char8_t* path, const char8_t* hashesPath)
+{
+    Replay* replay = new Replay();
+    if(!replay->read(path))
+    {
+        fprintf(stderr, "pacsim: can't read replay %s\n", path);
+        delete replay;
+        return 1;
+    }
+
+    GameWorld* world = new GameWorld();
+    world->init();
+
+    HashStream* hashStream = nullptr;
+    if(hashesPath != nullptr)
+    {
+        hashStream = new HashStream();
+        world->setHashStream(hashStream);
+    }
+
+    clock_t startClock = clock();
+    ReplayResult result;
+    bool8_t didPlay = world->verifyReplay(replay, &result);
+    double seconds = (double)(clock() - startClock) / CLOCKS_PER_SEC;
+
+    if(didPlay)
+    {
+        double simSeconds = (double)result.numTicks * SIM_TICK_TIME / 1000.0;
+        printf("replay %s: score %d level %d state %08x, %u ticks in %.4fs (%.0fx real time)\n", path, result.score, result.level,
+            result.stateHash, result.numTicks, seconds, seconds > 0.0 ? simSeconds / seconds : 0.0);
+
+        if(result.isMatch)
+        {
+            printf("replay matches %u checkpoints\n", replay->getNumCheckpoints());
+        }
+        else
+        {
+            printf("replay diverges by tick %u, recorded score %d level %d state %08x after %u ticks\n", result.firstDivergentTick,
+                replay->getFinalScore(), replay->getFinalLevel(), replay->getFinalStateHash(), replay->getNumTicks());
+        }
+    }
+    else
+    {
+        fprintf(stderr, "pacsim: %s was recorded by a different build or on a different board\n", path);
+    }
+
+    bool8_t didWrite = true;
+    if(didPlay && hashStream != nullptr)
+    {
+        didWrite = hashStream->write(hashesPath);
+        if(didWrite)
+        {
+            printf("wrote hashes of %u ticks to %s\n", hashStream->getNumTicks(), hashesPath);
+        }
+        else
+        {
+            fprintf(stderr, "pacsim: can't write hash stream %s\n", hashesPath);
+        }
+    }
+
+    world->shutdown();
+    delete world;
+    delete replay;
+    delete hashStream;
+
+    return didPlay && didWrite && result.isMatch ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    int32_t numWorlds = DEFAULT_NUM_WORLDS;
+    int32_t numGames = DEFAULT_NUM_GAMES;
+    int32_t maxFrames = DEFAULT_MAX_FRAMES;
+    int32_t frameTime = DEFAULT_FRAME_TIME;
+    uint32_t seed = 1;
+    const char8_t* script = DEFAULT_SCRIPT;
+    bool8_t isVerifying = false;
+    bool8_t isFastForwarding = false;
+    bool8_t isCloning = false;
+    const char8_t* recordPath = nullptr;
+    const char8_t* replayPath = nullptr;
+    const char8_t* hashesPath = nullptr;
+    int32_t rewindSeconds = 0;
+
+    for(int32_t i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "-verify") == 0)
+        {
+            isVerifying = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "-events") == 0)
+        {
+            isFastForwarding = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "-clone") == 0)
+        {
+            isCloning = true;
+            continue;
+        }
+
+        if(i + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        if(strcmp(argv[i], "-worlds") == 0)         numWorlds = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-games") == 0)     numGames = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-frames") == 0)    maxFrames = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-dt") == 0)        frameTime = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-seed") == 0)      seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if(strcmp(argv[i], "-script") == 0)    script = argv[++i];
+        else if(strcmp(argv[i], "-record") == 0)    recordPath = argv[++i];
+        else if(strcmp(argv[i], "-replay") == 0)    replayPath = argv[++i];
+        else if(strcmp(argv[i], "-hashes") == 0)    hashesPath = argv[++i];
+        else if(strcmp(argv[i], "-rewind") == 0)    rewindSeconds = atoi(argv[++i]);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if(replayPath != nullptr)
+    {
+        return verifyReplay(replayPath, hashesPath);
+    }
+
+    // hash streams are only kept of replays
+    if(hashesPath != nullptr)
+    {
+        printUsage();
+        return 1;
+    }
+
+    // a recording or history stays with the world it was started on, so it can't be cloned
+    if((recordPath != nullptr || rewindSeconds > 0) && isCloning)
+    {
+        printUsage();
+        return 1;
+    }
+
+    ScriptStep steps[MAX_SCRIPT_STEPS];
+    int32_t numSteps = parseScript(script, steps, MAX_SCRIPT_STEPS);
+    if(numSteps <= 0 || numWorlds <= 0 || numGames <= 0 || maxFrames <= 0 || frameTime <= 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    SimWorld* sims = new SimWorld[numWorlds];
+    for(int32_t w = 0; w < numWorlds; ++w)
+    {
+        sims[w].world = new GameWorld();
+        sims[w].world->init();
+        sims[w].world->setRandomSeed(seed + w);
+        sims[w].clone = nullptr;
+        if(isCloning)
+        {
+            sims[w].clone = new GameWorld();
+            sims[w].clone->init();
+        }
+        sims[w].rewind = nullptr;
+        sims[w].frameHashes = nullptr;
+        if(rewindSeconds > 0)
+        {
+            sims[w].rewind = new RewindBuffer(rewindSeconds);
+            sims[w].frameHashes = new FrameHashes();
+            sims[w].world->setRewindBuffer(sims[w].rewind);
+        }
+        sims[w].game = 0;
+        startGame(sims[w]);
+    }
+
+    // the replay's seed is the one world 0 was seeded with
+    Replay* replay = nullptr;
+    if(recordPath != nullptr)
+    {
+        replay = new Replay();
+        sims[0].world->recordReplay(replay, seed);
+    }
+
+    if(isVerifying)
+    {
+        int32_t numMismatches = sims[0].world->getConstBoardManager()->getGrid()->verifyDecisionTable();
+        printf("decision table: %d mismatches\n", numMismatches);
+        if(numMismatches != 0 || verifyLevelStarts(steps, numSteps, frameTime, seed) != 0 ||
+            verifyZobristHash(frameTime, seed) != 0 || verifyRewind(steps, numSteps, seed) != 0)
+        {
+            return 1;
+        }
+    }
+
+    clock_t startClock = clock();
+    long long totalFrames = 0;
+    int32_t numRunning = numWorlds;
+
+    clock_t rewindClocks = 0;
+    long long numStepsBack = 0;
+    long long numFramesChecked = 0;
+    long long numRewindTicksHeld = 0;
+    long long numRewindDeltaBytes = 0;
+    int32_t numRewindMismatches = 0;
+
+    // step every running world one frame at a time until they have all played their games
+    while(numRunning > 0)
+    {
+        for(int32_t w = 0; w < numWorlds; ++w)
+        {
+            SimWorld& sim = sims[w];
+            if(sim.game >= numGames)
+            {
+                continue;
+            }
+
+            bool8_t didEnd = isFastForwarding ?
+                fastForwardGame(sim, steps, numSteps, frameTime, maxFrames) :
+                stepGame(sim, steps, numSteps, frameTime, maxFrames);
+
+            // carry on playing in the clone, so any state the snapshot misses changes the results
+            if(isCloning)
+            {
+                sim.clone->cloneFrom(sim.world);
+
+                GameWorld* world = sim.world;
+                sim.world = sim.clone;
+                sim.clone = world;
+            }
+
+            if(sim.frameHashes != nullptr)
+            {
+                keepFrameHash(sim);
+            }
+
+            if(!didEnd)
+            {
+                continue;
+            }
+
+            // the first update only moves us from the menu into the game, so it isn't counted
+            int32_t frames = sim.frame - 1;
+            totalFrames += frames;
+
+            const GameWorld* world = sim.world;
+            printf("world %d game %d: score %d level %d lives %d frames %d%s\n", w, sim.game, world->getScore(), world->getLevel(),
+                world->getLives(), frames, world->isInGame() ? " (frame limit)" : "");
+
+            if(replay != nullptr && w == 0 && sim.game == 0)
+            {
+                // recording stops by itself when the game ends, but not at the frame limit
+                sim.world->stopReplay();
+                if(!replay->write(recordPath))
+                {
+                    fprintf(stderr, "pacsim: can't write replay %s\n", recordPath);
+                    return 1;
+                }
+                printf("recorded %u ticks in %u bytes of input to %s, state %08x\n", replay->getNumTicks(), replay->getInputSize(),
+                    recordPath, replay->getFinalStateHash());
+            }
+
+            if(sim.rewind != nullptr)
+            {
+                numRewindTicksHeld += sim.rewind->getNumTicks();
+                numRewindDeltaBytes += sim.rewind->getNumDeltaBytes();
+
+                clock_t rewindClock = clock();
+                numRewindMismatches += checkRewind(sim, numStepsBack, numFramesChecked);
+                rewindClocks += clock() - rewindClock;
+            }
+
+            if(++sim.game < numGames)
+            {
+                startGame(sim);
+            }
+            else
+            {
+                numRunning--;
+            }
+        }
+    }
+
+    // checking the rewind buffer isn't part of play
+    double seconds = (double)(clock() - startClock - rewindClocks) / CLOCKS_PER_SEC;
+    double simSeconds = (double)totalFrames * frameTime / 1000.0;
+    printf("%lld frames in %.3fs (%.0fx real time)\n", totalFrames, seconds, seconds > 0.0 ? simSeconds / seconds : 0.0);
+
+    if(rewindSeconds > 0)
+    {
+        double checkSeconds = (double)rewindClocks / CLOCKS_PER_SEC;
+        printf("rewind: %lld ticks stepped back in %.3fs (%.0fns each), %lld frames checked, %d mismatches\n", numStepsBack,
+            checkSeconds, numStepsBack > 0 ? checkSeconds * 1e9 / numStepsBack : 0.0, numFramesChecked, numRewindMismatches);
+
+        // keyframe ticks have no delta, but are few enough to leave in the average
+        const RewindBuffer* rewind = sims[0].rewind;
+        double requestedSeconds = (double)rewind->getNumTicksRequested() * SIM_TICK_TIME / 1000.0;
+        printf("rewind buffer: %u KB per world for %.0fs of history (%.1f KB per second), deltas average %.0f bytes per tick\n",
+            rewind->getMemorySize() / 1024, requestedSeconds, rewind->getMemorySize() / 1024.0 / requestedSeconds,
+            numRewindTicksHeld > 0 ? (double)numRewindDeltaBytes / numRewindTicksHeld : 0.0);
+    }
+
+    if(isCloning)
+    {
+        // worlds are cloned back and forth, so the last world's state is as good as any
+        clock_t cloneClock = clock();
+        for(int32_t i = 0; i < NUM_TIMED_CLONES; ++i)
+        {
+            sims[0].clone->cloneFrom(sims[0].world);
+        }
+        double cloneSeconds = (double)(clock() - cloneClock) / CLOCKS_PER_SEC;
+        printf("%d clones of a %d byte state in %.3fs (%.0fns each)\n", NUM_TIMED_CLONES, (int32_t)sizeof(GameWorldState),
+            cloneSeconds, cloneSeconds * 1e9 / NUM_TIMED_CLONES);
+    }
+
+    // one step per tick when stepping frames, fewer when fast forwarding
+    long long numWorldSteps = 0;
+    for(int32_t w = 0; w < numWorlds; ++w)
+    {
+        numWorldSteps += sims[w].world->getNumSteps();
+        if(sims[w].clone != nullptr)
+        {
+            numWorldSteps += sims[w].clone->getNumSteps();
+        }
+    }
+    printf("%lld world steps\n", numWorldSteps);
+
+    // ghosts only choose a target at the tiles where it decides their move
+    long long numTargetEvaluations = 0;
+    long long numTargetsSkipped = 0;
+    for(int32_t w = 0; w < numWorlds; ++w)
+    {
+        numTargetEvaluations += sims[w].world->getNumTargetEvaluations();
+        numTargetsSkipped += sims[w].world->getNumSkippedTargetEvaluations();
+        if(sims[w].clone != nullptr)
+        {
+            numTargetEvaluations += sims[w].clone->getNumTargetEvaluations();
+            numTargetsSkipped += sims[w].clone->getNumSkippedTargetEvaluations();
+        }
+    }
+    printf("%lld ghost target evaluations, %lld skipped (%.0f skipped/s)\n", numTargetEvaluations, numTargetsSkipped,
+        seconds > 0.0 ? numTargetsSkipped / seconds : 0.0);
+
+    // each event queue is a fixed ring, so one that fills up drops events rather than growing
+    long long numPostedEvents = 0;
+    long long numCollapsedEvents = 0;
+    long long numCollapsedSounds = 0;
+    long long numDroppedEvents = 0;
+    uint32_t peakQueueSize = 0;
+    for(int32_t w = 0; w < numWorlds; ++w)
+    {
+        for(int32_t c = 0; c < 2; ++c)
+        {
+            const GameWorld* world = c == 0 ? sims[w].world : sims[w].clone;
+            if(world == nullptr)
+            {
+                continue;
+            }
+
+            const EventManager* eventManager = world->getConstEventManager();
+            numPostedEvents += eventManager->getNumPostedEvents();
+            numCollapsedEvents += eventManager->getNumCollapsedEvents();
+            numCollapsedSounds += eventManager->getNumCollapsedSounds();
+            numDroppedEvents += eventManager->getNumDroppedEvents();
+            if(eventManager->getPeakQueueSize() > peakQueueSize)
+            {
+                peakQueueSize = eventManager->getPeakQueueSize();
+            }
+        }
+    }
+    printf("%lld events posted, %lld collapsed, %lld dropped, peak queue %u of %d, %lld sounds cut short\n", numPostedEvents,
+        numCollapsedEvents, numDroppedEvents, peakQueueSize, EVENT_QUEUE_CAPACITY, numCollapsedSounds);
+
+    for(int32_t w = 0; w < numWorlds; ++w)
+    {
+        sims[w].world->shutdown();
+        delete sims[w].world;
+        if(sims[w].clone != nullptr)
+        {
+            sims[w].clone->shutdown();
+            delete sims[w].clone;
+        }
+        delete sims[w].rewind;
+        delete sims[w].frameHashes;
+    }
+    delete[] sims;
+    delete replay;
+
+    return numRewindMismatches == 0 ? 0 : 1;
+}
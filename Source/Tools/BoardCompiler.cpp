@@ -0,0 +1,274 @@
+
+#define BOARD_COMPILER_CPP
+
+/*
+ * Offline compiler for board files.
+ *
+ * Reads the text board (PacmanBoard.txt) and the tile code to
+ * spritesheet mappings (TileMappings.txt), and writes the compiled
+ * board file that the BoardManager maps at load time. Rerun this
+ * whenever either text file changes.
+ *
+ * Must be run from a directory containing the Assets folder, unless
+ * paths are given.
+ *
+ * Usage: pacboard [-board FILE] [-mappings FILE] [-out FILE]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Framework/platform.h"
+#include "../Framework/baseTypes.h"
+
+#include <map>
+#include "../GameCode/Utilities.h"
+#include "../GameCode/TileGrid.h"
+#include "../GameCode/BoardFile.h"
+
+#define DEFAULT_BOARD_FILE      "Assets/PacmanBoard.txt"
+#define DEFAULT_MAPPINGS_FILE   "Assets/TileMappings.txt"
+#define DEFAULT_OUT_FILE        "Assets/PacmanBoard.bin"
+
+typedef std::map<char8_t, Coord2D> TextureIndexMap;     // maps alphanumerical characters to texture indicies in the tile spritesheet
+typedef std::pair<char8_t, Coord2D> CharIndexPair;
+
+//-----------------------------------------------------------------------------------------
+
+static Coord2D getTileTextureOffset(float x, float y)
+{
+    Coord2D textureCoord;
+
+    // store the texture coord as the % offset from the tile texture file start
+    //      y offset is backwards, need to compensate
+    textureCoord.x = x / (NUM_TILE_TEXTURE_COLS * NUM_TILE_ANIM_CHUNKS);
+    textureCoord.y = (NUM_TILE_TEXTURE_ROWS - y - 1) / NUM_TILE_TEXTURE_ROWS;
+
+    return textureCoord;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static bool8_t readTextureMappings(const char8_t* path, TextureIndexMap& textureIndexMap)
+{
+    // read map file, associating each alphanumerical key with an (x,y) offset index into the tile spritesheet
+    FILE* tileMapFile = fopen(path, "r");
+    if(tileMapFile == nullptr)
+    {
+        fprintf(stderr, "pacboard: can't open %s\n", path);
+        return false;
+    }
+
+    char8_t key;
+    int xOffset, yOffset;
+    while(fscanf(tileMapFile, "%c %d %d\n", &key, &xOffset, &yOffset) != EOF)
+    {
+        textureIndexMap.insert(CharIndexPair(key, getTileTextureOffset(xOffset, yOffset)));
+    }
+
+    fclose(tileMapFile);
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static bool8_t readBoard(const char8_t* path, const TextureIndexMap& textureIndexMap, TileGrid& grid, BoardFileData* data)
+{
+    FILE* boardFile = fopen(path, "r");
+    if(boardFile == nullptr)
+    {
+        fprintf(stderr, "pacboard: can't open %s\n", path);
+        return false;
+    }
+
+    char8_t buffer[NUM_BOARD_COLS + 8];
+
+    char8_t currentTileChar;
+    TileIndex currentTileIndex;
+
+    for(int y = 0; y < NUM_BOARD_ROWS; ++y)
+    {
+        if(fscanf(boardFile, "%35s", buffer) != 1 || strlen(buffer) != NUM_BOARD_COLS)
+        {
+            fprintf(stderr, "pacboard: %s: row %d is not %d tiles wide\n", path, y, NUM_BOARD_COLS);
+            fclose(boardFile);
+            return false;
+        }
+
+        for(int x = 0; x < NUM_BOARD_COLS; ++x)
+        {
+            currentTileChar = buffer[x];
+            currentTileIndex = TileGrid::getTileIndex(y, x);
+
+            TextureIndexMap::const_iterator textureIter = textureIndexMap.find(currentTileChar);
+            if(textureIter == textureIndexMap.end())
+            {
+                fprintf(stderr, "pacboard: %s: no texture mapping for '%c' at row %d, col %d\n", path, currentTileChar, y, x);
+                fclose(boardFile);
+                return false;
+            }
+
+            // set pellet type
+            TileGrid::TilePelletType pelletType;
+            switch(currentTileChar)
+            {
+                case 'O':
+                    pelletType = TileGrid::TilePelletType::POWER_PELLET;
+                    break;
+                case 'S': case 'X': case 'o':
+                    pelletType = TileGrid::TilePelletType::PELLET;
+                    break;
+                default:
+                    pelletType = TileGrid::TilePelletType::NO_PELLET;
+                    break;
+            }
+
+            // set tile traversal type
+            TileGrid::TileTraverseType traverseType;
+            switch(currentTileChar)
+            {
+                case 'f': case '5': case '6': case '7': case '8':
+                case '9': case '.': case 'o': case 'O':
+                    traverseType = TileGrid::TileTraverseType::TRAVERSABLE;
+                    break;
+                case '/':
+                    traverseType = TileGrid::TileTraverseType::GHOST_TRAVERSABLE;
+                    break;
+                case 'T':
+                    traverseType = TileGrid::TileTraverseType::TELEPORT;
+                    break;
+                case 't':
+                    traverseType = TileGrid::TileTraverseType::TUNNEL;
+                    break;
+                case 'x': case 'X':
+                    traverseType = TileGrid::TileTraverseType::INTERSECTION;
+                    break;
+                case 's': case 'S':
+                    traverseType = TileGrid::TileTraverseType::NO_UP_INTERSECTION;
+                    break;
+                case '^':
+                    traverseType = TileGrid::TileTraverseType::GHOST_HOME_EXIT;
+                    break;
+                case 'v':
+                    traverseType = TileGrid::TileTraverseType::GHOST_HOME_ENTER;
+                    break;
+                default:
+                    traverseType = TileGrid::TileTraverseType::NON_TRAVERSABLE;
+                    break;
+            }
+
+            // ghost targeting finds tiles across a teleporter with index arithmetic, which only works at the ends of a row
+            if(traverseType == TileGrid::TileTraverseType::TELEPORT && x != 0 && x != NUM_BOARD_COLS - 1)
+            {
+                fprintf(stderr, "pacboard: %s: teleporter at row %d, col %d is not at the end of its row\n", path, y, x);
+                fclose(boardFile);
+                return false;
+            }
+
+            // set the tile at the current board position, save it in any relevant tables
+            grid.setTile(currentTileIndex, traverseType, pelletType, textureIter->second);
+            switch(currentTileChar)
+            {
+                case '0': case '1': case '2': case '3': case '4':
+                    data->ghostHomes[currentTileChar - '0'] = currentTileIndex;
+                    break;
+                case '5': case '6': case '7': case '8': case '9':
+                    data->characterSpawns[currentTileChar - '5'] = currentTileIndex;
+                    break;
+                case 'f':
+                    data->fruitTile = currentTileIndex;
+                    break;
+            }
+        }
+    }
+
+    fclose(boardFile);
+
+    // every character needs a spawn and a home, and the fruit needs a tile
+    for(int32_t id = 0; id < NUM_BOARD_CHARACTERS; ++id)
+    {
+        if(data->ghostHomes[id] == TILE_INVAL || data->characterSpawns[id] == TILE_INVAL)
+        {
+            fprintf(stderr, "pacboard: %s: missing home '%d' or spawn '%d' tile\n", path, id, id + 5);
+            return false;
+        }
+    }
+    if(data->fruitTile == TILE_INVAL)
+    {
+        fprintf(stderr, "pacboard: %s: missing fruit 'f' tile\n", path);
+        return false;
+    }
+
+    grid.connectTiles();
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void printUsage()
+{
+    fprintf(stderr, "usage: pacboard [-board FILE] [-mappings FILE] [-out FILE]\n");
+}
+
+//-----------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const char8_t* boardPath = DEFAULT_BOARD_FILE;
+    const char8_t* mappingsPath = DEFAULT_MAPPINGS_FILE;
+    const char8_t* outPath = DEFAULT_OUT_FILE;
+
+    for(int32_t i = 1; i < argc; ++i)
+    {
+        if(i + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        if(strcmp(argv[i], "-board") == 0)          boardPath = argv[++i];
+        else if(strcmp(argv[i], "-mappings") == 0)  mappingsPath = argv[++i];
+        else if(strcmp(argv[i], "-out") == 0)       outPath = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // zero the payload so padding bytes are deterministic, and mark every special tile as missing
+    BoardFileData* data = new BoardFileData();
+    memset(data, 0, sizeof(BoardFileData));
+    for(int32_t id = 0; id < NUM_BOARD_CHARACTERS; ++id)
+    {
+        data->characterSpawns[id] = TILE_INVAL;
+        data->ghostHomes[id] = TILE_INVAL;
+    }
+    data->fruitTile = TILE_INVAL;
+
+    TextureIndexMap textureIndexMap;
+    TileGrid* grid = new TileGrid();
+
+    bool8_t result = readTextureMappings(mappingsPath, textureIndexMap) &&
+        readBoard(boardPath, textureIndexMap, *grid, data);
+
+    if(result)
+    {
+        grid->store(data);
+
+        result = BoardFile::write(outPath, data);
+        if(result)
+        {
+            printf("pacboard: wrote %s (%d pellets)\n", outPath, grid->getNumStartPellets());
+        }
+        else
+        {
+            fprintf(stderr, "pacboard: can't write %s\n", outPath);
+        }
+    }
+
+    delete grid;
+    delete data;
+
+    return result ? 0 : 1;
+}
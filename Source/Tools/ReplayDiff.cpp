@@ -0,0 +1,374 @@
+
+#define REPLAY_DIFF_CPP
+
+/*
+ * Finds where two runs of a replay part ways.
+ *
+ * Compares two hash streams of the same replay, saved with
+ * pacsim -replay FILE -hashes FILE by two builds, or by two runs
+ * of one build, and reports the first tick where they differ.
+ * Given only one stream, compares it against the replay played
+ * back on this build.
+ *
+ * The builds can lay out their world state however they like,
+ * since the hashes only cover gameplay fields, but they must play
+ * by the same rules: streams with different build hashes don't
+ * compare, and pacdiff says so rather than bisecting them.
+ *
+ * If they differ, plays the replay back again on this build, and
+ * prints the whole world state of each tick from a few before
+ * the first mismatch to a few after. Running the same command
+ * on each build and diffing the output shows exactly which
+ * fields went wrong, and on which tick.
+ *
+ * Must be run from a directory containing the Assets folder.
+ *
+ * Usage: pacdiff -replay FILE -hashes FILE [-hashes FILE] [-window TICKS]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Framework/platform.h"
+#include "../Framework/baseTypes.h"
+
+#include <map>
+#include "../GameCode/Utilities.h"
+#include "../GameCode/TileGrid.h"
+#include "../GameCode/WorldState.h"
+#include <vector>
+#include "../GameCode/Replay.h"
+#include "../GameCode/HashStream.h"
+#include "../GameCode/GameWorld.h"
+
+#define DEFAULT_WINDOW_TICKS    3           // ticks dumped on each side of the first mismatch
+
+#define DUMP_INT(name, value)   printf("    %s %d\n", name, (int32_t)(value))
+#define DUMP_UINT(name, value)  printf("    %s %u\n", name, (uint32_t)(value))
+#define DUMP_FLOAT(name, value) printf("    %s %.9g\n", name, (double)(value))
+
+//-----------------------------------------------------------------------------------------
+
+static void printUsage()
+{
+    fprintf(stderr, "usage: pacdiff -replay FILE -hashes FILE [-hashes FILE] [-window TICKS]\n");
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void dumpCharacter(const int32_t id, const CharacterState* state)
+{
+    char8_t name[64];
+    const char8_t* prefix = "characters[%d].%s";
+
+#define DUMP_CHARACTER(DUMP, field)  snprintf(name, sizeof(name), prefix, id, #field); DUMP(name, state->field)
+
+    DUMP_CHARACTER(DUMP_INT, animChunkID);
+    DUMP_CHARACTER(DUMP_UINT, animStartTime);
+    DUMP_CHARACTER(DUMP_UINT, animHoldTime);
+    DUMP_CHARACTER(DUMP_UINT, frameDeltaTime);
+    DUMP_CHARACTER(DUMP_INT, facingDirection);
+    DUMP_CHARACTER(DUMP_INT, movementState);
+    DUMP_CHARACTER(DUMP_INT, position.x);
+    DUMP_CHARACTER(DUMP_INT, position.y);
+    DUMP_CHARACTER(DUMP_INT, lastPosition.x);
+    DUMP_CHARACTER(DUMP_INT, lastPosition.y);
+    DUMP_CHARACTER(DUMP_FLOAT, speed);
+    DUMP_CHARACTER(DUMP_INT, prevTile);
+    DUMP_CHARACTER(DUMP_INT, currTile);
+    DUMP_CHARACTER(DUMP_INT, nextTile);
+    DUMP_CHARACTER(DUMP_INT, isAnimHeld);
+    DUMP_CHARACTER(DUMP_INT, isPaused);
+    DUMP_CHARACTER(DUMP_INT, isVisible);
+    DUMP_CHARACTER(DUMP_INT, isAlive);
+    DUMP_CHARACTER(DUMP_INT, didTeleport);
+
+    if(id == GameUtil::CharacterID::PACMAN)
+    {
+        DUMP_CHARACTER(DUMP_FLOAT, pacmanSpeed);
+        DUMP_CHARACTER(DUMP_FLOAT, pacmanSpeedDots);
+        DUMP_CHARACTER(DUMP_FLOAT, pacmanSpeedScared);
+        DUMP_CHARACTER(DUMP_FLOAT, pacmanSpeedScaredDots);
+        DUMP_CHARACTER(DUMP_INT, inputDirection);
+        return;
+    }
+
+    DUMP_CHARACTER(DUMP_INT, targetTile);
+    DUMP_CHARACTER(DUMP_INT, targetState);
+    DUMP_CHARACTER(DUMP_INT, currentPhase);
+    DUMP_CHARACTER(DUMP_UINT, scaredTimer);
+    DUMP_CHARACTER(DUMP_UINT, scaredTimerStart);
+    DUMP_CHARACTER(DUMP_FLOAT, ghostSpeed);
+    DUMP_CHARACTER(DUMP_FLOAT, ghostSpeedScared);
+    DUMP_CHARACTER(DUMP_FLOAT, ghostSpeedTunnel);
+    DUMP_CHARACTER(DUMP_UINT, scaredDuration);
+    DUMP_CHARACTER(DUMP_UINT, flashThreshold);
+    DUMP_CHARACTER(DUMP_INT, isInGhostHome);
+    DUMP_CHARACTER(DUMP_INT, isScared);
+    DUMP_CHARACTER(DUMP_INT, isFlaggedForReverse);
+
+    if(id == GameUtil::CharacterID::GHOST_RED)
+    {
+        DUMP_CHARACTER(DUMP_INT, cruiseElroyMode);
+        DUMP_CHARACTER(DUMP_FLOAT, cruiseElroySpeed_1);
+        DUMP_CHARACTER(DUMP_FLOAT, cruiseElroySpeed_2);
+    }
+
+#undef DUMP_CHARACTER
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void dumpState(const uint32_t tick, const uint64_t zobristHash, const GameWorldState* state)
+{
+    // one field per line, so dumps from two builds line up under diff
+    printf("tick %u zobrist %016llx\n", tick, zobristHash);
+
+    DUMP_INT("applicationState", state->applicationState);
+    DUMP_UINT("gameTime", state->gameTime);
+    DUMP_UINT("tickTime", state->tickTime);
+    DUMP_UINT("tick", state->tick);
+    for(int32_t i = 0; i < NUM_STATE_RANDOM_WORDS; ++i)
+    {
+        printf("    random[%d] %08x\n", i, state->random[i]);
+    }
+
+    DUMP_INT("stats.level", state->stats.level);
+    DUMP_INT("stats.lives", state->stats.lives);
+    DUMP_INT("stats.score", state->stats.score);
+    DUMP_INT("stats.highScore", state->stats.highScore);
+    DUMP_INT("stats.prevScore", state->stats.prevScore);
+    DUMP_INT("stats.tableIndex", state->stats.tableIndex);
+    DUMP_INT("stats.ghostsKilledOnPellet", state->stats.ghostsKilledOnPellet);
+    DUMP_INT("stats.ghostKillCount", state->stats.ghostKillCount);
+    DUMP_FLOAT("stats.pacmanSpeed", state->stats.pacmanSpeed);
+    DUMP_FLOAT("stats.pacmanSpeedDots", state->stats.pacmanSpeedDots);
+    DUMP_FLOAT("stats.pacmanSpeedScared", state->stats.pacmanSpeedScared);
+    DUMP_FLOAT("stats.pacmanSpeedScaredDots", state->stats.pacmanSpeedScaredDots);
+    DUMP_FLOAT("stats.ghostSpeed", state->stats.ghostSpeed);
+    DUMP_FLOAT("stats.ghostSpeedScared", state->stats.ghostSpeedScared);
+    DUMP_FLOAT("stats.ghostSpeedTunnel", state->stats.ghostSpeedTunnel);
+    DUMP_FLOAT("stats.cruiseElroySpeed", state->stats.cruiseElroySpeed);
+    DUMP_FLOAT("stats.cruiseElroyDots", state->stats.cruiseElroyDots);
+
+    DUMP_INT("events.gameEventHead", state->events.gameEventHead);
+    for(int32_t i = 0; i < state->events.numGameEvents && i < MAX_STATE_EVENTS; ++i)
+    {
+        printf("    events.gameEvents[%d] %d %d\n", i, state->events.gameEvents[i], state->events.gameEventData[i]);
+    }
+    for(int32_t i = 0; i < state->events.numSoundEvents && i < MAX_STATE_EVENTS; ++i)
+    {
+        printf("    events.soundEvents[%d] %d\n", i, state->events.soundEvents[i]);
+    }
+
+    for(int32_t t = 0; t < NUM_STATE_TIMERS; ++t)
+    {
+        printf("    timers.timers[%d] %u\n", t, state->timers.timers[t]);
+    }
+    DUMP_INT("timers.willConsumeLife", state->timers.willConsumeLife);
+    DUMP_INT("timers.didLose", state->timers.didLose);
+
+    for(int32_t row = 0; row < NUM_BOARD_ROWS; ++row)
+    {
+        printf("    board.grid.pellets[%d] %08x\n", row, state->board.grid.pellets[row]);
+    }
+    DUMP_UINT("board.grid.flashStartTime", state->board.grid.flashStartTime);
+    DUMP_INT("board.grid.isFlashing", state->board.grid.isFlashing);
+    DUMP_INT("board.nextPelletTrigger", state->board.nextPelletTrigger);
+    DUMP_INT("board.isRearmPending", state->board.isRearmPending);
+    DUMP_INT("board.isTriggerCheckPending", state->board.isTriggerCheckPending);
+
+    DUMP_INT("fruit.fruitType", state->fruit.fruitType);
+    DUMP_INT("fruit.phase", state->fruit.phase);
+    DUMP_UINT("fruit.collectedFruit", state->fruit.collectedFruit);
+    DUMP_INT("fruit.timer", state->fruit.timer);
+    DUMP_UINT("fruit.timerStart", state->fruit.timerStart);
+    DUMP_INT("fruit.isVisible", state->fruit.isVisible);
+    DUMP_INT("fruit.isPaused", state->fruit.isPaused);
+
+    DUMP_INT("characters.ghostTimerPhase", state->characters.ghostTimerPhase);
+    DUMP_UINT("characters.phaseTimer", state->characters.phaseTimer);
+    DUMP_UINT("characters.phaseTimerStart", state->characters.phaseTimerStart);
+    DUMP_UINT("characters.scatterThreshold_2", state->characters.scatterThreshold_2);
+    DUMP_UINT("characters.scatterThreshold_3", state->characters.scatterThreshold_3);
+    DUMP_UINT("characters.scatterThreshold_4", state->characters.scatterThreshold_4);
+    DUMP_UINT("characters.chaseThreshold_1", state->characters.chaseThreshold_1);
+    DUMP_UINT("characters.chaseThreshold_2", state->characters.chaseThreshold_2);
+    DUMP_UINT("characters.chaseThreshold_3", state->characters.chaseThreshold_3);
+    DUMP_INT("characters.isPaused", state->characters.isPaused);
+    for(int32_t id = 0; id < NUM_STATE_CHARACTERS; ++id)
+    {
+        dumpCharacter(id, &state->characters.characters[id]);
+    }
+}
+
+//-----------------------------------------------------------------------------------------
+
+static bool8_t startPlayback(GameWorld* world, Replay* replay)
+{
+    // settle any pending events so the world is sitting in the menu, then start
+    //      the first update only moves us from the menu into the game, at tick 0
+    world->update(0);
+    world->startGame();
+    if(!world->playReplay(replay))
+    {
+        return false;
+    }
+
+    world->update(0);
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------
+
+static void dumpTicks(Replay* replay, const uint32_t firstTick, const uint32_t lastTick)
+{
+    GameWorld* world = new GameWorld();
+    world->init();
+
+    if(startPlayback(world, replay))
+    {
+        // nothing before the window is dumped, so it can be stepped over
+        world->fastForward(firstTick * SIM_TICK_TIME);
+
+        GameWorldState state;
+        for(uint32_t tick = firstTick; tick <= lastTick; ++tick)
+        {
+            if(tick > firstTick)
+            {
+                world->update(SIM_TICK_TIME);
+            }
+
+            memset(&state, 0, sizeof(state));
+            world->saveState(&state);
+            dumpState(tick, world->getZobristHash(), &state);
+
+            if(!world->isInGame())
+            {
+                break;
+            }
+        }
+    }
+
+    world->shutdown();
+    delete world;
+}
+
+//-----------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const char8_t* replayPath = nullptr;
+    const char8_t* hashesPaths[2] = { nullptr, nullptr };
+    int32_t numHashesPaths = 0;
+    int32_t windowTicks = DEFAULT_WINDOW_TICKS;
+
+    for(int32_t i = 1; i < argc; ++i)
+    {
+        if(i + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        if(strcmp(argv[i], "-replay") == 0)         replayPath = argv[++i];
+        else if(strcmp(argv[i], "-window") == 0)    windowTicks = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-hashes") == 0 && numHashesPaths < 2)
+        {
+            hashesPaths[numHashesPaths++] = argv[++i];
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if(replayPath == nullptr || numHashesPaths == 0 || windowTicks < 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    Replay* replay = new Replay();
+    if(!replay->read(replayPath))
+    {
+        fprintf(stderr, "pacdiff: can't read replay %s\n", replayPath);
+        delete replay;
+        return 1;
+    }
+
+    HashStream* streams[2] = { new HashStream(), new HashStream() };
+    bool8_t result = true;
+    for(int32_t s = 0; s < numHashesPaths && result; ++s)
+    {
+        result = streams[s]->read(hashesPaths[s]);
+        if(!result)
+        {
+            fprintf(stderr, "pacdiff: can't read hash stream %s\n", hashesPaths[s]);
+        }
+    }
+
+    // with one stream, the other is of the replay played back on this build
+    if(result && numHashesPaths == 1)
+    {
+        GameWorld* world = new GameWorld();
+        world->init();
+        world->setHashStream(streams[1]);
+
+        ReplayResult replayResult;
+        result = world->verifyReplay(replay, &replayResult);
+        if(!result)
+        {
+            fprintf(stderr, "pacdiff: %s was recorded by a different build or on a different board\n", replayPath);
+        }
+
+        world->shutdown();
+        delete world;
+    }
+
+    int32_t exitCode = 1;
+    if(result)
+    {
+        const char8_t* names[2] = { hashesPaths[0], numHashesPaths > 1 ? hashesPaths[1] : "this build" };
+        for(int32_t s = 0; s < 2; ++s)
+        {
+            printf("%s: %u ticks, build %08x\n", names[s], streams[s]->getNumTicks(), streams[s]->getBuildHash());
+        }
+
+        uint32_t tick = HashStream::findFirstMismatch(streams[0], streams[1]);
+        if(streams[0]->getBuildHash() != streams[1]->getBuildHash())
+        {
+            fprintf(stderr, "pacdiff: the streams were played by builds with different rules, so their hashes don't compare\n");
+        }
+        else if(tick == TICKS_UNLIMITED)
+        {
+            printf("hash streams match\n");
+            exitCode = 0;
+        }
+        else
+        {
+            for(int32_t s = 0; s < 2; ++s)
+            {
+                if(tick < streams[s]->getNumTicks())
+                {
+                    printf("%s: tick %u hash %08x\n", names[s], tick, streams[s]->getHash(tick));
+                }
+                else
+                {
+                    printf("%s: ends before tick %u\n", names[s], tick);
+                }
+            }
+            printf("first mismatch at tick %u, state of ticks %u to %u on this build:\n",
+                tick, tick > (uint32_t)windowTicks ? tick - windowTicks : 0, tick + windowTicks);
+
+            dumpTicks(replay, tick > (uint32_t)windowTicks ? tick - windowTicks : 0, tick + windowTicks);
+        }
+    }
+
+    delete streams[0];
+    delete streams[1];
+    delete replay;
+
+    return exitCode;
+}